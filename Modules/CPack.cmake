@@ -244,6 +244,50 @@ installers.  The most commonly-used variables are:
   stripping of all files (a list of files evaluates to ``TRUE`` in CMake,
   so this change is compatible).
 
+.. variable:: CPACK_COMPRESSION_LEVEL
+
+  Compression level used by generators that compress their payload
+  (the :cpack_gen:`CPack Archive Generator`,
+  :cpack_gen:`CPack DEB Generator` and :cpack_gen:`CPack RPM Generator`).
+  The valid range depends on the compression method, e.g. ``1`` to ``9``
+  for gzip, bzip2 and xz, or ``1`` to ``22`` for Zstandard.  If not set,
+  or set to ``0``, the default level of the compression method is used.
+
+.. variable:: CPACK_THREADS
+
+  Number of threads used by generators that compress their payload with
+  xz or Zstandard.  Defaults to ``1``.  A value of ``0`` uses one thread
+  per available processor.
+
+  Multi-threaded xz compression requires CMake to be built with a
+  ``liblzma`` providing the multi-threaded encoder; otherwise xz payloads
+  are compressed with a single thread.  The :cpack_gen:`CPack RPM Generator`
+  passes the value on to ``rpmbuild``, which needs rpm 4.14 or above to
+  compress xz payloads with multiple threads.
+
+.. variable:: CPACK_INCREMENTAL_STAGING
+
+  If set to ``TRUE``, the staging directory below ``_CPack_Packages`` is
+  kept between runs of :manual:`cpack(1)`.  The project is installed into
+  it again, which only copies files that changed, and files no longer
+  installed are removed from it.  A file counts as installed if it is in
+  the install manifest or if the installation created or modified it,
+  e.g. with :command:`file(WRITE)` in ``install(CODE)``.  Code that leaves
+  an existing file untouched, such as :command:`configure_file` with an
+  unchanged result, should write it unconditionally instead.  Empty
+  directories are not tracked.
+
+  The :cpack_gen:`CPack Archive Generator` writes a ``<package>.manifest``
+  file next to each package it creates, recording the staged files and
+  the ``CPACK_`` settings.  A package whose manifest did not change is
+  reused instead of being created again.  Other generators still create
+  all of their packages.
+
+  Incremental staging is disabled if any of
+  :variable:`CPACK_INSTALL_COMMANDS`, :variable:`CPACK_INSTALL_SCRIPTS`
+  or :variable:`CPACK_INSTALLED_DIRECTORIES` is set, because the files
+  they install cannot be tracked.  Defaults to ``FALSE``.
+
 .. variable:: CPACK_VERBATIM_VARIABLES
 
   If set to ``TRUE``, values of variables prefixed with ``CPACK_`` will be
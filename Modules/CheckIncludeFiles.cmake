@@ -48,6 +48,29 @@ to check for a single header file in ``C`` or ``CXX`` languages.
 
 include_guard(GLOBAL)
 
+# Called by try_compile, possibly at the end of a cmake_check_batch().
+macro(_CHECK_INCLUDE_FILES_FINISH INCLUDE VARIABLE QUIET DESCRIPTION CONTENT)
+  if(${VARIABLE})
+    if(NOT "${QUIET}")
+      message(STATUS "Looking for ${DESCRIPTION} - found")
+    endif()
+    set(${VARIABLE} 1 CACHE INTERNAL "Have include ${INCLUDE}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+      "Determining if files ${INCLUDE} "
+      "exist passed with the following output:\n"
+      "${OUTPUT}\n\n")
+  else()
+    if(NOT "${QUIET}")
+      message(STATUS "Looking for ${DESCRIPTION} - not found")
+    endif()
+    set(${VARIABLE} "" CACHE INTERNAL "Have includes ${INCLUDE}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+      "Determining if files ${INCLUDE} "
+      "exist failed with the following output:\n"
+      "${OUTPUT}\nSource:\n${CONTENT}\n")
+  endif()
+endmacro()
+
 macro(CHECK_INCLUDE_FILES INCLUDE VARIABLE)
   if(NOT DEFINED "${VARIABLE}")
     set(CMAKE_CONFIGURABLE_FILE_CONTENT "/* */\n")
@@ -142,27 +165,11 @@ macro(CHECK_INCLUDE_FILES INCLUDE VARIABLE)
       CMAKE_FLAGS
       -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_INCLUDE_FILES_FLAGS}
       "${CHECK_INCLUDE_FILES_INCLUDE_DIRS}"
-      OUTPUT_VARIABLE OUTPUT)
+      OUTPUT_VARIABLE OUTPUT
+      __CMAKE_FINISH _CHECK_INCLUDE_FILES_FINISH
+        "${INCLUDE}" "${VARIABLE}" "${CMAKE_REQUIRED_QUIET}"
+        "${_description}" "${CMAKE_CONFIGURABLE_FILE_CONTENT}")
     unset(_CIF_LINK_OPTIONS)
     unset(_CIF_LINK_LIBRARIES)
-    if(${VARIABLE})
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${_description} - found")
-      endif()
-      set(${VARIABLE} 1 CACHE INTERNAL "Have include ${INCLUDE}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Determining if files ${INCLUDE} "
-        "exist passed with the following output:\n"
-        "${OUTPUT}\n\n")
-    else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${_description} - not found")
-      endif()
-      set(${VARIABLE} "" CACHE INTERNAL "Have includes ${INCLUDE}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Determining if files ${INCLUDE} "
-        "exist failed with the following output:\n"
-        "${OUTPUT}\nSource:\n${CMAKE_CONFIGURABLE_FILE_CONTENT}\n")
-    endif()
   endif()
 endmacro()
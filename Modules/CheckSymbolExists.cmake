@@ -63,6 +63,31 @@ include_guard(GLOBAL)
 cmake_policy(PUSH)
 cmake_policy(SET CMP0054 NEW) # if() quoted variables not dereferenced
 
+# Called by try_compile, possibly at the end of a cmake_check_batch().
+macro(_CHECK_SYMBOL_EXISTS_FINISH SOURCEFILE SYMBOL VARIABLE QUIET CONTENT)
+  if(${VARIABLE})
+    if(NOT "${QUIET}")
+      message(STATUS "Looking for ${SYMBOL} - found")
+    endif()
+    set(${VARIABLE} 1 CACHE INTERNAL "Have symbol ${SYMBOL}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+      "Determining if the ${SYMBOL} "
+      "exist passed with the following output:\n"
+      "${OUTPUT}\nFile ${SOURCEFILE}:\n"
+      "${CONTENT}\n")
+  else()
+    if(NOT "${QUIET}")
+      message(STATUS "Looking for ${SYMBOL} - not found")
+    endif()
+    set(${VARIABLE} "" CACHE INTERNAL "Have symbol ${SYMBOL}")
+    file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+      "Determining if the ${SYMBOL} "
+      "exist failed with the following output:\n"
+      "${OUTPUT}\nFile ${SOURCEFILE}:\n"
+      "${CONTENT}\n")
+  endif()
+endmacro()
+
 macro(CHECK_SYMBOL_EXISTS SYMBOL FILES VARIABLE)
   if(CMAKE_C_COMPILER_LOADED)
     __CHECK_SYMBOL_EXISTS_IMPL("${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckSymbolExists.c" "${SYMBOL}" "${FILES}" "${VARIABLE}" )
@@ -137,28 +162,10 @@ int main(int argc, char** argv)
       CMAKE_FLAGS
       -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_SYMBOL_EXISTS_FLAGS}
       "${CMAKE_SYMBOL_EXISTS_INCLUDES}"
-      OUTPUT_VARIABLE OUTPUT)
-    if(${VARIABLE})
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${SYMBOL} - found")
-      endif()
-      set(${VARIABLE} 1 CACHE INTERNAL "Have symbol ${SYMBOL}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Determining if the ${SYMBOL} "
-        "exist passed with the following output:\n"
-        "${OUTPUT}\nFile ${SOURCEFILE}:\n"
-        "${CMAKE_CONFIGURABLE_FILE_CONTENT}\n")
-    else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${SYMBOL} - not found")
-      endif()
-      set(${VARIABLE} "" CACHE INTERNAL "Have symbol ${SYMBOL}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Determining if the ${SYMBOL} "
-        "exist failed with the following output:\n"
-        "${OUTPUT}\nFile ${SOURCEFILE}:\n"
-        "${CMAKE_CONFIGURABLE_FILE_CONTENT}\n")
-    endif()
+      OUTPUT_VARIABLE OUTPUT
+      __CMAKE_FINISH _CHECK_SYMBOL_EXISTS_FINISH
+        "${SOURCEFILE}" "${SYMBOL}" "${VARIABLE}" "${CMAKE_REQUIRED_QUIET}"
+        "${CMAKE_CONFIGURABLE_FILE_CONTENT}")
     unset(CMAKE_CONFIGURABLE_FILE_CONTENT)
   endif()
 endmacro()
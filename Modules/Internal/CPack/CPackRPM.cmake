@@ -975,21 +975,48 @@ function(cpack_rpm_generate_package)
 
   # CPACK_RPM_COMPRESSION_TYPE
   #
+  # Validate the compression settings as the other generators do.
+  if(DEFINED CPACK_COMPRESSION_LEVEL AND
+      (NOT CPACK_COMPRESSION_LEVEL MATCHES "^[0-9]+$" OR
+       CPACK_COMPRESSION_LEVEL GREATER 22))
+    message(FATAL_ERROR "CPackRPM: Invalid CPACK_COMPRESSION_LEVEL value: ${CPACK_COMPRESSION_LEVEL}")
+  endif()
+  if(DEFINED CPACK_THREADS AND
+      (NOT CPACK_THREADS MATCHES "^[0-9]+$" OR CPACK_THREADS GREATER 1024))
+    message(FATAL_ERROR "CPackRPM: Invalid CPACK_THREADS value: ${CPACK_THREADS}")
+  endif()
   if (CPACK_RPM_COMPRESSION_TYPE)
      if(CPACK_RPM_PACKAGE_DEBUG)
        message("CPackRPM:Debug: User Specified RPM compression type: ${CPACK_RPM_COMPRESSION_TYPE}")
      endif()
+     set(_payload_level "")
+     set(_payload_threads "")
      if(CPACK_RPM_COMPRESSION_TYPE STREQUAL "lzma")
-       set(CPACK_RPM_COMPRESSION_TYPE_TMP "%define _binary_payload w9.lzdio")
+       set(_payload_level 9)
+       set(_payload_io "lzdio")
      endif()
      if(CPACK_RPM_COMPRESSION_TYPE STREQUAL "xz")
-       set(CPACK_RPM_COMPRESSION_TYPE_TMP "%define _binary_payload w7.xzdio")
+       set(_payload_level 7)
+       set(_payload_io "xzdio")
+       # rpm 4.14 and above compress xz payloads with multiple threads
+       if(DEFINED CPACK_THREADS AND NOT CPACK_THREADS EQUAL 1)
+         set(_payload_threads "T${CPACK_THREADS}")
+       endif()
      endif()
      if(CPACK_RPM_COMPRESSION_TYPE STREQUAL "bzip2")
-       set(CPACK_RPM_COMPRESSION_TYPE_TMP "%define _binary_payload w9.bzdio")
+       set(_payload_level 9)
+       set(_payload_io "bzdio")
      endif()
      if(CPACK_RPM_COMPRESSION_TYPE STREQUAL "gzip")
-       set(CPACK_RPM_COMPRESSION_TYPE_TMP "%define _binary_payload w9.gzdio")
+       set(_payload_level 9)
+       set(_payload_io "gzdio")
+     endif()
+     if(_payload_level)
+       if(CPACK_COMPRESSION_LEVEL)
+         set(_payload_level "${CPACK_COMPRESSION_LEVEL}")
+       endif()
+       set(CPACK_RPM_COMPRESSION_TYPE_TMP
+         "%define _binary_payload w${_payload_level}${_payload_threads}.${_payload_io}")
      endif()
   else()
      set(CPACK_RPM_COMPRESSION_TYPE_TMP "")
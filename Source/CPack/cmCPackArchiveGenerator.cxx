@@ -93,6 +93,10 @@ std::string cmCPackArchiveGenerator::GetArchiveComponentFileName(
 int cmCPackArchiveGenerator::InitializeInternal()
 {
   this->SetOptionIfNotSet("CPACK_INCLUDE_TOPLEVEL_DIRECTORY", "1");
+  if (!this->GetCompressionSettings(this->CompressionLevel,
+                                    this->NumThreads)) {
+    return 0;
+  }
   return this->Superclass::InitializeInternal();
 }
 
@@ -113,6 +117,23 @@ int cmCPackArchiveGenerator::addOneComponentToArchive(
                     << std::strerror(workdir.GetLastResult()) << std::endl);
     return 0;
   }
+  std::string const filePrefix = this->GetComponentFilePrefix();
+  for (std::string const& file : component->Files) {
+    std::string rp = filePrefix + file;
+    cmCPackLogger(cmCPackLog::LOG_DEBUG, "Adding file: " << rp << std::endl);
+    archive.Add(rp, 0, nullptr, false);
+    if (!archive) {
+      cmCPackLogger(cmCPackLog::LOG_ERROR,
+                    "ERROR while packaging files: " << archive.GetError()
+                                                    << std::endl);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+std::string cmCPackArchiveGenerator::GetComponentFilePrefix() const
+{
   std::string filePrefix;
   if (this->IsOn("CPACK_COMPONENT_INCLUDE_TOPLEVEL_DIRECTORY")) {
     filePrefix = cmStrCat(this->GetOption("CPACK_PACKAGE_FILE_NAME"), '/');
@@ -124,18 +145,26 @@ int cmCPackArchiveGenerator::addOneComponentToArchive(
     filePrefix += installPrefix + 1;
     filePrefix += "/";
   }
-  for (std::string const& file : component->Files) {
-    std::string rp = filePrefix + file;
-    cmCPackLogger(cmCPackLog::LOG_DEBUG, "Adding file: " << rp << std::endl);
-    archive.Add(rp, 0, nullptr, false);
-    if (!archive) {
-      cmCPackLogger(cmCPackLog::LOG_ERROR,
-                    "ERROR while packaging files: " << archive.GetError()
-                                                    << std::endl);
-      return 0;
+  return filePrefix;
+}
+
+std::string cmCPackArchiveGenerator::GetComponentsManifest(
+  std::vector<cmCPackComponent*> const& components) const
+{
+  if (!this->IncrementalStaging) {
+    return std::string();
+  }
+  std::string const filePrefix = this->GetComponentFilePrefix();
+  std::vector<std::string> componentFiles;
+  for (cmCPackComponent const* component : components) {
+    std::string const localToplevel =
+      cmStrCat(this->GetOption("CPACK_TEMPORARY_DIRECTORY"), '/',
+               component->Name, '/', filePrefix);
+    for (std::string const& file : component->Files) {
+      componentFiles.push_back(localToplevel + file);
     }
   }
-  return 1;
+  return this->GetStagingManifest(componentFiles);
 }
 
 /*
@@ -152,7 +181,8 @@ int cmCPackArchiveGenerator::addOneComponentToArchive(
                     << (filename) << ">." << std::endl);                      \
     return 0;                                                                 \
   }                                                                           \
-  cmArchiveWrite archive(gf, this->Compress, this->ArchiveFormat);            \
+  cmArchiveWrite archive(gf, this->Compress, this->ArchiveFormat,             \
+                         this->CompressionLevel, this->NumThreads);           \
   do {                                                                        \
     if (!(archive)) {                                                         \
       cmCPackLogger(cmCPackLog::LOG_ERROR,                                    \
@@ -176,15 +206,20 @@ int cmCPackArchiveGenerator::PackageComponents(bool ignoreGroup)
       std::string packageFileName = std::string(toplevel) + "/" +
         this->GetArchiveComponentFileName(compG.first, true);
 
-      // open a block in order to automatically close archive
-      // at the end of the block
-      {
-        DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
-        // now iterate over the component of this group
-        for (cmCPackComponent* comp : (compG.second).Components) {
-          // Add the files of this component to the archive
-          addOneComponentToArchive(archive, comp);
+      std::string const manifest =
+        this->GetComponentsManifest(compG.second.Components);
+      if (!this->IsPackageUpToDate(packageFileName, manifest)) {
+        // open a block in order to automatically close archive
+        // at the end of the block
+        {
+          DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
+          // now iterate over the component of this group
+          for (cmCPackComponent* comp : (compG.second).Components) {
+            // Add the files of this component to the archive
+            addOneComponentToArchive(archive, comp);
+          }
         }
+        this->RecordStagingManifest(packageFileName, manifest);
       }
       // add the generated package to package file names list
       packageFileNames.push_back(std::move(packageFileName));
@@ -207,10 +242,15 @@ int cmCPackArchiveGenerator::PackageComponents(bool ignoreGroup)
         packageFileName +=
           "/" + this->GetArchiveComponentFileName(comp.first, false);
 
-        {
-          DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
-          // Add the files of this component to the archive
-          addOneComponentToArchive(archive, &(comp.second));
+        std::string const manifest =
+          this->GetComponentsManifest({ &comp.second });
+        if (!this->IsPackageUpToDate(packageFileName, manifest)) {
+          {
+            DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
+            // Add the files of this component to the archive
+            addOneComponentToArchive(archive, &(comp.second));
+          }
+          this->RecordStagingManifest(packageFileName, manifest);
         }
         // add the generated package to package file names list
         packageFileNames.push_back(std::move(packageFileName));
@@ -228,10 +268,15 @@ int cmCPackArchiveGenerator::PackageComponents(bool ignoreGroup)
       packageFileName +=
         "/" + this->GetArchiveComponentFileName(comp.first, false);
 
-      {
-        DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
-        // Add the files of this component to the archive
-        addOneComponentToArchive(archive, &(comp.second));
+      std::string const manifest =
+        this->GetComponentsManifest({ &comp.second });
+      if (!this->IsPackageUpToDate(packageFileName, manifest)) {
+        {
+          DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
+          // Add the files of this component to the archive
+          addOneComponentToArchive(archive, &(comp.second));
+        }
+        this->RecordStagingManifest(packageFileName, manifest);
       }
       // add the generated package to package file names list
       packageFileNames.push_back(std::move(packageFileName));
@@ -259,15 +304,28 @@ int cmCPackArchiveGenerator::PackageComponentsAllInOne()
                 "Packaging all groups in one package..."
                 "(CPACK_COMPONENTS_ALL_GROUPS_IN_ONE_PACKAGE is set)"
                   << std::endl);
-  DECLARE_AND_OPEN_ARCHIVE(packageFileNames[0], archive);
 
-  // The ALL COMPONENTS in ONE package case
+  std::vector<cmCPackComponent*> components;
   for (auto& comp : this->Components) {
-    // Add the files of this component to the archive
-    addOneComponentToArchive(archive, &(comp.second));
+    components.push_back(&comp.second);
   }
+  std::string const manifest = this->GetComponentsManifest(components);
+  if (this->IsPackageUpToDate(packageFileNames[0], manifest)) {
+    return 1;
+  }
+
+  {
+    DECLARE_AND_OPEN_ARCHIVE(packageFileNames[0], archive);
 
-  // archive goes out of scope so it will finalized and closed.
+    // The ALL COMPONENTS in ONE package case
+    for (cmCPackComponent* comp : components) {
+      // Add the files of this component to the archive
+      addOneComponentToArchive(archive, comp);
+    }
+
+    // archive goes out of scope so it will finalized and closed.
+  }
+  this->RecordStagingManifest(packageFileNames[0], manifest);
   return 1;
 }
 
@@ -291,6 +349,19 @@ int cmCPackArchiveGenerator::PackageFiles()
   }
 
   // CASE 3 : NON COMPONENT package.
+  std::string const manifest = this->GetStagingManifest(files);
+  if (this->IsPackageUpToDate(packageFileNames[0], manifest)) {
+    return 1;
+  }
+  if (!this->PackageFilesToArchive()) {
+    return 0;
+  }
+  this->RecordStagingManifest(packageFileNames[0], manifest);
+  return 1;
+}
+
+int cmCPackArchiveGenerator::PackageFilesToArchive()
+{
   DECLARE_AND_OPEN_ARCHIVE(packageFileNames[0], archive);
   cmWorkingDirectory workdir(toplevel);
   if (workdir.Failed()) {
@@ -48,6 +48,13 @@ private:
   std::string GetArchiveComponentFileName(const std::string& component,
                                           bool isGroupName);
 
+  // get the prefix of component files relative to their staging directory
+  std::string GetComponentFilePrefix() const;
+
+  // get the staging manifest of an archive holding the given components
+  std::string GetComponentsManifest(
+    std::vector<cmCPackComponent*> const& components) const;
+
 protected:
   int InitializeInternal() override;
   /**
@@ -77,6 +84,10 @@ protected:
    * components will be put in a single installer.
    */
   int PackageComponentsAllInOne();
+  /**
+   * Package all files of a non-component install into a single archive.
+   */
+  int PackageFilesToArchive();
 
 private:
   const char* GetNameOfClass() override { return "cmCPackArchiveGenerator"; }
@@ -88,6 +99,8 @@ private:
 
 private:
   cmArchiveWrite::Compress Compress;
+  int CompressionLevel = 0;
+  int NumThreads = 1;
   std::string ArchiveFormat;
   std::string OutputExtension;
 };
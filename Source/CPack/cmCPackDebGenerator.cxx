@@ -28,8 +28,8 @@ class DebGenerator
 public:
   DebGenerator(cmCPackLog* logger, std::string outputName, std::string workDir,
                std::string topLevelDir, std::string temporaryDir,
-               const char* debianCompressionType,
-               const char* debianArchiveType,
+               const char* debianCompressionType, int compressionLevel,
+               int numThreads, const char* debianArchiveType,
                std::map<std::string, std::string> controlValues,
                bool genShLibs, std::string shLibsFilename, bool genPostInst,
                std::string postInst, bool genPostRm, std::string postRm,
@@ -41,8 +41,9 @@ public:
 private:
   void generateDebianBinaryFile() const;
   void generateControlFile() const;
-  bool generateDataTar() const;
-  std::string generateMD5File() const;
+  bool generateDataTar(std::map<std::string, std::string>& md5s) const;
+  std::string generateMD5File(
+    std::map<std::string, std::string> const& md5s) const;
   bool generateControlTar(std::string const& md5Filename) const;
   bool generateDeb() const;
 
@@ -53,6 +54,8 @@ private:
   const std::string TopLevelDir;
   const std::string TemporaryDir;
   const char* DebianArchiveType;
+  const int CompressionLevel;
+  const int NumThreads;
   const std::map<std::string, std::string> ControlValues;
   const bool GenShLibs;
   const std::string ShLibsFilename;
@@ -69,7 +72,8 @@ private:
 DebGenerator::DebGenerator(
   cmCPackLog* logger, std::string outputName, std::string workDir,
   std::string topLevelDir, std::string temporaryDir,
-  const char* debianCompressionType, const char* debianArchiveType,
+  const char* debianCompressionType, int compressionLevel, int numThreads,
+  const char* debianArchiveType,
   std::map<std::string, std::string> controlValues, bool genShLibs,
   std::string shLibsFilename, bool genPostInst, std::string postInst,
   bool genPostRm, std::string postRm, const char* controlExtra,
@@ -80,6 +84,8 @@ DebGenerator::DebGenerator(
   , TopLevelDir(std::move(topLevelDir))
   , TemporaryDir(std::move(temporaryDir))
   , DebianArchiveType(debianArchiveType ? debianArchiveType : "gnutar")
+  , CompressionLevel(compressionLevel)
+  , NumThreads(numThreads)
   , ControlValues(std::move(controlValues))
   , GenShLibs(genShLibs)
   , ShLibsFilename(std::move(shLibsFilename))
@@ -121,10 +127,13 @@ bool DebGenerator::generate() const
 {
   generateDebianBinaryFile();
   generateControlFile();
-  if (!generateDataTar()) {
+  // The md5sums are computed while the files are added to data.tar
+  // so that each file is read only once.
+  std::map<std::string, std::string> md5s;
+  if (!generateDataTar(md5s)) {
     return false;
   }
-  std::string md5Filename = generateMD5File();
+  std::string md5Filename = generateMD5File(md5s);
   if (!generateControlTar(md5Filename)) {
     return false;
   }
@@ -160,7 +169,8 @@ void DebGenerator::generateControlFile() const
   out << std::endl;
 }
 
-bool DebGenerator::generateDataTar() const
+bool DebGenerator::generateDataTar(
+  std::map<std::string, std::string>& md5s) const
 {
   std::string filename_data_tar = WorkDir + "/data.tar" + CompressionSuffix;
   cmGeneratedFileStream fileStream_data_tar;
@@ -172,12 +182,13 @@ bool DebGenerator::generateDataTar() const
     return false;
   }
   cmArchiveWrite data_tar(fileStream_data_tar, TarCompressionType,
-                          DebianArchiveType);
+                          DebianArchiveType, CompressionLevel, NumThreads);
 
   // uid/gid should be the one of the root user, and this root user has
   // always uid/gid equal to 0.
   data_tar.SetUIDAndGID(0u, 0u);
   data_tar.SetUNAMEAndGNAME("root", "root");
+  data_tar.SetContentHashAlgorithm(cmCryptoHash::AlgoMD5);
 
   // now add all directories which have to be compressed
   // collect all top level install dirs for that
@@ -240,10 +251,12 @@ bool DebGenerator::generateDataTar() const
       return false;
     }
   }
+  md5s = data_tar.GetContentHashes();
   return true;
 }
 
-std::string DebGenerator::generateMD5File() const
+std::string DebGenerator::generateMD5File(
+  std::map<std::string, std::string> const& md5s) const
 {
   std::string md5filename = WorkDir + "/md5sums";
 
@@ -257,8 +270,10 @@ std::string DebGenerator::generateMD5File() const
       continue;
     }
 
-    std::string output =
-      cmSystemTools::ComputeFileHash(file, cmCryptoHash::AlgoMD5);
+    auto const md5 = md5s.find(file);
+    std::string output = md5 != md5s.end()
+      ? md5->second
+      : cmSystemTools::ComputeFileHash(file, cmCryptoHash::AlgoMD5);
     if (output.empty()) {
       cmCPackLogger(cmCPackLog::LOG_ERROR,
                     "Problem computing the md5 of " << file << std::endl);
@@ -442,6 +457,10 @@ int cmCPackDebGenerator::InitializeInternal()
   if (cmIsOff(this->GetOption("CPACK_SET_DESTDIR"))) {
     this->SetOption("CPACK_SET_DESTDIR", "I_ON");
   }
+  if (!this->GetCompressionSettings(this->CompressionLevel,
+                                    this->NumThreads)) {
+    return 0;
+  }
   return this->Superclass::InitializeInternal();
 }
 
@@ -780,6 +799,7 @@ int cmCPackDebGenerator::createDeb()
     this->GetOption("CPACK_TOPLEVEL_DIRECTORY"),
     this->GetOption("CPACK_TEMPORARY_DIRECTORY"),
     this->GetOption("GEN_CPACK_DEBIAN_COMPRESSION_TYPE"),
+    this->CompressionLevel, this->NumThreads,
     this->GetOption("GEN_CPACK_DEBIAN_ARCHIVE_TYPE"), controlValues, gen_shibs,
     shlibsfilename, this->IsOn("GEN_CPACK_DEBIAN_GENERATE_POSTINST"), postinst,
     this->IsOn("GEN_CPACK_DEBIAN_GENERATE_POSTRM"), postrm,
@@ -837,6 +857,7 @@ int cmCPackDebGenerator::createDbgsymDDeb()
     this->GetOption("CPACK_TOPLEVEL_DIRECTORY"),
     this->GetOption("CPACK_TEMPORARY_DIRECTORY"),
     this->GetOption("GEN_CPACK_DEBIAN_COMPRESSION_TYPE"),
+    this->CompressionLevel, this->NumThreads,
     this->GetOption("GEN_CPACK_DEBIAN_ARCHIVE_TYPE"), controlValues, false, "",
     false, "", false, "", nullptr,
     this->IsSet("GEN_CPACK_DEBIAN_PACKAGE_CONTROL_STRICT_PERMISSION"),
@@ -68,6 +68,8 @@ private:
   int createDbgsymDDeb();
 
   std::vector<std::string> packageFiles;
+  int CompressionLevel = 0;
+  int NumThreads = 1;
 };
 
 #endif
@@ -7,10 +7,14 @@
 #include <memory>
 #include <utility>
 
+#include "cmsys/Directory.hxx"
 #include "cmsys/FStream.hxx"
 #include "cmsys/Glob.hxx"
 #include "cmsys/RegularExpression.hxx"
 
+#include "cm_uv.h"
+
+#include "cmBinaryCacheFile.h"
 #include "cmCPackComponentGroup.h"
 #include "cmCPackLog.h"
 #include "cmCryptoHash.h"
@@ -33,6 +37,24 @@
 #  include <StorageDefs.h>
 #endif
 
+namespace {
+// Stamp the files below a staging directory, keyed by full path.
+std::map<std::string, cmBinaryCacheFile::Stamp> StampStagedFiles(
+  std::string const& directory)
+{
+  std::map<std::string, cmBinaryCacheFile::Stamp> stamps;
+  cmsys::Glob gl;
+  gl.RecurseOn();
+  gl.SetRecurseThroughSymlinks(false);
+  gl.FindFiles(directory + "/*");
+  for (std::string const& file : gl.GetFiles()) {
+    stamps.emplace(cmSystemTools::CollapseFullPath(file),
+                   cmBinaryCacheFile::StampPath(file));
+  }
+  return stamps;
+}
+}
+
 cmCPackGenerator::cmCPackGenerator()
 {
   this->GeneratorVerbose = cmSystemTools::OUTPUT_NONE;
@@ -176,7 +198,9 @@ int cmCPackGenerator::PrepareNames()
 int cmCPackGenerator::InstallProject()
 {
   cmCPackLogger(cmCPackLog::LOG_OUTPUT, "Install projects" << std::endl);
-  this->CleanTemporaryDirectory();
+  if (!this->IncrementalStaging) {
+    this->CleanTemporaryDirectory();
+  }
 
   std::string bareTempInstallDirectory =
     this->GetOption("CPACK_TEMPORARY_INSTALL_DIRECTORY");
@@ -258,6 +282,14 @@ int cmCPackGenerator::InstallProject()
     return 0;
   }
 
+  // Components may share a staging directory, so prune only once all of
+  // them are staged.
+  for (std::string const& dir : this->StagedDirectories) {
+    if (!this->PruneStagingDirectory(dir)) {
+      return 0;
+    }
+  }
+
   if (setDestDir) {
     cmSystemTools::PutEnv("DESTDIR=");
   }
@@ -860,13 +892,15 @@ int cmCPackGenerator::InstallCMakeProject(
   std::vector<std::string> filesBefore;
   std::string findExpr = tempInstallDirectory;
   if (componentInstall) {
-    cmsys::Glob glB;
     findExpr += "/*";
-    glB.RecurseOn();
-    glB.SetRecurseListDirs(true);
-    glB.FindFiles(findExpr);
-    filesBefore = glB.GetFiles();
-    std::sort(filesBefore.begin(), filesBefore.end());
+    if (!this->IncrementalStaging) {
+      cmsys::Glob glB;
+      glB.RecurseOn();
+      glB.SetRecurseListDirs(true);
+      glB.FindFiles(findExpr);
+      filesBefore = glB.GetFiles();
+      std::sort(filesBefore.begin(), filesBefore.end());
+    }
   }
 
   // If CPack was asked to warn on ABSOLUTE INSTALL DESTINATION
@@ -882,8 +916,51 @@ int cmCPackGenerator::InstallCMakeProject(
       this->IsOn("CPACK_ERROR_ON_ABSOLUTE_INSTALL_DESTINATION")) {
     mf.AddDefinition("CMAKE_ERROR_ON_ABSOLUTE_INSTALL_DESTINATION", "1");
   }
+  // Files written by install(CODE) and install(SCRIPT) rules are not
+  // listed in the install manifest.  Stamp the kept staging directory to
+  // find the files this component creates or modifies.
+  std::map<std::string, cmBinaryCacheFile::Stamp> stampsBefore;
+  if (this->IncrementalStaging) {
+    stampsBefore = StampStagedFiles(tempInstallDirectory);
+  }
+
   // do installation
   bool res = mf.ReadListFile(installFile);
+
+  // A kept staging directory still holds the files of the previous run,
+  // so the files of this component are those in the install manifest
+  // and those created or modified by the installation.  They are claimed
+  // along with the directories leading to them, unless a component
+  // staged before did, just as if they appeared now.  Stale files are
+  // pruned once every component sharing the directory is staged.
+  std::set<std::string> claimedFiles;
+  if (this->IncrementalStaging) {
+    this->StagedDirectories.insert(tempInstallDirectory);
+    std::string const prefix =
+      cmSystemTools::CollapseFullPath(tempInstallDirectory) + "/";
+    std::vector<std::string> installed;
+    std::vector<std::string> manifest =
+      cmExpandedList(mf.GetSafeDefinition("CMAKE_INSTALL_MANIFEST_FILES"));
+    for (std::string const& file : manifest) {
+      // The manifest does not include DESTDIR.
+      installed.push_back(cmSystemTools::CollapseFullPath(
+        setDestDir ? tempInstallDirectory + file : file));
+    }
+    for (auto const& stamp : StampStagedFiles(tempInstallDirectory)) {
+      auto const before = stampsBefore.find(stamp.first);
+      if (before == stampsBefore.end() || before->second != stamp.second ||
+          before->second.Inode != stamp.second.Inode) {
+        installed.push_back(stamp.first);
+      }
+    }
+    for (std::string path : installed) {
+      while (cmHasPrefix(path, prefix) &&
+             this->StagedFiles.insert(path).second) {
+        claimedFiles.insert(path);
+        path = cmSystemTools::GetFilenamePath(path);
+      }
+    }
+  }
   // forward definition of CMAKE_ABSOLUTE_DESTINATION_FILES
   // to CPack (may be used by generators like CPack RPM or DEB)
   // in order to transparently handle ABSOLUTE PATH
@@ -894,12 +971,17 @@ int cmCPackGenerator::InstallCMakeProject(
   // Now rebuild the list of files after installation
   // of the current component (if we are in component install)
   if (componentInstall) {
-    cmsys::Glob glA;
-    glA.RecurseOn();
-    glA.SetRecurseListDirs(true);
-    glA.SetRecurseThroughSymlinks(false);
-    glA.FindFiles(findExpr);
-    std::vector<std::string> filesAfter = glA.GetFiles();
+    std::vector<std::string> filesAfter;
+    if (this->IncrementalStaging) {
+      filesAfter.assign(claimedFiles.begin(), claimedFiles.end());
+    } else {
+      cmsys::Glob glA;
+      glA.RecurseOn();
+      glA.SetRecurseListDirs(true);
+      glA.SetRecurseThroughSymlinks(false);
+      glA.FindFiles(findExpr);
+      filesAfter = glA.GetFiles();
+    }
     std::sort(filesAfter.begin(), filesAfter.end());
     std::vector<std::string>::iterator diff;
     std::vector<std::string> result(filesAfter.size());
@@ -1000,7 +1082,26 @@ int cmCPackGenerator::DoPackage()
     return 0;
   }
 
-  if (cmIsOn(this->GetOption("CPACK_REMOVE_TOPLEVEL_DIRECTORY"))) {
+  this->IncrementalStaging = this->IsOn("CPACK_INCREMENTAL_STAGING");
+  if (this->IncrementalStaging) {
+    // Only the files installed by CMake projects are known, so anything
+    // else has to be staged from scratch.
+    for (const char* var :
+         { "CPACK_INSTALL_COMMANDS", "CPACK_INSTALL_SCRIPT",
+           "CPACK_INSTALL_SCRIPTS", "CPACK_INSTALLED_DIRECTORIES" }) {
+      const char* value = this->GetOption(var);
+      if (value && *value) {
+        cmCPackLogger(cmCPackLog::LOG_VERBOSE,
+                      var << " is set, disabling incremental staging"
+                          << std::endl);
+        this->IncrementalStaging = false;
+        break;
+      }
+    }
+  }
+
+  if (!this->IncrementalStaging &&
+      cmIsOn(this->GetOption("CPACK_REMOVE_TOPLEVEL_DIRECTORY"))) {
     const char* toplevelDirectory =
       this->GetOption("CPACK_TOPLEVEL_DIRECTORY");
     if (cmSystemTools::FileExists(toplevelDirectory)) {
@@ -1044,7 +1145,8 @@ int cmCPackGenerator::DoPackage()
                 "Package files to: "
                   << (tempPackageFileName ? tempPackageFileName : "(NULL)")
                   << std::endl);
-  if (cmSystemTools::FileExists(tempPackageFileName)) {
+  if (!this->IncrementalStaging &&
+      cmSystemTools::FileExists(tempPackageFileName)) {
     cmCPackLogger(cmCPackLog::LOG_VERBOSE,
                   "Remove old package file" << std::endl);
     cmSystemTools::RemoveFile(tempPackageFileName);
@@ -1204,6 +1306,32 @@ const char* cmCPackGenerator::GetOption(const std::string& op) const
   return ret;
 }
 
+bool cmCPackGenerator::GetCompressionSettings(int& compressionLevel,
+                                              int& numThreads) const
+{
+  compressionLevel = 0;
+  numThreads = 1;
+  unsigned long value;
+  if (const char* level = this->GetOption("CPACK_COMPRESSION_LEVEL")) {
+    if (!cmStrToULong(level, &value) || value > 22) {
+      cmCPackLogger(cmCPackLog::LOG_ERROR,
+                    "Invalid CPACK_COMPRESSION_LEVEL value: " << level
+                                                               << std::endl);
+      return false;
+    }
+    compressionLevel = static_cast<int>(value);
+  }
+  if (const char* threads = this->GetOption("CPACK_THREADS")) {
+    if (!cmStrToULong(threads, &value) || value > 1024) {
+      cmCPackLogger(cmCPackLog::LOG_ERROR,
+                    "Invalid CPACK_THREADS value: " << threads << std::endl);
+      return false;
+    }
+    numThreads = static_cast<int>(value);
+  }
+  return true;
+}
+
 std::vector<std::string> cmCPackGenerator::GetOptions() const
 {
   return this->MakefileMap->GetDefinitions();
@@ -1283,6 +1411,128 @@ bool cmCPackGenerator::ConfigureFile(const std::string& inName,
                                           false) == 1;
 }
 
+bool cmCPackGenerator::PruneStagingDirectory(std::string const& directory)
+{
+  cmsys::Glob gl;
+  gl.RecurseOn();
+  gl.SetRecurseThroughSymlinks(false);
+  gl.FindFiles(directory + "/*");
+  std::set<std::string> emptiedDirectories;
+  for (std::string const& file : gl.GetFiles()) {
+    if (this->StagedFiles.count(cmSystemTools::CollapseFullPath(file))) {
+      continue;
+    }
+    cmCPackLogger(cmCPackLog::LOG_VERBOSE,
+                  "Remove stale staged file: " << file << std::endl);
+    if (!cmSystemTools::RemoveFile(file)) {
+      cmCPackLogger(cmCPackLog::LOG_ERROR,
+                    "Problem removing stale staged file: " << file
+                                                           << std::endl);
+      return false;
+    }
+    emptiedDirectories.insert(cmSystemTools::GetFilenamePath(file));
+  }
+
+  // Remove the directories left empty, deepest first.
+  for (auto dir = emptiedDirectories.rbegin();
+       dir != emptiedDirectories.rend(); ++dir) {
+    std::string path = *dir;
+    while (path.size() > directory.size() &&
+           cmHasPrefix(path, directory)) {
+      cmsys::Directory d;
+      if (!d.Load(path) || d.GetNumberOfFiles() > 2 ||
+          !cmSystemTools::RemoveADirectory(path)) {
+        break;
+      }
+      path = cmSystemTools::GetFilenamePath(path);
+    }
+  }
+  return true;
+}
+
+std::string cmCPackGenerator::GetStagingManifest(
+  std::vector<std::string> const& stagedFiles) const
+{
+  if (!this->IncrementalStaging) {
+    return std::string();
+  }
+
+  std::ostringstream manifest;
+  manifest << "# CPack " << cmVersion::GetCMakeVersion() << ' ' << this->Name
+           << '\n';
+
+  // Settings that may affect the package.
+  std::vector<std::string> options = this->GetOptions();
+  std::sort(options.begin(), options.end());
+  for (std::string const& option : options) {
+    if (cmHasLiteralPrefix(option, "CPACK_")) {
+      manifest << option << '=' << this->GetOption(option) << '\n';
+    }
+  }
+
+  // Installation keeps the time stamp of files that did not change, but
+  // time stamps may be truncated to whole seconds when copied, so also
+  // record a digest of the content.  Reading the staged files is still
+  // far cheaper than compressing them again.
+  cmCryptoHash hasher(cmCryptoHash::AlgoMD5);
+  for (std::string const& file : stagedFiles) {
+    uv_fs_t req;
+    if (uv_fs_lstat(nullptr, &req, file.c_str(), nullptr) == 0) {
+      manifest << std::oct << req.statbuf.st_mode << std::dec << ' '
+               << req.statbuf.st_size << ' ' << req.statbuf.st_mtim.tv_sec
+               << '.' << req.statbuf.st_mtim.tv_nsec << ' ' << file;
+      if ((req.statbuf.st_mode & S_IFMT) == S_IFLNK) {
+        std::string target;
+        cmSystemTools::ReadSymlink(file, target);
+        manifest << " -> " << target;
+      } else if ((req.statbuf.st_mode & S_IFMT) == S_IFREG) {
+        manifest << ' ' << hasher.HashFile(file);
+      }
+    } else {
+      manifest << "missing " << file;
+    }
+    manifest << '\n';
+    uv_fs_req_cleanup(&req);
+  }
+  return manifest.str();
+}
+
+bool cmCPackGenerator::IsPackageUpToDate(std::string const& packageFileName,
+                                         std::string const& manifest) const
+{
+  if (manifest.empty() || !cmSystemTools::FileExists(packageFileName)) {
+    return false;
+  }
+  std::string const manifestFile = packageFileName + ".manifest";
+  cmsys::ifstream fin(manifestFile.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  std::ostringstream previous;
+  previous << fin.rdbuf();
+  if (previous.str() != manifest) {
+    // The package is about to be replaced.
+    fin.close();
+    cmSystemTools::RemoveFile(manifestFile);
+    return false;
+  }
+  cmCPackLogger(cmCPackLog::LOG_OUTPUT,
+                "- Reuse unchanged package: " << packageFileName
+                                               << std::endl);
+  return true;
+}
+
+void cmCPackGenerator::RecordStagingManifest(
+  std::string const& packageFileName, std::string const& manifest) const
+{
+  if (manifest.empty()) {
+    return;
+  }
+  cmGeneratedFileStream fout(packageFileName + ".manifest");
+  fout.SetCopyIfDifferent(true);
+  fout << manifest;
+}
+
 int cmCPackGenerator::CleanTemporaryDirectory()
 {
   std::string tempInstallDirectory =
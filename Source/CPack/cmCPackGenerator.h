@@ -6,6 +6,7 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -115,6 +116,37 @@ protected:
 
   int CleanTemporaryDirectory();
 
+  /**
+   * Remove files of the kept staging directory that were not installed
+   * again by this run (incremental staging only).  Called once all
+   * components are staged.
+   */
+  bool PruneStagingDirectory(std::string const& directory);
+
+  /**
+   * Describe the given staged files and the CPack settings that may
+   * affect a package holding them.  With incremental staging a package
+   * whose manifest did not change since it was created is reused.
+   * IsPackageUpToDate forgets the manifest of a package that is out of
+   * date, and RecordStagingManifest records it once it is recreated.
+   * @return an empty string if incremental staging is disabled.
+   */
+  std::string GetStagingManifest(
+    std::vector<std::string> const& stagedFiles) const;
+  bool IsPackageUpToDate(std::string const& packageFileName,
+                         std::string const& manifest) const;
+  void RecordStagingManifest(std::string const& packageFileName,
+                             std::string const& manifest) const;
+
+  /**
+   * Read the compression level and number of compression threads
+   * requested by CPACK_COMPRESSION_LEVEL and CPACK_THREADS.
+   * A level of 0 selects the compressor default and 0 threads
+   * selects one thread per available processor.
+   * @return false if either value is not a valid number.
+   */
+  bool GetCompressionSettings(int& compressionLevel, int& numThreads) const;
+
   cmInstalledFile const* GetInstalledFile(std::string const& name) const;
 
   virtual const char* GetOutputExtension() { return ".cpack"; }
@@ -286,6 +318,14 @@ protected:
   std::vector<std::string> files;
 
   std::vector<cmCPackInstallCMakeProject> CMakeProjects;
+
+  /**
+   * Whether the staging directory is kept from a previous run
+   * (CPACK_INCREMENTAL_STAGING) and the files installed into it.
+   */
+  bool IncrementalStaging = false;
+  std::set<std::string> StagedFiles;
+  std::set<std::string> StagedDirectories;
   std::map<std::string, cmCPackInstallationType> InstallationTypes;
   /**
    * The set of components.
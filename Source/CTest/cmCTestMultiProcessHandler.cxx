@@ -11,7 +11,6 @@
 #include <cstring>
 #include <iomanip>
 #include <iostream>
-#include <list>
 #include <memory>
 #include <sstream>
 #include <stack>
@@ -19,6 +18,8 @@
 #include <utility>
 #include <vector>
 
+#include <cm/memory>
+
 #include "cmsys/FStream.hxx"
 #include "cmsys/SystemInformation.hxx"
 
@@ -31,10 +32,10 @@
 #include "cmCTest.h"
 #include "cmCTestBinPacker.h"
 #include "cmCTestRunTest.h"
+#include "cmCTestShardWorker.h"
 #include "cmCTestTestHandler.h"
 #include "cmDuration.h"
 #include "cmListFileCache.h"
-#include "cmRange.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmUVSignalHackRAII.h" // IWYU pragma: keep
@@ -63,6 +64,36 @@ private:
   cmCTestMultiProcessHandler* Handler;
 };
 
+class CriticalPathComparator
+{
+public:
+  CriticalPathComparator(cmCTestMultiProcessHandler* handler)
+    : Handler(handler)
+  {
+  }
+
+  // Sorts tests in descending order of the cost of the longest chain of
+  // tests starting with them, then of the number of tests on that chain
+  bool operator()(int index1, int index2) const
+  {
+    double const cost1 = Handler->CriticalPathCost[index1];
+    double const cost2 = Handler->CriticalPathCost[index2];
+    if (cost1 != cost2) {
+      return cost1 > cost2;
+    }
+    size_t const length1 = Handler->CriticalPathLength[index1];
+    size_t const length2 = Handler->CriticalPathLength[index2];
+    if (length1 != length2) {
+      return length1 > length2;
+    }
+    return Handler->Properties[index1]->Cost >
+      Handler->Properties[index2]->Cost;
+  }
+
+private:
+  cmCTestMultiProcessHandler* Handler;
+};
+
 cmCTestMultiProcessHandler::cmCTestMultiProcessHandler()
 {
   this->ParallelLevel = 1;
@@ -122,7 +153,10 @@ void cmCTestMultiProcessHandler::SetTestLoad(unsigned long load)
 
 void cmCTestMultiProcessHandler::RunTests()
 {
-  this->CheckResume();
+  bool const shardWorker = this->CTest->GetShardWorkerMode();
+  if (!shardWorker) {
+    this->CheckResume();
+  }
   if (this->HasCycles) {
     return;
   }
@@ -131,21 +165,222 @@ void cmCTestMultiProcessHandler::RunTests()
 #endif
   this->TestHandler->SetMaxIndex(this->FindMaxIndex());
 
+  bool const scheduleReport = this->CTest->GetScheduleReport();
+  double predictedMakespan = 0;
+  if (scheduleReport) {
+    predictedMakespan = this->PredictMakespan();
+  }
+  auto const startTime = std::chrono::steady_clock::now();
+
   uv_loop_init(&this->Loop);
   this->StartNextTests();
   uv_run(&this->Loop, UV_RUN_DEFAULT);
   uv_loop_close(&this->Loop);
 
+  if (scheduleReport) {
+    this->PrintScheduleReport(predictedMakespan,
+                              std::chrono::steady_clock::now() - startTime);
+  }
+
   if (!this->StopTimePassed) {
     assert(this->Completed == this->Total);
     assert(this->Tests.empty());
   }
   assert(this->AllHardwareAvailable());
 
-  this->MarkFinished();
+  // The coordinator of a shard worker keeps the books.
+  if (!shardWorker) {
+    this->MarkFinished();
+    this->UpdateCostData();
+  }
+}
+
+void cmCTestMultiProcessHandler::RunShardWorkers()
+{
+  if (this->HasCycles) {
+    return;
+  }
+#ifdef CMAKE_UV_SIGNAL_HACK
+  cmUVSignalHackRAII hackRAII;
+#endif
+  this->TestHandler->SetMaxIndex(this->FindMaxIndex());
+
+  std::string const& command = cmSystemTools::GetCTestCommand();
+  std::vector<std::string> const arguments = this->GetShardWorkerArguments();
+  int const shardCount = this->CTest->GetShardWorkers();
+
+  uv_loop_init(&this->Loop);
+  std::vector<std::unique_ptr<cmCTestShardWorker>> workers;
+  for (int shard = 0; shard < shardCount; ++shard) {
+    std::vector<std::string> args = arguments;
+    args.emplace_back("--shard-index");
+    args.push_back(std::to_string(shard));
+    args.emplace_back("--shard-count");
+    args.push_back(std::to_string(shardCount));
+    auto worker = cm::make_unique<cmCTestShardWorker>(*this, shard);
+    if (worker->Start(this->Loop, command, args)) {
+      workers.push_back(std::move(worker));
+    }
+  }
+  uv_run(&this->Loop, UV_RUN_DEFAULT);
+  uv_loop_close(&this->Loop);
+
+  // No worker reported the remaining tests, either because it did not
+  // start or exit cleanly or because the stop time passed.
+  std::vector<int> missing;
+  for (auto const& t : this->Tests) {
+    missing.push_back(t.first);
+  }
+  for (int test : missing) {
+    cmCTestTestHandler::cmCTestTestResult result;
+    result.Name = this->Properties[test]->Name;
+    result.Path = this->Properties[test]->Directory;
+    result.Reason = "No shard worker reported a result for this test";
+    result.ExecutionTime = cmDuration::zero();
+    result.ReturnValue = -1;
+    result.Status = cmCTestTestHandler::NOT_RUN;
+    result.CompressOutput = false;
+    result.CompletionStatus = "Not Run";
+    result.TestCount = test;
+    this->FinishShardTest(result, false);
+  }
+
   this->UpdateCostData();
 }
 
+std::vector<std::string> cmCTestMultiProcessHandler::GetShardWorkerArguments()
+  const
+{
+  // The coordinator alone drives the dashboard steps and writes the
+  // results and reports.
+  static std::set<std::string> const dropWithValue = {
+    "-D",
+    "--dashboard",
+    "-T",
+    "--test-action",
+    "-M",
+    "--test-model",
+    "--group",
+    "--track",
+    "-O",
+    "--output-log",
+    "--extra-submit",
+    "--shard-workers",
+    "-j",
+    "--parallel",
+  };
+  static std::set<std::string> const drop = {
+    "--schedule-report", "--no-compress-output", "-Q", "--quiet"
+  };
+
+  std::vector<std::string> const& args =
+    this->CTest->GetInitialCommandLineArguments();
+  std::vector<std::string> workerArgs;
+  for (size_t i = 1; i < args.size(); ++i) {
+    if (dropWithValue.count(args[i]) && i + 1 < args.size() &&
+        // Keep variable definitions given to -D.
+        !((args[i] == "-D" || args[i] == "--dashboard") &&
+          args[i + 1].find('=') != std::string::npos)) {
+      ++i;
+    } else if (!drop.count(args[i]) && args[i].compare(0, 2, "-j") != 0) {
+      workerArgs.push_back(args[i]);
+    }
+  }
+  // The workers share the parallel level instead of each using all of it.
+  size_t const workers = static_cast<size_t>(this->CTest->GetShardWorkers());
+  workerArgs.emplace_back("-j");
+  workerArgs.push_back(
+    std::to_string(std::max<size_t>(1, this->ParallelLevel / workers)));
+  workerArgs.emplace_back("-Q");
+  workerArgs.emplace_back("--no-compress-output");
+  workerArgs.emplace_back("--shard-worker");
+  return workerArgs;
+}
+
+void cmCTestMultiProcessHandler::FinishShardTest(
+  cmCTestTestHandler::cmCTestTestResult& result, bool passed)
+{
+  int const test = result.TestCount;
+  // Keep the first result should a test be reported more than once.
+  if (this->Tests.erase(test) == 0) {
+    return;
+  }
+  this->Completed++;
+  auto properties = this->Properties[test];
+  result.Properties = properties;
+
+  bool const skipped =
+    passed && result.Status != cmCTestTestHandler::COMPLETED;
+  bool const outputTestErrorsToConsole = !passed &&
+    result.Status != cmCTestTestHandler::NOT_RUN &&
+    this->CTest->GetOutputTestOutputOnTestFailure();
+
+  std::ostringstream outputStream;
+  outputStream << std::setw(getNumWidth(this->Total)) << this->Completed
+               << "/" << std::setw(getNumWidth(this->Total)) << this->Total
+               << " Test";
+  std::ostringstream indexStr;
+  indexStr << " #" << test << ":";
+  outputStream << std::setw(3 + getNumWidth(this->TestHandler->GetMaxIndex()))
+               << indexStr.str() << " ";
+  std::string outname = result.Name + " ";
+  outname.resize(this->CTest->GetMaxTestNameWidth() + 4, '.');
+  outputStream << outname << cmCTestRunTest::GetStatusString(result, skipped)
+               << cmCTestRunTest::GetTimeString(result.ExecutionTime) << "\n";
+  cmCTestLog(this->CTest, HANDLER_OUTPUT, outputStream.str());
+  if (outputTestErrorsToConsole) {
+    cmCTestLog(this->CTest, HANDLER_OUTPUT, result.Output << std::endl);
+  }
+
+  std::ostream& log = *this->TestHandler->LogFile;
+  log << test << "/" << this->TestHandler->TotalNumberOfTests
+      << " Test: " << result.Name << std::endl
+      << "Command: " << result.FullCommandLine << std::endl
+      << "Directory: " << result.Path << std::endl
+      << "Output:" << std::endl
+      << "----------------------------------------------------------"
+      << std::endl
+      << result.Output << "<end of output>" << std::endl;
+  cmCTestRunTest::WriteLogResult(log, this->CTest, result,
+                                 result.ExecutionTime);
+
+  if (this->CTest->ShouldCompressTestOutput()) {
+    std::string str = result.Output;
+    if (this->CTest->CompressString(str) &&
+        str.length() < result.Output.length()) {
+      result.Output = std::move(str);
+      result.CompressOutput = true;
+    }
+  }
+
+  if (result.Status == cmCTestTestHandler::COMPLETED) {
+    double prev = static_cast<double>(properties->PreviousRuns);
+    double avgcost = static_cast<double>(properties->Cost);
+    properties->Cost = static_cast<float>(
+      ((prev * avgcost) + result.ExecutionTime.count()) / (prev + 1.0));
+    properties->PreviousRuns++;
+  }
+
+  if (passed) {
+    this->Passed->push_back(properties->Name);
+  } else if (!properties->Disabled) {
+    this->Failed->push_back(properties->Name);
+  }
+  this->TestResults->push_back(result);
+}
+
+void cmCTestMultiProcessHandler::FinishShardWorker(
+  cmCTestShardWorker const& worker, int64_t exitStatus, int termSignal)
+{
+  // A worker exits with a non-zero status when some of its tests fail,
+  // so only complain if it could not run its tests at all.
+  if (termSignal != 0 || (exitStatus != 0 && worker.GetResultCount() == 0)) {
+    cmCTestLog(this->CTest, ERROR_MESSAGE,
+               "Shard worker " << worker.GetShard() << " exited abnormally"
+                               << std::endl);
+  }
+}
+
 bool cmCTestMultiProcessHandler::StartTestProcess(int test)
 {
   if (this->HaveAffinity && this->Properties[test]->WantAffinity) {
@@ -370,8 +605,25 @@ void cmCTestMultiProcessHandler::DeallocateResources(int index)
 void cmCTestMultiProcessHandler::EraseTest(int test)
 {
   this->Tests.erase(test);
-  this->SortedTests.erase(
-    std::find(this->SortedTests.begin(), this->SortedTests.end(), test));
+  auto const position = this->SortedTestPositions.find(test);
+  if (position != this->SortedTestPositions.end()) {
+    this->ReadyTests.erase(position->second);
+  }
+}
+
+void cmCTestMultiProcessHandler::ReleaseDependents(int test)
+{
+  auto const dependents = this->Dependents.find(test);
+  if (dependents == this->Dependents.end()) {
+    return;
+  }
+  for (int dependent : dependents->second) {
+    auto const t = this->Tests.find(dependent);
+    if (t != this->Tests.end() && t->second.erase(test) != 0 &&
+        t->second.empty()) {
+      this->ReadyTests.insert(this->SortedTestPositions[dependent]);
+    }
+  }
 }
 
 inline size_t cmCTestMultiProcessHandler::GetProcessorsUsed(int test)
@@ -438,6 +690,12 @@ void cmCTestMultiProcessHandler::StartNextTests()
     return;
   }
 
+  // The remaining tests wait on running tests, which will call us again
+  // when they finish.
+  if (this->ReadyTests.empty()) {
+    return;
+  }
+
   size_t numToStart = 0;
 
   if (this->RunningCount < this->ParallelLevel) {
@@ -486,8 +744,11 @@ void cmCTestMultiProcessHandler::StartNextTests()
     }
   }
 
-  TestList copy = this->SortedTests;
-  for (auto const& test : copy) {
+  for (auto i = this->ReadyTests.begin(); i != this->ReadyTests.end();) {
+    // Starting the test removes it from the ready tests.
+    int const test = this->SortedTests[*i];
+    ++i;
+
     // Take a nap if we're currently performing a RUN_SERIAL test.
     if (this->SerialTestRunning) {
       break;
@@ -520,6 +781,11 @@ void cmCTestMultiProcessHandler::StartNextTests()
       numToStart -= processors;
     } else if (numToStart == 0) {
       break;
+    } else if (this->Tests.find(test) == this->Tests.end()) {
+      // The test could not start and finished at once, which may have
+      // made ready some tests already passed over.  Nothing else may
+      // call us again, so look at them now.
+      i = this->ReadyTests.begin();
     }
   }
 
@@ -527,8 +793,8 @@ void cmCTestMultiProcessHandler::StartNextTests()
     // Find out whether there are any non RUN_SERIAL tests left, so that the
     // correct warning may be displayed.
     bool onlyRunSerialTestsLeft = true;
-    for (auto const& test : copy) {
-      if (!this->Properties[test]->RunSerial) {
+    for (auto const& t : this->Tests) {
+      if (!this->Properties[t.first]->RunSerial) {
         onlyRunSerialTestsLeft = false;
       }
     }
@@ -595,13 +861,18 @@ void cmCTestMultiProcessHandler::FinishTestProcess(cmCTestRunTest* runner,
     this->Failed->push_back(properties->Name);
   }
 
-  for (auto& t : this->Tests) {
-    t.second.erase(test);
-  }
+  this->ReleaseDependents(test);
 
   this->TestFinishMap[test] = true;
   this->TestRunningMap[test] = false;
-  this->WriteCheckpoint(test);
+  if (this->CTest->GetShardWorkerMode()) {
+    // Report the result to the coordinator as soon as we have it.
+    std::cout << cmCTestShardWorker::EncodeResult(this->TestResults->back(),
+                                                  testResult)
+              << std::flush;
+  } else {
+    this->WriteCheckpoint(test);
+  }
   this->DeallocateHardware(test);
   this->DeallocateResources(test);
   this->RunningCount -= GetProcessorsUsed(test);
@@ -625,6 +896,7 @@ void cmCTestMultiProcessHandler::UpdateCostData()
   fout.open(tmpout.c_str());
 
   PropertiesMap temp = this->Properties;
+  std::unordered_map<std::string, int> const indexes = this->IndexTestNames();
 
   if (cmSystemTools::FileExists(fname)) {
     cmsys::ifstream fin;
@@ -645,11 +917,12 @@ void cmCTestMultiProcessHandler::UpdateCostData()
       int prev = atoi(parts[1].c_str());
       float cost = static_cast<float>(atof(parts[2].c_str()));
 
-      int index = this->SearchByName(name);
-      if (index == -1) {
+      auto const i = indexes.find(name);
+      if (i == indexes.end()) {
         // This test is not in memory. We just rewrite the entry
         fout << name << " " << prev << " " << cost << "\n";
       } else {
+        int index = i->second;
         // Update with our new average cost
         fout << name << " " << this->Properties[index]->PreviousRuns << " "
              << this->Properties[index]->Cost << "\n";
@@ -680,6 +953,8 @@ void cmCTestMultiProcessHandler::ReadCostData()
   std::string fname = this->CTest->GetCostDataFile();
 
   if (cmSystemTools::FileExists(fname, true)) {
+    std::unordered_map<std::string, int> const indexes =
+      this->IndexTestNames();
     cmsys::ifstream fin;
     fin.open(fname.c_str());
     std::string line;
@@ -700,10 +975,11 @@ void cmCTestMultiProcessHandler::ReadCostData()
       int prev = atoi(parts[1].c_str());
       float cost = static_cast<float>(atof(parts[2].c_str()));
 
-      int index = this->SearchByName(name);
-      if (index == -1) {
+      auto const i = indexes.find(name);
+      if (i == indexes.end()) {
         continue;
       }
+      int index = i->second;
 
       this->Properties[index]->PreviousRuns = prev;
       // When not running in parallel mode, don't use cost data
@@ -722,34 +998,45 @@ void cmCTestMultiProcessHandler::ReadCostData()
   }
 }
 
-int cmCTestMultiProcessHandler::SearchByName(std::string const& name)
+std::unordered_map<std::string, int>
+cmCTestMultiProcessHandler::IndexTestNames() const
 {
-  int index = -1;
-
+  std::unordered_map<std::string, int> indexes;
   for (auto const& p : this->Properties) {
-    if (p.second->Name == name) {
-      index = p.first;
-    }
+    indexes[p.second->Name] = p.first;
   }
-  return index;
+  return indexes;
 }
 
 void cmCTestMultiProcessHandler::CreateTestCostList()
 {
+  for (auto const& t : this->Tests) {
+    for (int dependency : t.second) {
+      this->Dependents[dependency].insert(t.first);
+    }
+  }
+
+  this->ComputeCriticalPaths();
   if (this->ParallelLevel > 1) {
     CreateParallelTestCostList();
   } else {
     CreateSerialTestCostList();
   }
+
+  // Keep track of the tests ready to start so that neither starting nor
+  // finishing a test needs to look at all the tests still waiting.
+  for (size_t i = 0; i < this->SortedTests.size(); ++i) {
+    int const test = this->SortedTests[i];
+    this->SortedTestPositions[test] = i;
+    if (this->Tests[test].empty()) {
+      this->ReadyTests.insert(i);
+    }
+  }
 }
 
 void cmCTestMultiProcessHandler::CreateParallelTestCostList()
 {
-  TestSet alreadySortedTests;
-
-  std::list<TestSet> priorityStack;
-  priorityStack.emplace_back();
-  TestSet& topLevel = priorityStack.back();
+  TestList presortedList;
 
   // In parallel test runs add previously failed tests to the front
   // of the cost list and queue other tests for further sorting
@@ -757,48 +1044,172 @@ void cmCTestMultiProcessHandler::CreateParallelTestCostList()
     if (cmContains(this->LastTestsFailed, this->Properties[t.first]->Name)) {
       // If the test failed last time, it should be run first.
       this->SortedTests.push_back(t.first);
-      alreadySortedTests.insert(t.first);
     } else {
-      topLevel.insert(t.first);
+      presortedList.push_back(t.first);
     }
   }
 
-  // In parallel test runs repeatedly move dependencies of the tests on
-  // the current dependency level to the next level until no
-  // further dependencies exist.
-  while (!priorityStack.back().empty()) {
-    TestSet& previousSet = priorityStack.back();
-    priorityStack.emplace_back();
-    TestSet& currentSet = priorityStack.back();
+  // Start the tests on the longest chains of dependent tests first,
+  // weighted by COST, so that long chains do not start late and
+  // dominate the total time.  Every test has at least the cost of the
+  // tests depending on it, so dependencies always come first.
+  std::stable_sort(presortedList.begin(), presortedList.end(),
+                   CriticalPathComparator(this));
+  cmAppend(this->SortedTests, presortedList);
+}
 
-    for (auto const& i : previousSet) {
-      TestSet const& dependencies = this->Tests[i];
-      currentSet.insert(dependencies.begin(), dependencies.end());
-    }
+void cmCTestMultiProcessHandler::ComputeCriticalPaths()
+{
+  this->CriticalPathCost.clear();
+  this->CriticalPathLength.clear();
+  this->CriticalPathNext.clear();
+  for (auto const& t : this->Tests) {
+    this->GetCriticalPathCost(t.first);
+  }
+}
 
-    for (auto const& i : currentSet) {
-      previousSet.erase(i);
+double cmCTestMultiProcessHandler::GetCriticalPathCost(int test)
+{
+  auto const known = this->CriticalPathCost.find(test);
+  if (known != this->CriticalPathCost.end()) {
+    return known->second;
+  }
+
+  double cost = 0;
+  size_t length = 0;
+  int next = -1;
+  auto const u = this->Dependents.find(test);
+  if (u != this->Dependents.end()) {
+    for (int user : u->second) {
+      if (!cmContains(this->Tests, user)) {
+        continue;
+      }
+      double const userCost = this->GetCriticalPathCost(user);
+      size_t const userLength = this->CriticalPathLength[user];
+      if (next == -1 || userCost > cost ||
+          (userCost == cost && userLength > length)) {
+        cost = userCost;
+        length = userLength;
+        next = user;
+      }
     }
   }
 
-  // Remove the empty dependency level
-  priorityStack.pop_back();
+  cost += this->Properties[test]->Cost;
+  this->CriticalPathCost[test] = cost;
+  this->CriticalPathLength[test] = length + 1;
+  this->CriticalPathNext[test] = next;
+  return cost;
+}
 
-  // Reverse iterate over the different dependency levels (deepest first).
-  // Sort tests within each level by COST and append them to the cost list.
-  for (TestSet const& currentSet : cmReverseRange(priorityStack)) {
-    TestList sortedCopy;
-    cmAppend(sortedCopy, currentSet);
-    std::stable_sort(sortedCopy.begin(), sortedCopy.end(),
-                     TestComparator(this));
+double cmCTestMultiProcessHandler::PredictMakespan()
+{
+  // Tests may have been removed when resuming an interrupted run.
+  this->ComputeCriticalPaths();
+
+  // Start tests in the order StartNextTests would, assuming each test
+  // takes as long as its COST.  Resource locks, RUN_SERIAL, and the
+  // test load are not taken into account.
+  std::map<int, size_t> waiting;
+  std::set<size_t> ready;
+  for (auto const& t : this->Tests) {
+    size_t& count = waiting[t.first];
+    for (int dependency : t.second) {
+      if (cmContains(this->Tests, dependency)) {
+        ++count;
+      }
+    }
+    if (count == 0) {
+      ready.insert(this->SortedTestPositions[t.first]);
+    }
+  }
 
-    for (auto const& j : sortedCopy) {
-      if (!cmContains(alreadySortedTests, j)) {
-        this->SortedTests.push_back(j);
-        alreadySortedTests.insert(j);
+  std::multimap<double, int> running;
+  double now = 0;
+  size_t processorsUsed = 0;
+  for (;;) {
+    for (auto i = ready.begin();
+         i != ready.end() && processorsUsed < this->ParallelLevel;) {
+      int const test = this->SortedTests[*i];
+      size_t const processors = this->GetProcessorsUsed(test);
+      if (processorsUsed + processors <= this->ParallelLevel) {
+        processorsUsed += processors;
+        running.emplace(now + this->Properties[test]->Cost, test);
+        i = ready.erase(i);
+      } else {
+        ++i;
       }
     }
+    if (running.empty()) {
+      break;
+    }
+
+    auto const next = running.begin();
+    now = next->first;
+    processorsUsed -= this->GetProcessorsUsed(next->second);
+    auto const dependents = this->Dependents.find(next->second);
+    if (dependents != this->Dependents.end()) {
+      for (int dependent : dependents->second) {
+        auto const w = waiting.find(dependent);
+        if (w != waiting.end() && --w->second == 0) {
+          ready.insert(this->SortedTestPositions[dependent]);
+        }
+      }
+    }
+    running.erase(next);
+  }
+  return now;
+}
+
+void cmCTestMultiProcessHandler::PrintScheduleReport(double predictedMakespan,
+                                                     cmDuration actual)
+{
+  // The critical path starts with the test on the longest chain.
+  int test = -1;
+  for (auto const& t : this->CriticalPathCost) {
+    if (test == -1 || t.second > this->CriticalPathCost[test] ||
+        (t.second == this->CriticalPathCost[test] &&
+         this->CriticalPathLength[t.first] >
+           this->CriticalPathLength[test])) {
+      test = t.first;
+    }
+  }
+  if (test == -1) {
+    return;
+  }
+
+  std::map<cmCTestTestHandler::cmCTestTestProperties const*, cmDuration>
+    executionTimes;
+  for (auto const& result : *this->TestResults) {
+    executionTimes[result.Properties] = result.ExecutionTime;
+  }
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(2);
+  out << "\nSchedule report:\n"
+      << "  Critical path (" << this->CriticalPathLength[test]
+      << " tests): " << this->CriticalPathCost[test] << " sec predicted\n";
+  for (; test != -1; test = this->CriticalPathNext[test]) {
+    int const next = this->CriticalPathNext[test];
+    double const predicted = this->CriticalPathCost[test] -
+      (next == -1 ? 0 : this->CriticalPathCost[next]);
+    out << "    " << std::setw(8) << predicted << " sec predicted, ";
+    auto const t = executionTimes.find(this->Properties[test]);
+    if (t != executionTimes.end()) {
+      out << std::setw(8) << t->second.count() << " sec actual: ";
+    } else {
+      out << "     not run: ";
+    }
+    out << this->Properties[test]->Name << "\n";
+  }
+  out << "  Predicted makespan with " << this->ParallelLevel
+      << " parallel jobs: " << predictedMakespan << " sec\n"
+      << "  Actual makespan: " << actual.count() << " sec\n";
+  if (predictedMakespan == 0) {
+    out << "  No test costs are known yet, run the tests once to "
+           "record them.\n";
   }
+  cmCTestLog(this->CTest, HANDLER_OUTPUT, out.str());
 }
 
 void cmCTestMultiProcessHandler::GetAllTestDependencies(int test,
@@ -1329,6 +1740,7 @@ void cmCTestMultiProcessHandler::CheckResume()
 void cmCTestMultiProcessHandler::RemoveTest(int index)
 {
   this->EraseTest(index);
+  this->ReleaseDependents(index);
   this->Properties.erase(index);
   this->TestRunningMap[index] = false;
   this->TestFinishMap[index] = true;
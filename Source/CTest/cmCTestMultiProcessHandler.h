@@ -8,20 +8,24 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "cm_uv.h"
 
 #include "cmCTestHardwareAllocator.h"
 #include "cmCTestTestHandler.h"
+#include "cmDuration.h"
 #include "cmUVHandlePtr.h"
 
 class cmCTest;
 struct cmCTestBinPackerAllocation;
 class cmCTestHardwareSpec;
 class cmCTestRunTest;
+class cmCTestShardWorker;
 
 /** \class cmCTestMultiProcessHandler
  * \brief run parallel ctest
@@ -31,7 +35,9 @@ class cmCTestRunTest;
 class cmCTestMultiProcessHandler
 {
   friend class TestComparator;
+  friend class CriticalPathComparator;
   friend class cmCTestRunTest;
+  friend class cmCTestShardWorker;
 
 public:
   struct TestSet : public std::set<int>
@@ -61,6 +67,9 @@ public:
   void SetParallelLevel(size_t);
   void SetTestLoad(unsigned long load);
   virtual void RunTests();
+  // Run the tests in --shard-workers ctest processes and merge the
+  // results they report
+  void RunShardWorkers();
   void PrintOutputAsJson();
   void PrintTestList();
   void PrintLabels();
@@ -105,8 +114,8 @@ protected:
 
   void UpdateCostData();
   void ReadCostData();
-  // Return index of a test based on its name
-  int SearchByName(std::string const& name);
+  // Return a map from test names to test indexes
+  std::unordered_map<std::string, int> IndexTestNames() const;
 
   void CreateTestCostList();
 
@@ -115,13 +124,30 @@ protected:
 
   void CreateParallelTestCostList();
 
+  // Compute the cost of the longest chain of dependent tests
+  // starting with each test
+  void ComputeCriticalPaths();
+  double GetCriticalPathCost(int test);
+  // Simulate running the remaining tests to predict the total time
+  double PredictMakespan();
+  void PrintScheduleReport(double predictedMakespan, cmDuration actual);
+
   // Removes the checkpoint file
   void MarkFinished();
   void EraseTest(int index);
+  // Remove a finished test from the dependencies of other tests
+  void ReleaseDependents(int index);
   void FinishTestProcess(cmCTestRunTest* runner, bool started);
 
   static void OnTestLoadRetryCB(uv_timer_t* timer);
 
+  // The arguments passed on to the shard workers
+  std::vector<std::string> GetShardWorkerArguments() const;
+  void FinishShardTest(cmCTestTestHandler::cmCTestTestResult& result,
+                       bool passed);
+  void FinishShardWorker(cmCTestShardWorker const& worker,
+                         int64_t exitStatus, int termSignal);
+
   void RemoveTest(int index);
   // Check if we need to resume an interrupted test set
   void CheckResume();
@@ -148,6 +174,18 @@ protected:
   // map from test number to set of depend tests
   TestMap Tests;
   TestList SortedTests;
+  // map from test number to set of tests depending on it
+  TestMap Dependents;
+  // map from test number to its position in SortedTests
+  std::map<int, size_t> SortedTestPositions;
+  // positions in SortedTests of the tests not waiting on dependencies
+  std::set<size_t> ReadyTests;
+  // cost of the longest chain of tests starting with each test
+  std::map<int, double> CriticalPathCost;
+  // number of tests on that chain
+  std::map<int, size_t> CriticalPathLength;
+  // next test on that chain, or -1 if there is none
+  std::map<int, int> CriticalPathNext;
   // Total number of tests we'll be running
   size_t Total;
   // Number of tests that are complete
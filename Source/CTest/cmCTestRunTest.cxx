@@ -123,7 +123,6 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
       }
     }
   }
-  std::ostringstream outputStream;
   if (res == cmProcess::State::Exited) {
     bool success = !forceFail &&
       (retVal == 0 ||
@@ -139,61 +138,48 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
         s << "SKIP_RETURN_CODE=" << this->TestProperties->SkipReturnCode;
       }
       this->TestResult.CompletionStatus = s.str();
-      cmCTestLog(this->CTest, HANDLER_OUTPUT, "***Skipped ");
       skipped = true;
     } else if (success != this->TestProperties->WillFail) {
       this->TestResult.Status = cmCTestTestHandler::COMPLETED;
-      outputStream << "   Passed  ";
     } else {
       this->TestResult.Status = cmCTestTestHandler::FAILED;
-      outputStream << "***Failed  " << reason;
       outputTestErrorsToConsole =
         this->CTest->GetOutputTestOutputOnTestFailure();
     }
   } else if (res == cmProcess::State::Expired) {
-    outputStream << "***Timeout ";
     this->TestResult.Status = cmCTestTestHandler::TIMEOUT;
     outputTestErrorsToConsole =
       this->CTest->GetOutputTestOutputOnTestFailure();
   } else if (res == cmProcess::State::Exception) {
     outputTestErrorsToConsole =
       this->CTest->GetOutputTestOutputOnTestFailure();
-    outputStream << "***Exception: ";
     this->TestResult.ExceptionStatus =
       this->TestProcess->GetExitExceptionString();
     switch (this->TestProcess->GetExitException()) {
       case cmProcess::Exception::Fault:
-        outputStream << "SegFault";
         this->TestResult.Status = cmCTestTestHandler::SEGFAULT;
         break;
       case cmProcess::Exception::Illegal:
-        outputStream << "Illegal";
         this->TestResult.Status = cmCTestTestHandler::ILLEGAL;
         break;
       case cmProcess::Exception::Interrupt:
-        outputStream << "Interrupt";
         this->TestResult.Status = cmCTestTestHandler::INTERRUPT;
         break;
       case cmProcess::Exception::Numerical:
-        outputStream << "Numerical";
         this->TestResult.Status = cmCTestTestHandler::NUMERICAL;
         break;
       default:
-        cmCTestLog(this->CTest, HANDLER_OUTPUT,
-                   this->TestResult.ExceptionStatus);
         this->TestResult.Status = cmCTestTestHandler::OTHER_FAULT;
     }
-  } else if ("Disabled" == this->TestResult.CompletionStatus) {
-    outputStream << "***Not Run (Disabled) ";
-  } else // cmProcess::State::Error
-  {
-    outputStream << "***Not Run ";
   }
+  // Otherwise the test was disabled or could not start, and its status
+  // was set when it was started.
 
   passed = this->TestResult.Status == cmCTestTestHandler::COMPLETED;
-  char buf[1024];
-  sprintf(buf, "%6.2f sec", this->TestProcess->GetTotalTime().count());
-  outputStream << buf << "\n";
+  this->TestResult.Reason = reason;
+  std::ostringstream outputStream;
+  outputStream << GetStatusString(this->TestResult, skipped)
+               << GetTimeString(this->TestProcess->GetTotalTime()) << "\n";
 
   if (this->CTest->GetTestProgressOutput()) {
     if (!passed) {
@@ -224,10 +210,6 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
     cmCTestLog(this->CTest, HANDLER_OUTPUT, this->ProcessOutput << std::endl);
   }
 
-  if (this->TestHandler->LogFile) {
-    *this->TestHandler->LogFile << "Test time = " << buf << std::endl;
-  }
-
   this->DartProcessing();
 
   // if this is doing MemCheck then all the output needs to be put into
@@ -240,46 +222,9 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
           ? this->TestHandler->CustomMaximumPassedTestOutputSize
           : this->TestHandler->CustomMaximumFailedTestOutputSize));
   }
-  this->TestResult.Reason = reason;
   if (this->TestHandler->LogFile) {
-    bool pass = true;
-    const char* reasonType = "Test Pass Reason";
-    if (this->TestResult.Status != cmCTestTestHandler::COMPLETED &&
-        this->TestResult.Status != cmCTestTestHandler::NOT_RUN) {
-      reasonType = "Test Fail Reason";
-      pass = false;
-    }
-    auto ttime = this->TestProcess->GetTotalTime();
-    auto hours = std::chrono::duration_cast<std::chrono::hours>(ttime);
-    ttime -= hours;
-    auto minutes = std::chrono::duration_cast<std::chrono::minutes>(ttime);
-    ttime -= minutes;
-    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(ttime);
-    char buffer[100];
-    sprintf(buffer, "%02d:%02d:%02d", static_cast<unsigned>(hours.count()),
-            static_cast<unsigned>(minutes.count()),
-            static_cast<unsigned>(seconds.count()));
-    *this->TestHandler->LogFile
-      << "----------------------------------------------------------"
-      << std::endl;
-    if (!this->TestResult.Reason.empty()) {
-      *this->TestHandler->LogFile << reasonType << ":\n"
-                                  << this->TestResult.Reason << "\n";
-    } else {
-      if (pass) {
-        *this->TestHandler->LogFile << "Test Passed.\n";
-      } else {
-        *this->TestHandler->LogFile << "Test Failed.\n";
-      }
-    }
-    *this->TestHandler->LogFile
-      << "\"" << this->TestProperties->Name
-      << "\" end time: " << this->CTest->CurrentTime() << std::endl
-      << "\"" << this->TestProperties->Name << "\" time elapsed: " << buffer
-      << std::endl
-      << "----------------------------------------------------------"
-      << std::endl
-      << std::endl;
+    WriteLogResult(*this->TestHandler->LogFile, this->CTest, this->TestResult,
+                   this->TestProcess->GetTotalTime());
   }
   // if the test actually started and ran
   // record the results in TestResult
@@ -314,6 +259,85 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
   return passed || skipped;
 }
 
+std::string cmCTestRunTest::GetStatusString(
+  cmCTestTestHandler::cmCTestTestResult const& result, bool skipped)
+{
+  if (skipped) {
+    return "***Skipped ";
+  }
+  switch (result.Status) {
+    case cmCTestTestHandler::COMPLETED:
+      return "   Passed  ";
+    case cmCTestTestHandler::FAILED:
+      return "***Failed  " + result.Reason;
+    case cmCTestTestHandler::TIMEOUT:
+      return "***Timeout ";
+    case cmCTestTestHandler::SEGFAULT:
+      return "***Exception: SegFault";
+    case cmCTestTestHandler::ILLEGAL:
+      return "***Exception: Illegal";
+    case cmCTestTestHandler::INTERRUPT:
+      return "***Exception: Interrupt";
+    case cmCTestTestHandler::NUMERICAL:
+      return "***Exception: Numerical";
+    case cmCTestTestHandler::OTHER_FAULT:
+      return "***Exception: " + result.ExceptionStatus;
+    default:
+      break;
+  }
+  if (result.CompletionStatus == "Disabled") {
+    return "***Not Run (Disabled) ";
+  }
+  return "***Not Run ";
+}
+
+std::string cmCTestRunTest::GetTimeString(cmDuration time)
+{
+  char buf[1024];
+  sprintf(buf, "%6.2f sec", time.count());
+  return buf;
+}
+
+void cmCTestRunTest::WriteLogResult(
+  std::ostream& log, cmCTest* ctest,
+  cmCTestTestHandler::cmCTestTestResult const& result, cmDuration time)
+{
+  bool pass = true;
+  const char* reasonType = "Test Pass Reason";
+  if (result.Status != cmCTestTestHandler::COMPLETED &&
+      result.Status != cmCTestTestHandler::NOT_RUN) {
+    reasonType = "Test Fail Reason";
+    pass = false;
+  }
+  log << "Test time = " << GetTimeString(time) << std::endl;
+  auto hours = std::chrono::duration_cast<std::chrono::hours>(time);
+  time -= hours;
+  auto minutes = std::chrono::duration_cast<std::chrono::minutes>(time);
+  time -= minutes;
+  auto seconds = std::chrono::duration_cast<std::chrono::seconds>(time);
+  char buffer[100];
+  sprintf(buffer, "%02d:%02d:%02d", static_cast<unsigned>(hours.count()),
+          static_cast<unsigned>(minutes.count()),
+          static_cast<unsigned>(seconds.count()));
+  log << "----------------------------------------------------------"
+      << std::endl;
+  if (!result.Reason.empty()) {
+    log << reasonType << ":\n" << result.Reason << "\n";
+  } else {
+    if (pass) {
+      log << "Test Passed.\n";
+    } else {
+      log << "Test Failed.\n";
+    }
+  }
+  log << "\"" << result.Name << "\" end time: " << ctest->CurrentTime()
+      << std::endl
+      << "\"" << result.Name << "\" time elapsed: " << buffer << std::endl
+      << "----------------------------------------------------------"
+      << std::endl
+      << std::endl;
+}
+
 bool cmCTestRunTest::StartAgain(size_t completed)
 {
   if (!this->RunAgain) {
@@ -5,6 +5,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <set>
@@ -74,6 +75,16 @@ public:
 
   void ComputeWeightedCost();
 
+  // The status of a finished test as printed after its name
+  static std::string GetStatusString(
+    cmCTestTestHandler::cmCTestTestResult const& result, bool skipped);
+  // The time taken by a test as printed after its status
+  static std::string GetTimeString(cmDuration time);
+  // Write the end of the log entry of a finished test
+  static void WriteLogResult(
+    std::ostream& log, cmCTest* ctest,
+    cmCTestTestHandler::cmCTestTestResult const& result, cmDuration time);
+
   bool StartAgain(size_t completed);
 
   void StartFailure(std::string const& output);
@@ -0,0 +1,213 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmCTestShardWorker.h"
+
+#include <utility>
+
+#include "cm_jsoncpp_reader.h"
+#include "cm_jsoncpp_value.h"
+#include "cm_jsoncpp_writer.h"
+
+#include "cmCTest.h"
+#include "cmCTestMultiProcessHandler.h"
+#include "cmDuration.h"
+#include "cmGetPipes.h"
+
+#define CM_SHARD_WORKER_BUF_SIZE 65536
+
+cmCTestShardWorker::cmCTestShardWorker(cmCTestMultiProcessHandler& handler,
+                                       int shard)
+  : Handler(handler)
+  , Shard(shard)
+{
+}
+
+bool cmCTestShardWorker::Start(uv_loop_t& loop, std::string const& command,
+                               std::vector<std::string> const& arguments)
+{
+  std::vector<const char*> args;
+  args.push_back(command.c_str());
+  for (std::string const& arg : arguments) {
+    args.push_back(arg.c_str());
+  }
+  args.push_back(nullptr);
+
+  cm::uv_pipe_ptr pipe_writer;
+  cm::uv_pipe_ptr pipe_reader;
+
+  pipe_writer.init(loop, 0);
+  pipe_reader.init(loop, 0, this);
+
+  int fds[2] = { -1, -1 };
+  int status = cmGetPipes(fds);
+  if (status != 0) {
+    cmCTestLog(this->Handler.CTest, ERROR_MESSAGE,
+               "Error initializing pipe: " << uv_strerror(status)
+                                           << std::endl);
+    return false;
+  }
+
+  uv_pipe_open(pipe_reader, fds[0]);
+  uv_pipe_open(pipe_writer, fds[1]);
+
+  // The worker reports its results on stdout and its errors on stderr.
+  uv_stdio_container_t stdio[3];
+  stdio[0].flags = UV_INHERIT_FD;
+  stdio[0].data.fd = 0;
+  stdio[1].flags = UV_INHERIT_STREAM;
+  stdio[1].data.stream = pipe_writer;
+  stdio[2].flags = UV_INHERIT_FD;
+  stdio[2].data.fd = 2;
+
+  uv_process_options_t options = uv_process_options_t();
+  options.file = command.c_str();
+  options.args = const_cast<char**>(args.data());
+  options.stdio_count = 3;
+  options.exit_cb = &cmCTestShardWorker::OnExitCB;
+  options.stdio = stdio;
+
+  status = uv_read_start(pipe_reader, &cmCTestShardWorker::OnAllocateCB,
+                         &cmCTestShardWorker::OnReadCB);
+  if (status != 0) {
+    cmCTestLog(this->Handler.CTest, ERROR_MESSAGE,
+               "Error starting read events: " << uv_strerror(status)
+                                              << std::endl);
+    return false;
+  }
+
+  status = this->Process.spawn(loop, options, this);
+  if (status != 0) {
+    cmCTestLog(this->Handler.CTest, ERROR_MESSAGE,
+               "Shard worker not started\n " << command << "\n["
+                                             << uv_strerror(status) << "]\n");
+    return false;
+  }
+
+  this->PipeReader = std::move(pipe_reader);
+  return true;
+}
+
+std::string cmCTestShardWorker::EncodeResult(
+  cmCTestTestHandler::cmCTestTestResult const& result, bool passed)
+{
+  Json::Value value(Json::objectValue);
+  value["index"] = result.TestCount;
+  value["name"] = result.Name;
+  value["path"] = result.Path;
+  value["command"] = result.FullCommandLine;
+  value["reason"] = result.Reason;
+  value["status"] = result.Status;
+  value["completion"] = result.CompletionStatus;
+  value["exception"] = result.ExceptionStatus;
+  value["returnValue"] = static_cast<Json::Int64>(result.ReturnValue);
+  value["time"] = result.ExecutionTime.count();
+  value["output"] = result.Output;
+  value["dart"] = result.DartString;
+  value["passed"] = passed;
+
+  // The fast writer puts everything on one line and ends it.
+  Json::FastWriter writer;
+  return writer.write(value);
+}
+
+bool cmCTestShardWorker::DecodeResult(
+  std::string const& line, cmCTestTestHandler::cmCTestTestResult& result,
+  bool& passed)
+{
+  Json::Value value;
+  Json::Reader reader;
+  if (!reader.parse(line, value, false) || !value.isObject() ||
+      !value["index"].isInt() || !value["name"].isString()) {
+    return false;
+  }
+  result.TestCount = value["index"].asInt();
+  result.Name = value["name"].asString();
+  result.Path = value["path"].asString();
+  result.FullCommandLine = value["command"].asString();
+  result.Reason = value["reason"].asString();
+  result.Status = value["status"].asInt();
+  result.CompletionStatus = value["completion"].asString();
+  result.ExceptionStatus = value["exception"].asString();
+  result.ReturnValue = value["returnValue"].asInt64();
+  result.ExecutionTime = cmDuration(value["time"].asDouble());
+  result.Output = value["output"].asString();
+  result.CompressOutput = false;
+  result.DartString = value["dart"].asString();
+  result.Properties = nullptr;
+  passed = value["passed"].asBool();
+  return true;
+}
+
+void cmCTestShardWorker::OnAllocateCB(uv_handle_t* handle,
+                                      size_t /*suggested_size*/,
+                                      uv_buf_t* buf)
+{
+  auto self = static_cast<cmCTestShardWorker*>(handle->data);
+  if (self->Buf.size() != CM_SHARD_WORKER_BUF_SIZE) {
+    self->Buf.resize(CM_SHARD_WORKER_BUF_SIZE);
+  }
+  *buf =
+    uv_buf_init(self->Buf.data(), static_cast<unsigned int>(self->Buf.size()));
+}
+
+void cmCTestShardWorker::OnReadCB(uv_stream_t* stream, ssize_t nread,
+                                  const uv_buf_t* buf)
+{
+  auto self = static_cast<cmCTestShardWorker*>(stream->data);
+  self->OnRead(nread, buf);
+}
+
+void cmCTestShardWorker::OnRead(ssize_t nread, const uv_buf_t* buf)
+{
+  if (nread > 0) {
+    this->Partial.append(buf->base, static_cast<size_t>(nread));
+    std::string::size_type first = 0;
+    std::string::size_type last;
+    while ((last = this->Partial.find('\n', first)) != std::string::npos) {
+      this->HandleLine(this->Partial.substr(first, last - first));
+      first = last + 1;
+    }
+    this->Partial.erase(0, first);
+    return;
+  }
+
+  if (nread == 0) {
+    return;
+  }
+
+  // The worker will provide no more data.
+  if (nread != UV_EOF) {
+    auto error = static_cast<int>(nread);
+    cmCTestLog(this->Handler.CTest, ERROR_MESSAGE,
+               "Error reading stream: " << uv_strerror(error) << std::endl);
+  }
+  if (!this->Partial.empty()) {
+    this->HandleLine(this->Partial);
+    this->Partial.clear();
+  }
+  this->PipeReader.reset();
+}
+
+void cmCTestShardWorker::HandleLine(std::string const& line)
+{
+  cmCTestTestHandler::cmCTestTestResult result;
+  bool passed;
+  // Anything else the worker prints is not for us.
+  if (DecodeResult(line, result, passed)) {
+    this->ResultCount++;
+    this->Handler.FinishShardTest(result, passed);
+  }
+}
+
+void cmCTestShardWorker::OnExitCB(uv_process_t* process, int64_t exit_status,
+                                  int term_signal)
+{
+  auto self = static_cast<cmCTestShardWorker*>(process->data);
+  self->OnExit(exit_status, term_signal);
+}
+
+void cmCTestShardWorker::OnExit(int64_t exit_status, int term_signal)
+{
+  this->Process.reset();
+  this->Handler.FinishShardWorker(*this, exit_status, term_signal);
+}
@@ -0,0 +1,69 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmCTestShardWorker_h
+#define cmCTestShardWorker_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <string>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cm_uv.h"
+
+#include "cmCTestTestHandler.h"
+#include "cmUVHandlePtr.h"
+
+class cmCTestMultiProcessHandler;
+
+/** \class cmCTestShardWorker
+ * \brief A ctest process running one shard of the tests for a coordinator
+ *
+ * The worker writes a line to its standard output for each test it
+ * finishes.  The coordinator reads these lines as they arrive and
+ * merges the results into its own.
+ */
+class cmCTestShardWorker
+{
+public:
+  cmCTestShardWorker(cmCTestMultiProcessHandler& handler, int shard);
+
+  // Return true if the worker process starts
+  bool Start(uv_loop_t& loop, std::string const& command,
+             std::vector<std::string> const& arguments);
+
+  int GetShard() const { return this->Shard; }
+  size_t GetResultCount() const { return this->ResultCount; }
+
+  // Encode a test result as a single line for the coordinator
+  static std::string EncodeResult(
+    cmCTestTestHandler::cmCTestTestResult const& result, bool passed);
+  // Decode a line written by EncodeResult
+  static bool DecodeResult(std::string const& line,
+                           cmCTestTestHandler::cmCTestTestResult& result,
+                           bool& passed);
+
+private:
+  static void OnAllocateCB(uv_handle_t* handle, size_t suggested_size,
+                           uv_buf_t* buf);
+  static void OnReadCB(uv_stream_t* stream, ssize_t nread,
+                       const uv_buf_t* buf);
+  static void OnExitCB(uv_process_t* process, int64_t exit_status,
+                       int term_signal);
+
+  void OnRead(ssize_t nread, const uv_buf_t* buf);
+  void OnExit(int64_t exit_status, int term_signal);
+  void HandleLine(std::string const& line);
+
+  cmCTestMultiProcessHandler& Handler;
+  int Shard;
+  size_t ResultCount = 0;
+  cm::uv_process_ptr Process;
+  cm::uv_pipe_ptr PipeReader;
+  std::vector<char> Buf;
+  std::string Partial;
+};
+
+#endif
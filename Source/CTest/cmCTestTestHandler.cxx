@@ -386,6 +386,19 @@ int cmCTestTestHandler::ProcessHandler()
 
   this->TestResults.clear();
 
+  if (this->CTest->GetShardWorkerMode()) {
+    // The coordinator reports the results and the summary.
+    cmGeneratedFileStream mLogFile;
+    this->StartLogFile(
+      cmStrCat("TestShard", this->CTest->GetShardIndex()).c_str(), mLogFile);
+    this->LogFile = &mLogFile;
+    std::vector<std::string> passed;
+    std::vector<std::string> failed;
+    this->ProcessDirectory(passed, failed);
+    this->LogFile = nullptr;
+    return failed.empty() ? 0 : -1;
+  }
+
   cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT,
                      (this->MemCheck ? "Memory check" : "Test")
                        << " project "
@@ -836,6 +849,7 @@ void cmCTestTestHandler::ComputeTestList()
     finalList.push_back(tp);
   }
 
+  this->SelectShard(finalList);
   UpdateForFixtures(finalList);
 
   // Save the total number of tests before exclusions
@@ -864,6 +878,7 @@ void cmCTestTestHandler::ComputeTestListForRerunFailed()
     finalList.push_back(tp);
   }
 
+  this->SelectShard(finalList);
   UpdateForFixtures(finalList);
 
   // Save the total number of tests before exclusions
@@ -875,6 +890,128 @@ void cmCTestTestHandler::ComputeTestListForRerunFailed()
   this->UpdateMaxTestNameWidth();
 }
 
+void cmCTestTestHandler::SelectShard(ListOfTests& tests) const
+{
+  int const shardCount = this->CTest->GetShardCount();
+  if (shardCount < 1) {
+    return;
+  }
+
+  // Every shard must come to the same assignment, so use only the
+  // COST properties and the cost data shared by all of them.
+  std::map<std::string, float> costData;
+  cmsys::ifstream fin(this->CTest->GetCostDataFile().c_str());
+  std::string line;
+  while (std::getline(fin, line) && line != "---") {
+    // Format: <name> <previous_runs> <avg_cost>
+    std::vector<std::string> parts = cmSystemTools::SplitString(line, ' ');
+    if (parts.size() < 3) {
+      break;
+    }
+    costData[parts[0]] = static_cast<float>(atof(parts[2].c_str()));
+  }
+
+  // Tests that must run in order or not concurrently go to the same
+  // shard: those connected by DEPENDS, sharing a fixture or a
+  // RESOURCE_LOCK, and all RUN_SERIAL tests.
+  std::vector<size_t> group(tests.size());
+  for (size_t i = 0; i < tests.size(); ++i) {
+    group[i] = i;
+  }
+  auto const findGroup = [&group](size_t i) {
+    while (group[i] != i) {
+      i = group[i] = group[group[i]];
+    }
+    return i;
+  };
+  std::map<std::string, size_t> keys;
+  auto const join = [&](std::string const& key, size_t i) {
+    auto const k = keys.emplace(key, i);
+    if (!k.second) {
+      group[findGroup(i)] = findGroup(k.first->second);
+    }
+  };
+  for (size_t i = 0; i < tests.size(); ++i) {
+    join("test:" + tests[i].Name, i);
+  }
+  for (size_t i = 0; i < tests.size(); ++i) {
+    cmCTestTestProperties const& p = tests[i];
+    for (std::string const& dep : p.Depends) {
+      if (keys.count("test:" + dep)) {
+        join("test:" + dep, i);
+      }
+    }
+    for (std::string const& lock : p.LockedResources) {
+      join("lock:" + lock, i);
+    }
+    for (auto const* fixtures :
+         { &p.FixturesSetup, &p.FixturesCleanup, &p.FixturesRequired }) {
+      for (std::string const& fixture : *fixtures) {
+        join("fixture:" + fixture, i);
+      }
+    }
+    if (p.RunSerial) {
+      join("serial", i);
+    }
+  }
+
+  std::vector<double> groupCost(tests.size(), 0);
+  std::vector<size_t> groupSize(tests.size(), 0);
+  for (size_t i = 0; i < tests.size(); ++i) {
+    float cost = tests[i].Cost;
+    if (cost == 0) {
+      auto const c = costData.find(tests[i].Name);
+      if (c != costData.end()) {
+        cost = c->second;
+      }
+    }
+    groupCost[findGroup(i)] += cost;
+    groupSize[findGroup(i)]++;
+  }
+  std::vector<size_t> groups;
+  for (size_t i = 0; i < tests.size(); ++i) {
+    if (findGroup(i) == i) {
+      groups.push_back(i);
+    }
+  }
+  // Give the most expensive groups out first, each to the shard with
+  // the least total cost so far.
+  std::stable_sort(groups.begin(), groups.end(),
+                   [&groupCost](size_t a, size_t b) {
+                     return groupCost[a] > groupCost[b];
+                   });
+
+  std::vector<double> shardCost(shardCount, 0);
+  std::vector<size_t> shardSize(shardCount, 0);
+  std::vector<int> groupShard(tests.size(), 0);
+  for (size_t g : groups) {
+    int shard = 0;
+    for (int s = 1; s < shardCount; ++s) {
+      if (shardCost[s] < shardCost[shard] ||
+          (shardCost[s] == shardCost[shard] &&
+           shardSize[s] < shardSize[shard])) {
+        shard = s;
+      }
+    }
+    shardCost[shard] += groupCost[g];
+    shardSize[shard] += groupSize[g];
+    groupShard[g] = shard;
+  }
+
+  std::vector<bool> selected(tests.size(), false);
+  for (size_t i = 0; i < tests.size(); ++i) {
+    selected[i] = groupShard[findGroup(i)] == this->CTest->GetShardIndex();
+  }
+
+  ListOfTests shardTests;
+  for (size_t i = 0; i < tests.size(); ++i) {
+    if (selected[i]) {
+      shardTests.push_back(tests[i]);
+    }
+  }
+  tests = std::move(shardTests);
+}
+
 void cmCTestTestHandler::UpdateForFixtures(ListOfTests& tests) const
 {
   cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
@@ -1289,6 +1426,8 @@ void cmCTestTestHandler::ProcessDirectory(std::vector<std::string>& passed,
     parallel->PrintLabels();
   } else if (this->CTest->GetShowOnly()) {
     parallel->PrintTestList();
+  } else if (this->CTest->GetShardWorkers() > 0 && !this->MemCheck) {
+    parallel->RunShardWorkers();
   } else {
     parallel->RunTests();
   }
@@ -298,6 +298,10 @@ private:
   // tests to account for fixture setup/cleanup
   void UpdateForFixtures(ListOfTests& tests) const;
 
+  // keep only the tests of the shard selected by --shard-index,
+  // balancing the shards by the cost of their tests
+  void SelectShard(ListOfTests& tests) const;
+
   void UpdateMaxTestNameWidth();
 
   bool GetValue(const char* tag, std::string& value, std::istream& fin);
@@ -14,6 +14,7 @@
 #include "cm_get_date.h"
 #include "cm_libarchive.h"
 
+#include "cmGlobalGenerator.h"
 #include "cmLocale.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
@@ -79,13 +80,18 @@ struct cmArchiveWrite::Callback
 };
 
 cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
-                               std::string const& format)
+                               std::string const& format,
+                               int compressionLevel, int numThreads)
   : Stream(os)
   , Archive(archive_write_new())
   , Disk(archive_read_disk_new())
   , Verbose(false)
   , Format(format)
 {
+  if (numThreads < 1) {
+    numThreads =
+      static_cast<int>(cmGlobalGenerator::GetParallelThreadCount());
+  }
   switch (c) {
     case CompressNone:
       if (archive_write_add_filter_none(this->Archive) != ARCHIVE_OK) {
@@ -107,6 +113,11 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
                                cm_archive_error_string(this->Archive));
         return;
       }
+      if (compressionLevel != 0 &&
+          !this->SetFilterOption("gzip", "compression-level",
+                                 std::to_string(compressionLevel))) {
+        return;
+      }
       std::string source_date_epoch;
       cmSystemTools::GetEnv("SOURCE_DATE_EPOCH", source_date_epoch);
       if (!source_date_epoch.empty()) {
@@ -126,6 +137,11 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
                                cm_archive_error_string(this->Archive));
         return;
       }
+      if (compressionLevel != 0 &&
+          !this->SetFilterOption("bzip2", "compression-level",
+                                 std::to_string(compressionLevel))) {
+        return;
+      }
       break;
     case CompressLZMA:
       if (archive_write_add_filter_lzma(this->Archive) != ARCHIVE_OK) {
@@ -133,6 +149,11 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
                                cm_archive_error_string(this->Archive));
         return;
       }
+      if (compressionLevel != 0 &&
+          !this->SetFilterOption("lzma", "compression-level",
+                                 std::to_string(compressionLevel))) {
+        return;
+      }
       break;
     case CompressXZ:
       if (archive_write_add_filter_xz(this->Archive) != ARCHIVE_OK) {
@@ -140,6 +161,18 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
                                cm_archive_error_string(this->Archive));
         return;
       }
+      if (compressionLevel != 0 &&
+          !this->SetFilterOption("xz", "compression-level",
+                                 std::to_string(compressionLevel))) {
+        return;
+      }
+      // libarchive falls back to one thread if liblzma has no
+      // multi-threaded encoder.
+      if (numThreads > 1 &&
+          !this->SetFilterOption("xz", "threads",
+                                 std::to_string(numThreads))) {
+        return;
+      }
       break;
     case CompressZstd:
       if (archive_write_add_filter_zstd(this->Archive) != ARCHIVE_OK) {
@@ -147,6 +180,16 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
                                cm_archive_error_string(this->Archive));
         return;
       }
+      if (compressionLevel != 0 &&
+          !this->SetFilterOption("zstd", "compression-level",
+                                 std::to_string(compressionLevel))) {
+        return;
+      }
+      if (numThreads > 1 &&
+          !this->SetFilterOption("zstd", "threads",
+                                 std::to_string(numThreads))) {
+        return;
+      }
       break;
   }
 #if !defined(_WIN32) || defined(__CYGWIN__)
@@ -187,6 +230,19 @@ cmArchiveWrite::~cmArchiveWrite()
   archive_write_free(this->Archive);
 }
 
+bool cmArchiveWrite::SetFilterOption(const char* module, const char* key,
+                                     std::string const& value)
+{
+  if (archive_write_set_filter_option(this->Archive, module, key,
+                                      value.c_str()) != ARCHIVE_OK) {
+    this->Error = cmStrCat("archive_write_set_filter_option: ", module, ':',
+                           key, '=', value, ": ",
+                           cm_archive_error_string(this->Archive));
+    return false;
+  }
+  return true;
+}
+
 bool cmArchiveWrite::Add(std::string path, size_t skip, const char* prefix,
                          bool recursive)
 {
@@ -315,9 +371,19 @@ bool cmArchiveWrite::AddFile(const char* file, size_t skip, const char* prefix)
 
   // do not copy content of symlink
   if (!archive_entry_symlink(e)) {
+    bool const hash =
+      this->ContentHash && archive_entry_filetype(e) == AE_IFREG;
+    if (hash) {
+      this->ContentHash->Initialize();
+    }
     // Content.
     if (size_t size = static_cast<size_t>(archive_entry_size(e))) {
-      return this->AddData(file, size);
+      if (!this->AddData(file, size)) {
+        return false;
+      }
+    }
+    if (hash) {
+      this->ContentHashes[file] = this->ContentHash->FinalizeHex();
     }
   }
   return true;
@@ -345,6 +411,9 @@ bool cmArchiveWrite::AddData(const char* file, size_t size)
     if (static_cast<size_t>(fin.gcount()) != nnext) {
       break;
     }
+    if (this->ContentHash) {
+      this->ContentHash->Append(buffer, nnext);
+    }
     if (archive_write_data(this->Archive, buffer, nnext) != nnext_s) {
       this->Error = cmStrCat("archive_write_data: ",
                              cm_archive_error_string(this->Archive));
@@ -7,8 +7,14 @@
 
 #include <cstddef>
 #include <iosfwd>
+#include <map>
+#include <memory>
 #include <string>
 
+#include <cm/memory>
+
+#include "cmCryptoHash.h"
+
 #if defined(CMAKE_BOOTSTRAP)
 #  error "cmArchiveWrite not allowed during bootstrap build!"
 #endif
@@ -53,9 +59,13 @@ public:
     CompressZstd
   };
 
-  /** Construct with output stream to which to write archive.  */
+  /** Construct with output stream to which to write archive.  A zero
+      compressionLevel selects the default level of the compressor.
+      The numThreads value limits the threads used by the xz and zstd
+      compressors, where zero means one per available processor.  */
   cmArchiveWrite(std::ostream& os, Compress c = CompressNone,
-                 std::string const& format = "paxr");
+                 std::string const& format = "paxr",
+                 int compressionLevel = 0, int numThreads = 1);
 
   ~cmArchiveWrite();
 
@@ -88,6 +98,20 @@ public:
 
   void SetMTime(std::string const& t) { this->MTime = t; }
 
+  //! Computes a digest of the content of each regular file while it
+  //! is added, so that callers need not read the file a second time
+  void SetContentHashAlgorithm(cmCryptoHash::Algo algo)
+  {
+    this->ContentHash = cm::make_unique<cmCryptoHash>(algo);
+  }
+
+  //! Returns the content digests of the regular files added so far,
+  //! indexed by their path on disk
+  std::map<std::string, std::string> const& GetContentHashes() const
+  {
+    return this->ContentHashes;
+  }
+
   //! Sets the permissions of the added files/folders
   void SetPermissions(int permissions_)
   {
@@ -145,6 +169,8 @@ private:
                bool recursive = true);
   bool AddFile(const char* file, size_t skip, const char* prefix);
   bool AddData(const char* file, size_t size);
+  bool SetFilterOption(const char* module, const char* key,
+                       std::string const& value);
 
   struct Callback;
   friend struct Callback;
@@ -159,6 +185,10 @@ private:
   std::string Error;
   std::string MTime;
 
+  //! Digests of the added file content, if requested
+  std::unique_ptr<cmCryptoHash> ContentHash;
+  std::map<std::string, std::string> ContentHashes;
+
   //! UID of the user in the tar file
   cmArchiveWriteOptional<int> Uid;
 
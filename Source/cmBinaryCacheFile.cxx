@@ -0,0 +1,141 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmBinaryCacheFile.h"
+
+#include <chrono>
+
+#include "cmsys/FStream.hxx"
+
+#if defined(_WIN32)
+#  include <process.h>
+#else
+#  include <unistd.h>
+#endif
+
+#if !defined(CMAKE_BOOTSTRAP)
+#  include "cm_uv.h"
+#else
+#  include "cmFileTime.h"
+#endif
+
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+#include "cmVersion.h"
+
+namespace {
+std::int64_t const NsPerS = 1000000000;
+
+long GetProcessId()
+{
+#if defined(_WIN32)
+  return static_cast<long>(_getpid());
+#else
+  return static_cast<long>(getpid());
+#endif
+}
+}
+
+bool cmBinaryCacheFile::Read(std::string const& path, Magic const& magic,
+                             std::string& buffer, cm::string_view& payload)
+{
+  buffer.clear();
+  {
+    cmsys::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+    if (!fin) {
+      return false;
+    }
+    fin.seekg(0, std::ios::end);
+    std::streamoff const length = fin.tellg();
+    fin.seekg(0, std::ios::beg);
+    if (length <= 0) {
+      return false;
+    }
+    buffer.resize(static_cast<size_t>(length));
+    if (!fin.read(&buffer[0], length)) {
+      buffer.clear();
+      return false;
+    }
+  }
+
+  cmBinaryCacheReader r(buffer);
+  cm::string_view header;
+  std::string version;
+  if (!r.GetView(header, sizeof(Magic)) ||
+      header != cm::string_view(magic, sizeof(Magic)) ||
+      !r.GetString(version) || version != cmVersion::GetCMakeVersion()) {
+    buffer.clear();
+    return false;
+  }
+  payload = cm::string_view(buffer).substr(sizeof(Magic) +
+                                           sizeof(std::uint32_t) +
+                                           version.size());
+  return true;
+}
+
+void cmBinaryCacheFile::WriteHeader(std::string& out, Magic const& magic)
+{
+  out.append(magic, sizeof(Magic));
+  cmBinaryCacheWriter(out).PutString(cmVersion::GetCMakeVersion());
+}
+
+bool cmBinaryCacheFile::Write(std::string const& path,
+                              cm::string_view content)
+{
+  std::string const tmp = cmStrCat(path, '.', GetProcessId(), ".tmp");
+  {
+    cmsys::ofstream fout(tmp.c_str(),
+                         std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!fout ||
+        !fout.write(content.data(),
+                    static_cast<std::streamsize>(content.size()))) {
+      fout.close();
+      cmSystemTools::RemoveFile(tmp);
+      return false;
+    }
+  }
+  if (!cmSystemTools::RenameFile(tmp, path)) {
+    cmSystemTools::RemoveFile(tmp);
+    return false;
+  }
+  return true;
+}
+
+cmBinaryCacheFile::Stamp cmBinaryCacheFile::StampPath(std::string const& path)
+{
+  Stamp stamp;
+#if !defined(CMAKE_BOOTSTRAP)
+  uv_fs_t req;
+  stamp.Exists = uv_fs_stat(nullptr, &req, path.c_str(), nullptr) == 0;
+  if (stamp.Exists) {
+    stamp.Regular = (req.statbuf.st_mode & S_IFMT) == S_IFREG;
+    stamp.Size = req.statbuf.st_size;
+    stamp.MTime =
+      static_cast<std::int64_t>(req.statbuf.st_mtim.tv_sec) * NsPerS +
+      req.statbuf.st_mtim.tv_nsec;
+    stamp.Device = req.statbuf.st_dev;
+    stamp.Inode = req.statbuf.st_ino;
+  }
+  uv_fs_req_cleanup(&req);
+#else
+  cmFileTime mtime;
+  stamp.Exists = mtime.Load(path);
+  if (stamp.Exists) {
+    stamp.Regular = !cmSystemTools::FileIsDirectory(path);
+    stamp.Size = cmSystemTools::FileLength(path);
+    stamp.MTime = mtime.GetNS();
+  }
+#endif
+  return stamp;
+}
+
+std::int64_t cmBinaryCacheFile::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::system_clock::now().time_since_epoch())
+    .count();
+}
+
+bool cmBinaryCacheFile::IsSettled(Stamp const& stamp, std::int64_t now)
+{
+  return !stamp.Exists || stamp.MTime + NsPerS <= now;
+}
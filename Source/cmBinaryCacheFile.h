@@ -0,0 +1,164 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmBinaryCacheFile_h
+#define cmBinaryCacheFile_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <cm/string_view>
+
+/** \class cmBinaryCacheWriter
+ * \brief Append fixed-size values and length-prefixed strings to a
+ *        buffer in the layout read by cmBinaryCacheReader.
+ */
+class cmBinaryCacheWriter
+{
+public:
+  explicit cmBinaryCacheWriter(std::string& out)
+    : Out(out)
+  {
+  }
+
+  template <typename T>
+  void Put(T value)
+  {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    this->Out.append(bytes, sizeof(T));
+  }
+
+  void PutString(cm::string_view s)
+  {
+    this->Put(static_cast<std::uint32_t>(s.size()));
+    this->Out.append(s.data(), s.size());
+  }
+
+private:
+  std::string& Out;
+};
+
+/** \class cmBinaryCacheReader
+ * \brief Consume the values written by cmBinaryCacheWriter from a
+ *        buffer.  Every method returns false if the buffer is too short.
+ */
+class cmBinaryCacheReader
+{
+public:
+  explicit cmBinaryCacheReader(cm::string_view in)
+    : In(in)
+  {
+  }
+
+  bool AtEnd() const { return this->In.empty(); }
+
+  template <typename T>
+  bool Get(T& value)
+  {
+    if (this->In.size() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, this->In.data(), sizeof(T));
+    this->In.remove_prefix(sizeof(T));
+    return true;
+  }
+
+  bool GetView(cm::string_view& s, std::uint64_t size)
+  {
+    if (this->In.size() < size) {
+      return false;
+    }
+    s = this->In.substr(0, static_cast<size_t>(size));
+    this->In.remove_prefix(static_cast<size_t>(size));
+    return true;
+  }
+
+  bool GetString(cm::string_view& s)
+  {
+    std::uint32_t size;
+    return this->Get(size) && this->GetView(s, size);
+  }
+
+  bool GetString(std::string& s)
+  {
+    cm::string_view view;
+    if (!this->GetString(view)) {
+      return false;
+    }
+    s.assign(view.data(), view.size());
+    return true;
+  }
+
+private:
+  cm::string_view In;
+};
+
+/** \class cmBinaryCacheFile
+ * \brief Read, write, and validate the binary cache files of CMake.
+ *
+ * A cache file starts with an 8 byte magic naming the kind of cache,
+ * whose last byte is bumped whenever its record layout changes,
+ * followed by the version of CMake that wrote it.  Files of another
+ * kind, layout, or version of CMake are ignored.
+ *
+ * Cache entries are validated against stamps of the files they depend
+ * on.  A file modified within a second before it is stamped may be
+ * modified again without its time stamp changing on file systems with
+ * coarse time stamps, so such stamps must not be trusted.
+ */
+class cmBinaryCacheFile
+{
+public:
+  using Magic = char[8];
+
+  /** The state of a path on disk.  Times are nanoseconds since the
+      epoch, comparable with Now().  Regular is true for regular files,
+      as opposed to directories and special files.  */
+  struct Stamp
+  {
+    bool Exists = false;
+    bool Regular = false;
+    std::uint64_t Size = 0;
+    std::int64_t MTime = 0;
+    std::uint64_t Device = 0;
+    std::uint64_t Inode = 0;
+
+    bool operator==(Stamp const& other) const
+    {
+      return this->Exists == other.Exists && this->Size == other.Size &&
+        this->MTime == other.MTime;
+    }
+    bool operator!=(Stamp const& other) const { return !(*this == other); }
+  };
+
+  /** Read the cache file into the buffer and return the part following
+      the header in the payload.  Return false if the file is missing,
+      empty, or was not written by this version of CMake with the given
+      magic.  */
+  static bool Read(std::string const& path, Magic const& magic,
+                   std::string& buffer, cm::string_view& payload);
+
+  /** Start a cache file buffer with the header for the given magic.  */
+  static void WriteHeader(std::string& out, Magic const& magic);
+
+  /** Replace the cache file with the given content.  The content is
+      written to a temporary file of this process first and renamed into
+      place, so readers and concurrent writers never see a truncated
+      file.  */
+  static bool Write(std::string const& path, cm::string_view content);
+
+  /** Stamp the given path.  Symbolic links are followed.  */
+  static Stamp StampPath(std::string const& path);
+
+  /** Current time, comparable with Stamp::MTime.  */
+  static std::int64_t Now();
+
+  /** Return true if a stamp taken at the given time can be trusted to
+      change whenever the path changes.  */
+  static bool IsSettled(Stamp const& stamp, std::int64_t now);
+};
+
+#endif
@@ -0,0 +1,100 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmCMakeCheckBatchCommand.h"
+
+#include <climits>
+#include <utility>
+
+#include "cmsys/SystemInformation.hxx"
+
+#include "cmGlobalGenerator.h"
+#include "cmMakefile.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+#include "cmTryCompileBatch.h"
+
+class cmExecutionStatus;
+
+namespace {
+bool ParseJobs(std::string const& value, int& jobs)
+{
+  unsigned long n;
+  if (!cmStrToULong(value, &n) || n == 0 || n > INT_MAX) {
+    return false;
+  }
+  jobs = static_cast<int>(n);
+  return true;
+}
+}
+
+// cmCMakeCheckBatchCommand
+bool cmCMakeCheckBatchCommand::InitialPass(
+  std::vector<std::string> const& args, cmExecutionStatus&)
+{
+  if (args.empty()) {
+    this->SetError("called with incorrect number of arguments");
+    return false;
+  }
+
+  if (args[0] == "END") {
+    if (args.size() != 1) {
+      this->SetError("END does not accept any arguments.");
+      return false;
+    }
+    std::unique_ptr<cmTryCompileBatch> batch =
+      this->Makefile->TakeTryCompileBatch();
+    if (!batch) {
+      this->SetError("END given without a matching BEGIN.");
+      return false;
+    }
+    this->BuildBatch(*batch);
+    return true;
+  }
+
+  if (args[0] != "BEGIN") {
+    this->SetError(cmStrCat("given unknown argument \"", args[0], "\"."));
+    return false;
+  }
+  if (this->Makefile->GetTryCompileBatch()) {
+    this->SetError("BEGIN given while a batch is already open.");
+    return false;
+  }
+
+  auto batch = cm::make_unique<cmTryCompileBatch>();
+  batch->Jobs = 0;
+  for (size_t i = 1; i < args.size(); ++i) {
+    if (args[i] == "PARALLEL_LEVEL" && i + 1 < args.size()) {
+      if (!ParseJobs(args[++i], batch->Jobs)) {
+        this->SetError(cmStrCat("PARALLEL_LEVEL given invalid value \"",
+                                args[i], "\"."));
+        return false;
+      }
+    } else {
+      this->SetError(cmStrCat("given unknown argument \"", args[i], "\"."));
+      return false;
+    }
+  }
+
+  // Default to the parallel level of "cmake --build".
+  std::string parallel;
+  if (batch->Jobs == 0 &&
+      cmSystemTools::GetEnv("CMAKE_BUILD_PARALLEL_LEVEL", parallel)) {
+    ParseJobs(parallel, batch->Jobs);
+  }
+  if (batch->Jobs == 0) {
+    cmsys::SystemInformation info;
+    info.RunCPUCheck();
+    batch->Jobs = static_cast<int>(info.GetNumberOfLogicalCPU());
+    if (batch->Jobs < 1) {
+      batch->Jobs = 1;
+    }
+  }
+
+  // Generators that cannot build the checks together run them right
+  // away as if no batch was open.
+  batch->Enabled =
+    this->Makefile->GetGlobalGenerator()->GetKeepGoingOptions(
+      batch->NativeOptions);
+  this->Makefile->SetTryCompileBatch(std::move(batch));
+  return true;
+}
@@ -0,0 +1,44 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmCMakeCheckBatchCommand_h
+#define cmCMakeCheckBatchCommand_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <string>
+#include <vector>
+
+#include <cm/memory>
+
+#include "cmCommand.h"
+#include "cmCoreTryCompile.h"
+
+class cmExecutionStatus;
+
+/** \class cmCMakeCheckBatchCommand
+ * \brief Build the checks declared between BEGIN and END together
+ *
+ * cmCMakeCheckBatchCommand defers the try_compile calls of the check
+ * modules until the batch ends and then builds all of them in one
+ * test project.
+ */
+class cmCMakeCheckBatchCommand : public cmCoreTryCompile
+{
+public:
+  /**
+   * This is a virtual constructor for the command.
+   */
+  std::unique_ptr<cmCommand> Clone() override
+  {
+    return cm::make_unique<cmCMakeCheckBatchCommand>();
+  }
+
+  /**
+   * This is called when the command is first encountered in
+   * the CMakeLists.txt file.
+   */
+  bool InitialPass(std::vector<std::string> const& args,
+                   cmExecutionStatus& status) override;
+};
+
+#endif
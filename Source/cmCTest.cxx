@@ -87,6 +87,11 @@ struct cmCTest::Private
   cmCTest::Rerun RerunMode = cmCTest::Rerun::Never;
   std::string ConfigType;
   std::string ScheduleType;
+  bool ScheduleReport = false;
+  int ShardIndex = -1;
+  int ShardCount = 0;
+  int ShardWorkers = 0;
+  bool ShardWorkerMode = false;
   std::chrono::system_clock::time_point StopTime;
   bool TestProgressOutput = false;
   bool Verbose = false;
@@ -1906,6 +1911,52 @@ bool cmCTest::HandleCommandLineArguments(size_t& i,
     }
   }
 
+  if (this->CheckArgument(arg, "--shard-index")) {
+    if (i >= args.size() - 1) {
+      errormsg = "'--shard-index' requires an argument";
+      return false;
+    }
+    i++;
+    long index = -1;
+    if (!cmStrToLong(args[i], &index) || index < 0) {
+      errormsg = "'--shard-index' given invalid value '" + args[i] + "'";
+      return false;
+    }
+    this->Impl->ShardIndex = static_cast<int>(index);
+  }
+
+  if (this->CheckArgument(arg, "--shard-count")) {
+    if (i >= args.size() - 1) {
+      errormsg = "'--shard-count' requires an argument";
+      return false;
+    }
+    i++;
+    long count = 0;
+    if (!cmStrToLong(args[i], &count) || count < 1) {
+      errormsg = "'--shard-count' given invalid value '" + args[i] + "'";
+      return false;
+    }
+    this->Impl->ShardCount = static_cast<int>(count);
+  }
+
+  if (this->CheckArgument(arg, "--shard-workers")) {
+    if (i >= args.size() - 1) {
+      errormsg = "'--shard-workers' requires an argument";
+      return false;
+    }
+    i++;
+    long workers = 0;
+    if (!cmStrToLong(args[i], &workers) || workers < 1) {
+      errormsg = "'--shard-workers' given invalid value '" + args[i] + "'";
+      return false;
+    }
+    this->Impl->ShardWorkers = static_cast<int>(workers);
+  }
+
+  if (this->CheckArgument(arg, "--shard-worker")) {
+    this->Impl->ShardWorkerMode = true;
+  }
+
   if (this->CheckArgument(arg, "--test-load") && i < args.size() - 1) {
     i++;
     unsigned long load;
@@ -2324,6 +2375,11 @@ int cmCTest::Run(std::vector<std::string>& args, std::string* output)
       this->Impl->ScheduleType = "Random";
     }
 
+    // --schedule-report
+    if (this->CheckArgument(arg, "--schedule-report")) {
+      this->Impl->ScheduleReport = true;
+    }
+
     // pass the argument to all the handlers as well, but i may no longer be
     // set to what it was originally so I'm not sure this is working as
     // intended
@@ -2336,6 +2392,22 @@ int cmCTest::Run(std::vector<std::string>& args, std::string* output)
     }
   } // the close of the for argument loop
 
+  if ((this->Impl->ShardIndex >= 0) != (this->Impl->ShardCount > 0)) {
+    cmSystemTools::Error(
+      "'--shard-index' and '--shard-count' must be given together.");
+    return 1;
+  }
+  if (this->Impl->ShardIndex >= this->Impl->ShardCount) {
+    cmSystemTools::Error("'--shard-index' must be less than '--shard-count'.");
+    return 1;
+  }
+  if (this->Impl->ShardWorkers > 0 &&
+      (this->Impl->ShardCount > 0 || this->Impl->RunConfigurationScript)) {
+    cmSystemTools::Error("'--shard-workers' may not be used with "
+                         "'--shard-count' or a dashboard script.");
+    return 1;
+  }
+
   // handle CTEST_PARALLEL_LEVEL environment variable
   if (!this->Impl->ParallelLevelSetInCli) {
     std::string parallel;
@@ -2554,6 +2626,31 @@ void cmCTest::SetScheduleType(std::string const& type)
   this->Impl->ScheduleType = type;
 }
 
+bool cmCTest::GetScheduleReport() const
+{
+  return this->Impl->ScheduleReport;
+}
+
+int cmCTest::GetShardIndex() const
+{
+  return this->Impl->ShardIndex;
+}
+
+int cmCTest::GetShardCount() const
+{
+  return this->Impl->ShardCount;
+}
+
+int cmCTest::GetShardWorkers() const
+{
+  return this->Impl->ShardWorkers;
+}
+
+bool cmCTest::GetShardWorkerMode() const
+{
+  return this->Impl->ShardWorkerMode;
+}
+
 int cmCTest::ReadCustomConfigurationFileTree(const char* dir, cmMakefile* mf)
 {
   bool found = false;
@@ -208,6 +208,23 @@ public:
   std::string GetScheduleType() const;
   void SetScheduleType(std::string const& type);
 
+  /** Whether to report the predicted and actual duration of the
+      parallel test schedule.  */
+  bool GetScheduleReport() const;
+
+  /** The shard of the tests to run when they are split into
+      --shard-count shards, or -1 to run all tests.  */
+  int GetShardIndex() const;
+  int GetShardCount() const;
+
+  /** The number of local ctest processes among which to split the
+      tests, or 0 to run them all in this process.  */
+  int GetShardWorkers() const;
+
+  /** Whether this process runs a shard for a --shard-workers
+      coordinator and reports its results to it.  */
+  bool GetShardWorkerMode() const;
+
   /** The max output width */
   int GetMaxTestNameWidth() const;
   void SetMaxTestNameWidth(int w);
@@ -3,25 +3,35 @@
 #include "cmCoreTryCompile.h"
 
 #include <cstdio>
+#include <algorithm>
 #include <cstring>
+#include <limits>
 #include <set>
 #include <sstream>
 #include <utility>
 
 #include "cmsys/Directory.hxx"
+#include "cmsys/FStream.hxx"
+#include "cmsys/RegularExpression.hxx"
 
 #include "cm_static_string_view.hxx"
 
+#include "cmAlgorithms.h"
+#include "cmDirectoryListingCache.h"
+#include "cmExecutionStatus.h"
 #include "cmExportTryCompileFileGenerator.h"
 #include "cmGlobalGenerator.h"
+#include "cmListFileCache.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmOutputConverter.h"
 #include "cmPolicies.h"
+#include "cmRange.h"
 #include "cmState.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmTarget.h"
+#include "cmTryCompileBatch.h"
 #include "cmVersion.h"
 #include "cmake.h"
 
@@ -71,6 +81,12 @@ static std::set<std::string> ghs_platform_vars{
   "GHS_OS_DIR_OPTION"
 };
 
+/* Variables the test project reads that a check may set in CMAKE_FLAGS */
+static std::set<std::string> const checkVariables{
+  "COMPILE_DEFINITIONS", "EXE_LINKER_FLAGS", "INCLUDE_DIRECTORIES",
+  "LINK_DIRECTORIES", "LINK_LIBRARIES"
+};
+
 static void writeProperty(FILE* fout, std::string const& targetName,
                           std::string const& prop, std::string const& value)
 {
@@ -95,6 +111,11 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
 {
   this->BinaryDirectory = argv[1];
   this->OutputFile.clear();
+  this->Deferred = false;
+  this->CacheKey.clear();
+  this->CachePaths.clear();
+  this->CacheHit = false;
+  this->CachedResult = cmTryCompileResultCache::Result();
   // which signature were we called with ?
   this->SrcFileSignature = true;
 
@@ -146,6 +167,7 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
   std::string cudaExtensions;
   std::vector<std::string> targets;
   std::vector<std::string> linkOptions;
+  std::vector<std::string> linkLibraries;
   std::string libsToLink = " ";
   bool useOldLinkLibs = true;
   char targetNameBuf[64];
@@ -163,6 +185,7 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
   bool didCudaExtensions = false;
   bool useSources = argv[2] == "SOURCES";
   std::vector<std::string> sources;
+  std::vector<std::string> finish;
 
   enum Doing
   {
@@ -235,6 +258,27 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
       didCudaExtensions = true;
     } else if (argv[i] == "__CMAKE_INTERNAL") {
       doing = DoingCMakeInternal;
+    } else if (argv[i] == "__CMAKE_FINISH" && !isTryRun) {
+      // The remaining arguments name a command to call, and its
+      // arguments, once the result is known.  This lets the check
+      // modules shipped with CMake be deferred to the end of a
+      // cmake_check_batch(), and is not available to projects.
+      if (!cmSystemTools::IsSubDirectory(
+            this->Makefile->GetExecutionContext().FilePath,
+            cmSystemTools::GetCMakeRoot() + "/Modules")) {
+        this->Makefile->IssueMessage(
+          MessageType::FATAL_ERROR,
+          "__CMAKE_FINISH is reserved for the modules shipped with CMake");
+        return -1;
+      }
+      finish.assign(argv.begin() + i + 1, argv.end());
+      if (finish.empty()) {
+        this->Makefile->IssueMessage(
+          MessageType::FATAL_ERROR,
+          "__CMAKE_FINISH must be followed by a command name");
+        return -1;
+      }
+      break;
     } else if (doing == DoingCMakeFlags) {
       cmakeFlags.push_back(argv[i]);
     } else if (doing == DoingCompileDefinitions) {
@@ -243,6 +287,7 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
       linkOptions.push_back(argv[i]);
     } else if (doing == DoingLinkLibraries) {
       libsToLink += "\"" + cmTrimWhitespace(argv[i]) + "\" ";
+      linkLibraries.push_back(argv[i]);
       if (cmTarget* tgt = this->Makefile->FindTargetToUse(argv[i])) {
         switch (tgt->GetType()) {
           case cmStateEnums::SHARED_LIBRARY:
@@ -412,9 +457,28 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     return -1;
   }
 
+  // A check that knows how to finish itself may be deferred to the end
+  // of the batch it is declared in.  Checks copying their output file
+  // or running it need the result right away.
+  cmTryCompileBatch* batch = this->Makefile->GetTryCompileBatch();
+  if (batch &&
+      (!batch->Enabled || finish.empty() || !this->SrcFileSignature ||
+       !copyFile.empty() || !cmakeInternal.empty())) {
+    batch = nullptr;
+  }
+
   // compute the binary dir when TRY_COMPILE is called with a src file
   // signature
-  if (this->SrcFileSignature) {
+  if (batch) {
+    /* Each deferred check gets a directory of its own, named after its
+       target, whose names must be unique within the batch.  */
+    do {
+      sprintf(targetNameBuf, "cmTC_%05x",
+              cmSystemTools::RandomSeed() & 0xFFFFF);
+    } while (!batch->TargetNames.insert(targetNameBuf).second);
+    targetName = targetNameBuf;
+    this->BinaryDirectory += "/CMakeFiles/CMakeTmpBatch/" + targetName;
+  } else if (this->SrcFileSignature) {
     this->BinaryDirectory += "/CMakeFiles/CMakeTmp";
   } else {
     // only valid for srcfile signatures
@@ -455,6 +519,27 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
       sources.push_back(argv[2]);
     }
 
+    if (batch) {
+      // Temporary sources may be overwritten by the next check before
+      // the batch is built, so the check keeps copies of them.
+      for (std::string& si : sources) {
+        if (si.find("CMakeTmp") == std::string::npos) {
+          continue;
+        }
+        std::string const copy = cmStrCat(
+          this->BinaryDirectory, '/', cmSystemTools::GetFilenameName(si));
+        if (!cmSystemTools::CopyFileAlways(si, copy)) {
+          this->Makefile->IssueMessage(
+            MessageType::FATAL_ERROR,
+            cmStrCat("Cannot copy source file\n  ", si, "\nto\n  ", copy,
+                     "\n", cmSystemTools::GetLastSystemError()));
+          return -1;
+        }
+        si = copy;
+      }
+      cmSystemTools::RemoveFile(this->BinaryDirectory + "/output.log");
+    }
+
     // Detect languages to enable.
     cmGlobalGenerator* gg = this->Makefile->GetGlobalGenerator();
     std::set<std::string> testLangs;
@@ -498,19 +583,20 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
       return -1;
     }
 
+    // The code to run before the project() command.  A batch writes it
+    // once for all checks sharing the same test project.
+    std::string projectHeader;
     const char* def = this->Makefile->GetDefinition("CMAKE_MODULE_PATH");
-    fprintf(fout, "cmake_minimum_required(VERSION %u.%u.%u.%u)\n",
-            cmVersion::GetMajorVersion(), cmVersion::GetMinorVersion(),
-            cmVersion::GetPatchVersion(), cmVersion::GetTweakVersion());
     if (def) {
-      fprintf(fout, "set(CMAKE_MODULE_PATH \"%s\")\n", def);
+      projectHeader += cmStrCat("set(CMAKE_MODULE_PATH \"", def, "\")\n");
     }
 
     /* Set MSVC runtime library policy to match our selection.  */
     if (const char* msvcRuntimeLibraryDefault =
           this->Makefile->GetDefinition(kCMAKE_MSVC_RUNTIME_LIBRARY_DEFAULT)) {
-      fprintf(fout, "cmake_policy(SET CMP0091 %s)\n",
-              *msvcRuntimeLibraryDefault ? "NEW" : "OLD");
+      projectHeader +=
+        cmStrCat("cmake_policy(SET CMP0091 ",
+                 *msvcRuntimeLibraryDefault ? "NEW" : "OLD", ")\n");
     }
 
     std::string projectLangs;
@@ -520,15 +606,46 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
       std::string rulesOverrideLang = cmStrCat(rulesOverrideBase, "_", li);
       if (const char* rulesOverridePath =
             this->Makefile->GetDefinition(rulesOverrideLang)) {
-        fprintf(fout, "set(%s \"%s\")\n", rulesOverrideLang.c_str(),
-                rulesOverridePath);
+        projectHeader += cmStrCat("set(", rulesOverrideLang, " \"",
+                                  rulesOverridePath, "\")\n");
       } else if (const char* rulesOverridePath2 =
                    this->Makefile->GetDefinition(rulesOverrideBase)) {
-        fprintf(fout, "set(%s \"%s\")\n", rulesOverrideBase.c_str(),
-                rulesOverridePath2);
+        projectHeader += cmStrCat("set(", rulesOverrideBase, " \"",
+                                  rulesOverridePath2, "\")\n");
       }
     }
-    fprintf(fout, "project(CMAKE_TRY_COMPILE%s)\n", projectLangs.c_str());
+    // The flags moved into the code of a batched check.
+    std::vector<std::string> checkFlags;
+    if (batch) {
+      // The variables the test project reads by name are set in the
+      // directory of the check so that checks differing only in them
+      // can share a test project.
+      std::vector<std::string> projectFlags;
+      for (std::string const& flag : cmakeFlags) {
+        std::string var;
+        std::string value;
+        cmStateEnums::CacheEntryType type;
+        if (cmHasLiteralPrefix(flag, "-D") &&
+            cmState::ParseCacheEntry(flag.substr(2), var, value, type) &&
+            checkVariables.count(var)) {
+          fprintf(fout, "set(%s %s)\n", var.c_str(),
+                  cmOutputConverter::EscapeForCMake(value).c_str());
+          checkFlags.push_back(flag);
+        } else {
+          projectFlags.push_back(flag);
+        }
+      }
+      cmakeFlags = std::move(projectFlags);
+    } else {
+      fprintf(fout, "cmake_minimum_required(VERSION %u.%u.%u.%u)\n",
+              cmVersion::GetMajorVersion(), cmVersion::GetMinorVersion(),
+              cmVersion::GetPatchVersion(), cmVersion::GetTweakVersion());
+      fputs(projectHeader.c_str(), fout);
+      fprintf(fout, "project(CMAKE_TRY_COMPILE%s)\n", projectLangs.c_str());
+    }
+    // The code following the project() command is the same for batched
+    // checks.
+    long const bodyStart = ftell(fout);
     if (cmakeInternal == "ABI") {
       // This is the ABI detection step, also used for implicit includes.
       // Erase any include_directories() calls from the toolchain file so
@@ -636,8 +753,11 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
 
     /* Use a random file name to avoid rapid creation and deletion
        of the same executable name (some filesystems fail on that).  */
-    sprintf(targetNameBuf, "cmTC_%05x", cmSystemTools::RandomSeed() & 0xFFFFF);
-    targetName = targetNameBuf;
+    if (!batch) {
+      sprintf(targetNameBuf, "cmTC_%05x",
+              cmSystemTools::RandomSeed() & 0xFFFFF);
+      targetName = targetNameBuf;
+    }
 
     if (!targets.empty()) {
       std::string fname = "/" + std::string(targetName) + "Targets.cmake";
@@ -904,7 +1024,89 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
       fprintf(fout, "target_link_libraries(%s %s)\n", targetName.c_str(),
               libsToLink.c_str());
     }
+    long const bodyEnd = ftell(fout);
+
+    if (batch) {
+      // Log the output of the commands building this check alone.  The
+      // output of the batch build interleaves all of them.
+      std::string const launcher =
+        cmStrCat('"', cmSystemTools::GetCMakeCommand(),
+                 "\" -E __run_and_log \"", this->BinaryDirectory,
+                 "/output.log\" --");
+      writeProperty(fout, targetName, "RULE_LAUNCH_COMPILE", launcher);
+      writeProperty(fout, targetName, "RULE_LAUNCH_LINK", launcher);
+    }
     fclose(fout);
+
+#if !defined(CMAKE_BOOTSTRAP)
+    // Look for the result of an identical check.  Checks whose output
+    // file is used, and checks detecting the compiler, are built.
+    cmTryCompileResultCache* cache =
+      this->Makefile->GetCMakeInstance()->GetTryCompileResultCache();
+    if (cache && copyFile.empty() && cmakeInternal.empty() &&
+        targets.empty() && (!isTryRun || !this->RunKey.empty()) &&
+        !this->Makefile->GetState()->UseGhsMultiIDE()) {
+      std::string body;
+      {
+        cmsys::ifstream fin(outFileName.c_str(),
+                            std::ios::in | std::ios::binary);
+        std::ostringstream content;
+        content << fin.rdbuf();
+        body = content.str();
+      }
+      if (bodyStart >= 0 && bodyEnd >= bodyStart &&
+          body.size() >= static_cast<size_t>(bodyEnd)) {
+        body = body.substr(bodyStart, bodyEnd - bodyStart);
+        cmAppend(checkFlags, cmakeFlags);
+        this->ComputeCacheKey(body, projectHeader, testLangs,
+                              std::move(checkFlags), sources, linkLibraries,
+                              targetName, isTryRun);
+      }
+      if (!this->CacheKey.empty() &&
+          cache->Lookup(this->CacheKey, this->CachedResult)) {
+        this->CacheHit = true;
+      }
+    }
+
+    if (batch && this->CacheHit) {
+      // The check is not added to the batch.
+      if (!this->Makefile->GetCMakeInstance()->GetDebugTryCompile()) {
+        this->CleanupFiles(this->BinaryDirectory);
+        cmSystemTools::RemoveADirectory(this->BinaryDirectory);
+      }
+      batch = nullptr;
+    }
+#endif
+
+    if (batch) {
+      cmTryCompileBatch::Check check;
+      check.ResultVariable = argv[0];
+      check.OutputVariable = outputVariable;
+      check.Directory = this->BinaryDirectory;
+      check.TargetName = targetName;
+      check.TargetType = targetType;
+      check.Finish = std::move(finish);
+      check.CacheKey = std::move(this->CacheKey);
+      check.CachePaths = std::move(this->CachePaths);
+
+      // Checks with the same project settings share a test project.
+      std::string const key =
+        cmStrCat(argv[1], '\n', projectHeader, '\n', cmJoin(cmakeFlags, "\n"));
+      auto pi = batch->ProjectIndex.find(key);
+      if (pi == batch->ProjectIndex.end()) {
+        pi = batch->ProjectIndex.emplace(key, batch->Projects.size()).first;
+        batch->Projects.emplace_back();
+        cmTryCompileBatch::Project& project = batch->Projects.back();
+        project.BinaryDirectory = argv[1];
+        project.Header = projectHeader;
+        project.CMakeFlags = cmakeFlags;
+      }
+      cmTryCompileBatch::Project& project = batch->Projects[pi->second];
+      project.Languages.insert(testLangs.begin(), testLangs.end());
+      project.Checks.push_back(std::move(check));
+      this->Deferred = true;
+      return 0;
+    }
     projectName = "CMAKE_TRY_COMPILE";
   }
 
@@ -918,16 +1120,35 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     }
   }
 
-  bool erroroc = cmSystemTools::GetErrorOccuredFlag();
-  cmSystemTools::ResetErrorOccuredFlag();
+  int res;
   std::string output;
-  // actually do the try compile now that everything is setup
-  int res = this->Makefile->TryCompile(
-    sourceDirectory, this->BinaryDirectory, projectName, targetName,
-    this->SrcFileSignature, cmake::NO_BUILD_PARALLEL_LEVEL, &cmakeFlags,
-    output);
-  if (erroroc) {
-    cmSystemTools::SetErrorOccured();
+  if (this->CacheHit) {
+    res = this->CachedResult.Compiled ? 0 : 1;
+    output = cmStrCat("Result taken from the try_compile result cache.  "
+                      "The output of the identical check it was built "
+                      "for was:\n",
+                      this->CachedResult.Output);
+  } else {
+    bool erroroc = cmSystemTools::GetErrorOccuredFlag();
+    cmSystemTools::ResetErrorOccuredFlag();
+    // actually do the try compile now that everything is setup
+    std::vector<std::string> targetNames;
+    if (!targetName.empty()) {
+      targetNames.push_back(targetName);
+    }
+    res = this->Makefile->TryCompile(
+      sourceDirectory, this->BinaryDirectory, projectName, targetNames,
+      this->SrcFileSignature, cmake::NO_BUILD_PARALLEL_LEVEL, &cmakeFlags,
+      output);
+    if (erroroc) {
+      cmSystemTools::SetErrorOccured();
+    }
+    this->CachedResult.Compiled = res == 0;
+    this->CachedResult.Output = output;
+    // try_run adds the result of running the executable first.
+    if (!isTryRun) {
+      this->StoreCachedResult();
+    }
   }
 
   // set the result var to the return value to indicate success or failure
@@ -944,6 +1165,9 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     this->FindOutputFile(targetName, targetType);
 
     if ((res == 0) && !copyFile.empty()) {
+      this->Makefile->GetCMakeInstance()
+        ->GetDirectoryListingCache()
+        ->Invalidate(copyFile);
       if (this->OutputFile.empty() ||
           !cmSystemTools::CopyFileAlways(this->OutputFile, copyFile)) {
         std::ostringstream emsg;
@@ -968,9 +1192,373 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
       this->Makefile->AddDefinition(copyFileError, copyFileErrorMessage);
     }
   }
+
+  if (!finish.empty()) {
+    this->FinishCheck(finish);
+  }
   return res;
 }
 
+bool cmCoreTryCompile::BuildBatch(cmTryCompileBatch& batch)
+{
+  for (size_t pi = 0; pi < batch.Projects.size(); ++pi) {
+    cmTryCompileBatch::Project const& project = batch.Projects[pi];
+    if (!this->BuildBatchProject(
+          batch, project,
+          cmStrCat(project.BinaryDirectory, "/CMakeFiles/CMakeTmpBatch/Project",
+                   pi))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool cmCoreTryCompile::BuildBatchProject(
+  cmTryCompileBatch const& batch, cmTryCompileBatch::Project const& project,
+  std::string const& projectDir)
+{
+  bool const debug = this->Makefile->GetCMakeInstance()->GetDebugTryCompile();
+  cmSystemTools::MakeDirectory(projectDir);
+  cmSystemTools::RemoveFile(projectDir + "/CMakeCache.txt");
+
+  // The test project adds the directory of each check.
+  std::string const outFileName = projectDir + "/CMakeLists.txt";
+  FILE* fout = cmsys::SystemTools::Fopen(outFileName, "w");
+  if (!fout) {
+    std::ostringstream e;
+    /* clang-format off */
+    e << "Failed to open\n"
+      << "  " << outFileName << "\n"
+      << cmSystemTools::GetLastSystemError();
+    /* clang-format on */
+    this->Makefile->IssueMessage(MessageType::FATAL_ERROR, e.str());
+    return false;
+  }
+  fprintf(fout, "cmake_minimum_required(VERSION %u.%u.%u.%u)\n",
+          cmVersion::GetMajorVersion(), cmVersion::GetMinorVersion(),
+          cmVersion::GetPatchVersion(), cmVersion::GetTweakVersion());
+  fputs(project.Header.c_str(), fout);
+  fprintf(fout, "project(CMAKE_TRY_COMPILE %s)\n",
+          cmJoin(project.Languages, " ").c_str());
+  fprintf(fout, "set(CMAKE_SUPPRESS_REGENERATION 1)\n");
+  std::vector<std::string> targetNames;
+  for (cmTryCompileBatch::Check const& check : project.Checks) {
+    fprintf(fout, "add_subdirectory(\"%s\" %s)\n", check.Directory.c_str(),
+            check.TargetName.c_str());
+    targetNames.push_back(check.TargetName);
+  }
+  fclose(fout);
+
+  // Build all checks with one invocation of the native build tool,
+  // which keeps going after the checks that fail.
+  bool erroroc = cmSystemTools::GetErrorOccuredFlag();
+  cmSystemTools::ResetErrorOccuredFlag();
+  std::string output;
+  bool configureFailed = false;
+  this->Makefile->TryCompile(
+    projectDir, projectDir, "CMAKE_TRY_COMPILE", targetNames, true,
+    batch.Jobs, &project.CMakeFlags, output, batch.NativeOptions,
+    project.Checks.size() > 1 ? &configureFailed : nullptr);
+  if (configureFailed && !cmSystemTools::GetInterruptFlag()) {
+    // A single check can break the test project shared by all.  Build
+    // each of them in a project of its own, as without a batch, so
+    // that only the checks that fail by themselves fail.
+    cmSystemTools::ResetErrorOccuredFlag();
+    if (erroroc) {
+      cmSystemTools::SetErrorOccured();
+    }
+    this->Makefile->DisplayStatus(
+      cmStrCat("The test project of ", project.Checks.size(),
+               " batched checks failed to configure; building them "
+               "one by one"),
+      -1);
+    if (!debug) {
+      this->CleanupFiles(projectDir);
+      cmSystemTools::RemoveADirectory(projectDir);
+    }
+    for (size_t ci = 0; ci < project.Checks.size(); ++ci) {
+      cmTryCompileBatch::Project alone;
+      alone.BinaryDirectory = project.BinaryDirectory;
+      alone.Header = project.Header;
+      alone.Languages = project.Languages;
+      alone.CMakeFlags = project.CMakeFlags;
+      alone.Checks.push_back(project.Checks[ci]);
+      if (!this->BuildBatchProject(batch, alone,
+                                   cmStrCat(projectDir, '-', ci))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (erroroc) {
+    cmSystemTools::SetErrorOccured();
+  }
+  if (cmSystemTools::GetFatalErrorOccured()) {
+    return false;
+  }
+
+  for (cmTryCompileBatch::Check const& check : project.Checks) {
+    // A check succeeded if its output file was built.
+    this->BinaryDirectory = check.Directory;
+    this->FindOutputFile(check.TargetName, check.TargetType);
+    bool const compiled = !this->OutputFile.empty();
+    this->Makefile->AddCacheDefinition(check.ResultVariable,
+                                       (compiled ? "TRUE" : "FALSE"),
+                                       "Result of TRY_COMPILE",
+                                       cmStateEnums::INTERNAL);
+
+    if (!check.OutputVariable.empty()) {
+      std::ostringstream checkOutput;
+      checkOutput << "Change Dir: " << projectDir << "\n\n"
+                  << "Built target " << check.TargetName << " in a batch of "
+                  << project.Checks.size() << " checks:\n";
+      cmsys::ifstream fin((check.Directory + "/output.log").c_str());
+      if (fin && fin.peek() != std::char_traits<char>::eof()) {
+        checkOutput << fin.rdbuf();
+      } else if (!compiled) {
+        // Nothing was built for the check.  The reason must be in
+        // the output of the whole batch.
+        checkOutput << output;
+      }
+      this->Makefile->AddDefinition(check.OutputVariable, checkOutput.str());
+    }
+
+    this->CacheKey = check.CacheKey;
+    this->CachePaths = check.CachePaths;
+    this->CachedResult.Compiled = compiled;
+    this->CachedResult.Output = output;
+    {
+      cmsys::ifstream fin((check.Directory + "/output.log").c_str());
+      if (fin) {
+        std::ostringstream log;
+        log << fin.rdbuf();
+        this->CachedResult.Output = log.str();
+      }
+    }
+    this->StoreCachedResult();
+
+    this->FinishCheck(check.Finish);
+  }
+
+  if (!debug) {
+    for (cmTryCompileBatch::Check const& check : project.Checks) {
+      this->CleanupFiles(check.Directory);
+      cmSystemTools::RemoveADirectory(check.Directory);
+    }
+    this->CleanupFiles(projectDir);
+    cmSystemTools::RemoveADirectory(projectDir);
+  }
+  return true;
+}
+
+void cmCoreTryCompile::FinishCheck(std::vector<std::string> const& finish)
+{
+  // Pass bracket arguments so that the values are not evaluated again.
+  auto const fakeLineNo =
+    std::numeric_limits<decltype(cmListFileArgument::Line)>::max();
+  cmListFileFunction func;
+  func.Name = finish.front();
+  func.Line = fakeLineNo;
+  for (std::string const& arg : cmMakeRange(finish).advance(1)) {
+    func.Arguments.emplace_back(arg, cmListFileArgument::Bracket, fakeLineNo);
+  }
+  cmExecutionStatus status(*this->Makefile);
+  this->Makefile->ExecuteCommand(func, status);
+}
+
+void cmCoreTryCompile::StoreCachedResult()
+{
+#if !defined(CMAKE_BOOTSTRAP)
+  cmTryCompileResultCache* cache =
+    this->Makefile->GetCMakeInstance()->GetTryCompileResultCache();
+  // A check interrupted by an error has no result to reuse.
+  if (cache && !this->CacheKey.empty() &&
+      !cmSystemTools::GetFatalErrorOccured()) {
+    cache->Store(this->CacheKey, this->CachedResult, this->CachePaths);
+  }
+#endif
+}
+
+#if !defined(CMAKE_BOOTSTRAP)
+// Collect the directories of the header names included by a source,
+// e.g. "sys" for <sys/types.h>, and their parents.
+static void AddIncludedSubdirectories(std::string const& content,
+                                      std::set<std::string>& subdirs)
+{
+  cmsys::RegularExpression include(
+    "^[ \t]*#[ \t]*include[ \t]*[<\"]([^>\"]+)[>\"]");
+  std::istringstream lines(content);
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (include.find(line)) {
+      std::string dir = cmSystemTools::GetFilenamePath(include.match(1));
+      while (!dir.empty() && subdirs.insert(dir).second) {
+        dir = cmSystemTools::GetFilenamePath(dir);
+      }
+    }
+  }
+}
+
+void cmCoreTryCompile::ComputeCacheKey(
+  std::string const& body, std::string const& header,
+  std::set<std::string> const& testLangs, std::vector<std::string> flags,
+  std::vector<std::string> const& sources,
+  std::vector<std::string> const& linkLibraries,
+  std::string const& targetName, bool isTryRun)
+{
+  std::set<std::string> paths;
+  auto stampPaths = [&paths](std::string const& list) {
+    for (std::string const& path : cmExpandedList(list)) {
+      if (cmSystemTools::FileIsFullPath(path)) {
+        paths.insert(path);
+      }
+    }
+  };
+  // A header named with a path, like <sys/foo.h>, is looked up in a
+  // subdirectory of each include directory.  Such a subdirectory
+  // changes, or appears, without its include directory changing.
+  std::set<std::string> includeDirs;
+  std::set<std::string> includedSubdirs;
+  auto stampIncludeDirs = [&stampPaths, &includeDirs](std::string const& list) {
+    stampPaths(list);
+    for (std::string const& path : cmExpandedList(list)) {
+      if (cmSystemTools::FileIsFullPath(path)) {
+        includeDirs.insert(path);
+      }
+    }
+  };
+
+  // The test project is generated in a directory, and for a target,
+  // named differently each time.
+  auto normalize = [this, &targetName](std::string s) -> std::string {
+    cmSystemTools::ReplaceString(s, this->BinaryDirectory, "<BINARY_DIR>");
+    cmSystemTools::ReplaceString(s, targetName, "<TARGET>");
+    return s;
+  };
+
+  std::ostringstream key;
+  key << (isTryRun ? "try_run" : "try_compile") << '\n'
+      << this->RunKey << '\n'
+      << this->Makefile->GetGlobalGenerator()->GetName() << '\n'
+      << this->Makefile->GetSafeDefinition("CMAKE_GENERATOR_PLATFORM") << '\n'
+      << this->Makefile->GetSafeDefinition("CMAKE_GENERATOR_TOOLSET") << '\n'
+      << this->Makefile->GetSafeDefinition("CMAKE_TRY_COMPILE_CONFIGURATION")
+      << '\n'
+      << header << '\n'
+      << normalize(body) << '\n';
+
+  // The flags are in a different order when the check is batched.
+  std::sort(flags.begin(), flags.end());
+  for (std::string const& flag : flags) {
+    key << normalize(flag) << '\n';
+    std::string var;
+    std::string value;
+    cmStateEnums::CacheEntryType type;
+    if (cmHasLiteralPrefix(flag, "-D") &&
+        cmState::ParseCacheEntry(flag.substr(2), var, value, type)) {
+      if (var == "INCLUDE_DIRECTORIES") {
+        stampIncludeDirs(value);
+      } else if (var == "LINK_DIRECTORIES" || var == "LINK_LIBRARIES") {
+        stampPaths(value);
+      }
+    }
+  }
+  for (std::string const& lib : linkLibraries) {
+    stampPaths(lib);
+  }
+
+  // The identity of the tools, and the directories they search.
+  static std::vector<std::string> const toolVars = {
+    "COMPILER", "COMPILER_ID", "COMPILER_VERSION", "COMPILER_ARG1",
+    "IMPLICIT_INCLUDE_DIRECTORIES", "IMPLICIT_LINK_DIRECTORIES"
+  };
+  for (std::string const& li : testLangs) {
+    for (std::string const& var : toolVars) {
+      key << this->Makefile->GetSafeDefinition(
+               cmStrCat("CMAKE_", li, '_', var))
+          << '\n';
+    }
+    stampPaths(this->Makefile->GetSafeDefinition("CMAKE_" + li + "_COMPILER"));
+    stampIncludeDirs(this->Makefile->GetSafeDefinition(
+      "CMAKE_" + li + "_IMPLICIT_INCLUDE_DIRECTORIES"));
+    stampPaths(this->Makefile->GetSafeDefinition(
+      "CMAKE_" + li + "_IMPLICIT_LINK_DIRECTORIES"));
+  }
+  for (const char* var :
+       { "CMAKE_LINKER", "CMAKE_AR", "CMAKE_RANLIB", "CMAKE_SYSTEM_NAME",
+         "CMAKE_SYSTEM_VERSION", "CMAKE_SYSTEM_PROCESSOR",
+         "CMAKE_HOST_SYSTEM_PROCESSOR" }) {
+    key << this->Makefile->GetSafeDefinition(var) << '\n';
+  }
+  stampPaths(this->Makefile->GetSafeDefinition("CMAKE_LINKER"));
+  stampPaths(this->Makefile->GetSafeDefinition("CMAKE_AR"));
+
+  // Environment variables read by common compilers.
+  for (const char* var :
+       { "CPATH", "C_INCLUDE_PATH", "CPLUS_INCLUDE_PATH", "LIBRARY_PATH",
+         "INCLUDE", "LIB" }) {
+    std::string value;
+    cmSystemTools::GetEnv(var, value);
+    key << value << '\n';
+  }
+
+  // The content of the sources.  Sources outside of the temporary
+  // directory may include files next to them, so only generated sources
+  // are cached.
+  auto addContent = [&key](std::string const& file,
+                            std::string* contentOut = nullptr) -> bool {
+    cmsys::ifstream fin(file.c_str(), std::ios::in | std::ios::binary);
+    if (!fin) {
+      return false;
+    }
+    std::ostringstream content;
+    content << fin.rdbuf();
+    key << content.str().size() << '\n' << content.str() << '\n';
+    if (contentOut) {
+      *contentOut = content.str();
+    }
+    return true;
+  };
+  for (std::string const& si : sources) {
+    if (si.find("CMakeTmp") == std::string::npos) {
+      return;
+    }
+    key << normalize(si) << '\n';
+    std::string content;
+    if (!addContent(si, &content)) {
+      return;
+    }
+    AddIncludedSubdirectories(content, includedSubdirs);
+  }
+  for (std::string const& dir : includeDirs) {
+    for (std::string const& subdir : includedSubdirs) {
+      paths.insert(cmStrCat(dir, '/', subdir));
+    }
+  }
+
+  // The content of the files changing the toolchain or its rules,
+  // wherever they are.
+  std::vector<std::string> toolchainFiles = {
+    "CMAKE_TOOLCHAIN_FILE", "CMAKE_USER_MAKE_RULES_OVERRIDE"
+  };
+  for (std::string const& li : testLangs) {
+    toolchainFiles.push_back("CMAKE_USER_MAKE_RULES_OVERRIDE_" + li);
+  }
+  for (std::string const& var : toolchainFiles) {
+    std::string const file = cmSystemTools::CollapseFullPath(
+      this->Makefile->GetSafeDefinition(var),
+      this->Makefile->GetHomeOutputDirectory());
+    if (this->Makefile->IsSet(var) && cmSystemTools::FileExists(file, true) &&
+        !addContent(file)) {
+      return;
+    }
+  }
+
+  this->CacheKey = key.str();
+  this->CachePaths.assign(paths.begin(), paths.end());
+}
+#endif
+
 void cmCoreTryCompile::CleanupFiles(std::string const& binDir)
 {
   if (binDir.empty()) {
@@ -5,11 +5,14 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <set>
 #include <string>
 #include <vector>
 
 #include "cmCommand.h"
 #include "cmStateTypes.h"
+#include "cmTryCompileBatch.h"
+#include "cmTryCompileResultCache.h"
 
 /** \class cmCoreTryCompile
  * \brief Base class for cmTryCompileCommand and cmTryRunCommand
@@ -43,14 +46,67 @@ protected:
   void FindOutputFile(const std::string& targetName,
                       cmStateEnums::TargetType targetType);
 
+  /**
+   * Build the checks deferred while the given batch was open.  Each of
+   * them has its result stored and its finishing command called as if
+   * it had been built by itself.
+   */
+  bool BuildBatch(cmTryCompileBatch& batch);
+
+  /**
+   * Build the checks of one test project of a batch in the given
+   * directory.  If the project fails to configure or generate, each
+   * check is built in a project of its own instead.
+   */
+  bool BuildBatchProject(cmTryCompileBatch const& batch,
+                         cmTryCompileBatch::Project const& project,
+                         std::string const& projectDir);
+
+  /**
+   * Call the command, given with its arguments, that finishes a check.
+   */
+  void FinishCheck(std::vector<std::string> const& finish);
+
+  /**
+   * Store CachedResult for the current check in the try_compile result
+   * cache.  Does nothing if the check may not be cached.
+   */
+  void StoreCachedResult();
+
   std::string BinaryDirectory;
   std::string OutputFile;
   std::string FindErrorMessage;
   bool SrcFileSignature = false;
+  // Whether TryCompileCode deferred the check to the end of a batch.
+  bool Deferred = false;
+
+  // The parts of the result cache key known only to try_run, or empty
+  // if its result may not be cached.
+  std::string RunKey;
+  // The key and the paths stamped for the current check in the result
+  // cache.  The key is empty if the check may not be cached.
+  std::string CacheKey;
+  std::vector<std::string> CachePaths;
+  // Whether CachedResult was taken from the result cache rather than
+  // built.
+  bool CacheHit = false;
+  cmTryCompileResultCache::Result CachedResult;
 
 private:
   std::vector<std::string> WarnCMP0067;
   std::string LookupStdVar(std::string const& var, bool warnCMP0067);
+
+  /**
+   * Compute CacheKey and CachePaths for a check whose test project has
+   * the given code after its project() command.  Leave CacheKey empty
+   * if the check may not be cached.
+   */
+  void ComputeCacheKey(std::string const& body, std::string const& header,
+                       std::set<std::string> const& testLangs,
+                       std::vector<std::string> flags,
+                       std::vector<std::string> const& sources,
+                       std::vector<std::string> const& linkLibraries,
+                       std::string const& targetName, bool isTryRun);
 };
 
 #endif
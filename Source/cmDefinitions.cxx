@@ -2,6 +2,7 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmDefinitions.h"
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <unordered_set>
@@ -11,13 +12,47 @@
 
 cmDefinitions::Def cmDefinitions::NoDef;
 
+cmDefinitions::Key cmDefinitions::Intern(const std::string& name) const
+{
+  return &*this->Names->Names.insert(name).first;
+}
+
+cmDefinitions::Key cmDefinitions::FindInterned(const std::string& name) const
+{
+  auto it = this->Names->Names.find(name);
+  return it != this->Names->Names.end() ? &*it : nullptr;
+}
+
 cmDefinitions::Def const& cmDefinitions::GetInternal(const std::string& key,
                                                      StackIter begin,
                                                      StackIter end, bool raise)
 {
   assert(begin != end);
+  if (raise) {
+    return cmDefinitions::RaiseInternal(begin->Intern(key), begin, end);
+  }
+
+  // A name that was never interned has never been set or unset.
+  Key const k = begin->FindInterned(key);
+  if (!k) {
+    return cmDefinitions::NoDef;
+  }
+  for (StackIter it = begin; it != end; ++it) {
+    auto i = it->Map.find(k);
+    if (i != it->Map.end()) {
+      i->second.Used = true;
+      return i->second;
+    }
+  }
+  return cmDefinitions::NoDef;
+}
+
+cmDefinitions::Def const& cmDefinitions::RaiseInternal(Key key,
+                                                       StackIter begin,
+                                                       StackIter end)
+{
   {
-    auto it = begin->Map.find(cm::String::borrow(key));
+    auto it = begin->Map.find(key);
     if (it != begin->Map.end()) {
       it->second.Used = true;
       return it->second;
@@ -28,10 +63,7 @@ cmDefinitions::Def const& cmDefinitions::GetInternal(const std::string& key,
   if (it == end) {
     return cmDefinitions::NoDef;
   }
-  Def const& def = cmDefinitions::GetInternal(key, it, end, raise);
-  if (!raise) {
-    return def;
-  }
+  Def const& def = cmDefinitions::RaiseInternal(key, it, end);
   return begin->Map.emplace(key, def).first->second;
 }
 
@@ -51,8 +83,15 @@ void cmDefinitions::Raise(const std::string& key, StackIter begin,
 bool cmDefinitions::HasKey(const std::string& key, StackIter begin,
                            StackIter end)
 {
+  if (begin == end) {
+    return false;
+  }
+  Key const k = begin->FindInterned(key);
+  if (!k) {
+    return false;
+  }
   for (StackIter it = begin; it != end; ++it) {
-    if (it->Map.find(cm::String::borrow(key)) != it->Map.end()) {
+    if (it->Map.find(k) != it->Map.end()) {
       return true;
     }
   }
@@ -61,18 +100,19 @@ bool cmDefinitions::HasKey(const std::string& key, StackIter begin,
 
 cmDefinitions cmDefinitions::MakeClosure(StackIter begin, StackIter end)
 {
-  cmDefinitions closure;
-  std::unordered_set<cm::string_view> undefined;
+  assert(begin != end);
+  cmDefinitions closure(*begin->Names);
+  std::unordered_set<Key> undefined;
   for (StackIter it = begin; it != end; ++it) {
     // Consider local definitions.
     for (auto const& mi : it->Map) {
       // Use this key if it is not already set or unset.
       if (closure.Map.find(mi.first) == closure.Map.end() &&
-          undefined.find(mi.first.view()) == undefined.end()) {
+          undefined.find(mi.first) == undefined.end()) {
         if (mi.second.Value) {
           closure.Map.insert(mi);
         } else {
-          undefined.emplace(mi.first.view());
+          undefined.emplace(mi.first);
         }
       }
     }
@@ -84,14 +124,14 @@ std::vector<std::string> cmDefinitions::ClosureKeys(StackIter begin,
                                                     StackIter end)
 {
   std::vector<std::string> defined;
-  std::unordered_set<cm::string_view> bound;
+  std::unordered_set<Key> bound;
 
   for (StackIter it = begin; it != end; ++it) {
     defined.reserve(defined.size() + it->Map.size());
     for (auto const& mi : it->Map) {
       // Use this key if it is not already set or unset.
-      if (bound.emplace(mi.first.view()).second && mi.second.Value) {
-        defined.push_back(*mi.first.str_if_stable());
+      if (bound.emplace(mi.first).second && mi.second.Value) {
+        defined.push_back(*mi.first);
       }
     }
   }
@@ -101,12 +141,12 @@ std::vector<std::string> cmDefinitions::ClosureKeys(StackIter begin,
 
 void cmDefinitions::Set(const std::string& key, cm::string_view value)
 {
-  this->Map[key] = Def(value);
+  this->Map[this->Intern(key)] = Def(value);
 }
 
 void cmDefinitions::Unset(const std::string& key)
 {
-  this->Map[key] = Def();
+  this->Map[this->Intern(key)] = Def();
 }
 
 std::vector<std::string> cmDefinitions::UnusedKeys() const
@@ -116,8 +156,10 @@ std::vector<std::string> cmDefinitions::UnusedKeys() const
   // Consider local definitions.
   for (auto const& mi : this->Map) {
     if (!mi.second.Used) {
-      keys.push_back(*mi.first.str_if_stable());
+      keys.push_back(*mi.first);
     }
   }
+  // Keys are hashed by address, so sort them for a stable order.
+  std::sort(keys.begin(), keys.end());
   return keys;
 }
@@ -8,6 +8,7 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <cm/string_view>
@@ -21,12 +22,39 @@
  * This stores the state of variable definitions (set or unset) for
  * one scope.  Sets are always local.  Gets search parent scopes
  * transitively and save results locally.
+ *
+ * Variable names are interned in a table shared by all scopes of a
+ * cmState so that a lookup hashes the name once and then searches each
+ * scope by pointer identity.  Like the rest of the variable state, the
+ * table is not safe to use from several threads.
  */
 class cmDefinitions
 {
   using StackIter = cmLinkedTree<cmDefinitions>::iterator;
 
 public:
+  /** Table of interned variable names.  Names are never removed, so
+      the table must outlive every scope using it.  */
+  class NameTable
+  {
+  public:
+    NameTable() = default;
+    NameTable(NameTable const&) = delete;
+    NameTable& operator=(NameTable const&) = delete;
+
+  private:
+    friend class cmDefinitions;
+
+    // Elements of a node-based set never move, so pointers to them are
+    // stable keys for the lifetime of the table.
+    std::unordered_set<std::string> Names;
+  };
+
+  explicit cmDefinitions(NameTable& names)
+    : Names(&names)
+  {
+  }
+
   // -- Static member functions
 
   static const std::string* Get(const std::string& key, StackIter begin,
@@ -52,6 +80,12 @@ public:
   std::vector<std::string> UnusedKeys() const;
 
 private:
+  /** Interned variable name.  Equal names have equal keys.  */
+  using Key = std::string const*;
+
+  Key Intern(const std::string& name) const;
+  Key FindInterned(const std::string& name) const;
+
   /** String with existence boolean.  */
   struct Def
   {
@@ -66,10 +100,12 @@ private:
   };
   static Def NoDef;
 
-  std::unordered_map<cm::String, Def> Map;
+  NameTable* Names;
+  std::unordered_map<Key, Def> Map;
 
   static Def const& GetInternal(const std::string& key, StackIter begin,
                                 StackIter end, bool raise);
+  static Def const& RaiseInternal(Key key, StackIter begin, StackIter end);
 };
 
 #endif
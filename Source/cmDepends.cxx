@@ -44,6 +44,9 @@ bool cmDepends::Write(std::ostream& makeDepends, std::ostream& internalDepends)
       dependencies[obj].insert(src);
     }
   }
+  if (!this->PrepareDependencies(dependencies)) {
+    return false;
+  }
   for (auto const& d : dependencies) {
     // Write the dependencies for this pair.
     if (!this->WriteDependencies(d.second, d.first, makeDepends,
@@ -55,6 +58,12 @@ bool cmDepends::Write(std::ostream& makeDepends, std::ostream& internalDepends)
   return this->Finalize(makeDepends, internalDepends);
 }
 
+bool cmDepends::PrepareDependencies(
+  const std::map<std::string, std::set<std::string>>& /*unused*/)
+{
+  return true;
+}
+
 bool cmDepends::Finalize(std::ostream& /*unused*/, std::ostream& /*unused*/)
 {
   return true;
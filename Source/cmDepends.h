@@ -73,6 +73,12 @@ public:
   void SetFileTimeCache(cmFileTimeCache* fc) { this->FileTimeCache = fc; }
 
 protected:
+  // Prepare writing the dependencies of all object files of the target.
+  // Called by Write before WriteDependencies is called for each object
+  // file.  Return true for success and false for failure.
+  virtual bool PrepareDependencies(
+    const std::map<std::string, std::set<std::string>>& dependencies);
+
   // Write dependencies for the target file to the given stream.
   // Return true for success and false for failure.
   virtual bool WriteDependencies(const std::set<std::string>& sources,
@@ -2,16 +2,31 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmDependsC.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <unordered_map>
 #include <utility>
 
+#include <cm/memory>
+
 #include "cmsys/FStream.hxx"
 
-#include "cmFileTime.h"
+#include "cmDependsCDatabase.h"
+#include "cmGlobalGenerator.h"
 #include "cmLocalGenerator.h"
 #include "cmMakefile.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
+#if !defined(CMAKE_BOOTSTRAP)
+#  include <mutex>
+
+#  include "cmWorkerPool.h"
+#endif
+
 #define INCLUDE_REGEX_LINE                                                    \
   "^[ \t]*[#%][ \t]*(include|import)[ \t]*[<\"]([^\">]+)([\">])"
 
@@ -20,12 +35,212 @@
 #define INCLUDE_REGEX_COMPLAIN_MARKER "#IncludeRegexComplain: "
 #define INCLUDE_REGEX_TRANSFORM_MARKER "#IncludeRegexTransform: "
 
-cmDependsC::cmDependsC() = default;
+namespace {
+#ifndef CMAKE_BOOTSTRAP
+using StripeMutex = std::mutex;
+using StripeLock = std::lock_guard<std::mutex>;
+#else
+// The bootstrap cmake scans serially.
+struct StripeMutex
+{
+};
+struct StripeLock
+{
+  StripeLock(StripeMutex& /*unused*/) {}
+};
+#endif
+
+// Match a line against INCLUDE_REGEX_LINE without using the regular
+// expression engine.  Most lines of a header do not start with a
+// directive and are rejected after looking at their first characters.
+// On a match the included file name and the closing delimiter are
+// stored.
+bool MatchIncludeLine(const char* pos, const char* end, std::string& name,
+                      char& delimiter)
+{
+  auto skipBlanks = [&pos, end]() {
+    while (pos != end && (*pos == ' ' || *pos == '\t')) {
+      ++pos;
+    }
+  };
+
+  skipBlanks();
+  if (pos == end || (*pos != '#' && *pos != '%')) {
+    return false;
+  }
+  ++pos;
+  skipBlanks();
+  std::size_t const size = static_cast<std::size_t>(end - pos);
+  if (size >= 7 && std::memcmp(pos, "include", 7) == 0) {
+    pos += 7;
+  } else if (size >= 6 && std::memcmp(pos, "import", 6) == 0) {
+    pos += 6;
+  } else {
+    return false;
+  }
+  skipBlanks();
+  if (pos == end || (*pos != '<' && *pos != '"')) {
+    return false;
+  }
+  const char* const nameBegin = ++pos;
+  while (pos != end && *pos != '"' && *pos != '>' && *pos != '\0') {
+    ++pos;
+  }
+  if (pos == nameBegin || pos == end || *pos == '\0') {
+    return false;
+  }
+  name.assign(nameBegin, pos);
+  delimiter = *pos;
+  return true;
+}
+}
+
+class cmDependsC::SharedCache
+{
+public:
+  // Return the include lines of a file scanned before, or nullptr.
+  cmIncludeLines const* GetIncludeLines(std::string const& fullName)
+  {
+    Stripe& stripe = this->GetStripe(fullName);
+    StripeLock lock(stripe.Mutex);
+    auto it = stripe.FileCache.find(fullName);
+    if (it == stripe.FileCache.end()) {
+      return nullptr;
+    }
+    it->second.Used = true;
+    return &it->second;
+  }
+
+  // Record the include lines of a file.  If another walk stored the
+  // same file meanwhile its equal entry is kept.
+  void StoreIncludeLines(std::string const& fullName, cmIncludeLines lines)
+  {
+    Stripe& stripe = this->GetStripe(fullName);
+    StripeLock lock(stripe.Mutex);
+    cmIncludeLines& entry = stripe.FileCache[fullName];
+    if (!entry.Used) {
+      entry = std::move(lines);
+      entry.Used = true;
+    }
+  }
+
+  bool GetHeaderLocation(std::string const& fileName, std::string& fullName)
+  {
+    Stripe& stripe = this->GetStripe(fileName);
+    StripeLock lock(stripe.Mutex);
+    auto it = stripe.HeaderLocationCache.find(fileName);
+    if (it == stripe.HeaderLocationCache.end()) {
+      return false;
+    }
+    fullName = it->second;
+    return true;
+  }
+
+  void StoreHeaderLocation(std::string const& fileName,
+                           std::string const& fullName)
+  {
+    Stripe& stripe = this->GetStripe(fileName);
+    StripeLock lock(stripe.Mutex);
+    stripe.HeaderLocationCache.emplace(fileName, fullName);
+  }
+
+  // Collect the used entries ordered by file name.  Not thread-safe.
+  std::map<std::string, cmIncludeLines const*> GetUsedIncludeLines() const
+  {
+    std::map<std::string, cmIncludeLines const*> used;
+    for (Stripe const& stripe : this->Stripes) {
+      for (auto const& fileIt : stripe.FileCache) {
+        if (fileIt.second.Used) {
+          used.emplace(fileIt.first, &fileIt.second);
+        }
+      }
+    }
+    return used;
+  }
+
+private:
+  static const std::size_t StripeCount = 16;
+
+  struct Stripe
+  {
+    StripeMutex Mutex;
+    std::unordered_map<std::string, cmIncludeLines> FileCache;
+    std::unordered_map<std::string, std::string> HeaderLocationCache;
+  };
+
+  Stripe& GetStripe(std::string const& key)
+  {
+    return this->Stripes[std::hash<std::string>()(key) % StripeCount];
+  }
+
+  Stripe Stripes[StripeCount];
+};
+
+class cmDependsC::Walker
+{
+public:
+  Walker(cmDependsC& depends)
+    : Depends(depends)
+    , IncludeRegexScan(depends.IncludeRegexScan)
+    , IncludeRegexComplain(depends.IncludeRegexComplain)
+    , IncludeRegexTransform(depends.IncludeRegexTransform)
+  {
+  }
+
+  // Walk the dependency graph starting with the given source files.
+  // Returns false and sets missingFile if a file matching the complain
+  // regex cannot be found.
+  bool Walk(std::set<std::string> const& sources,
+            std::set<std::string>& dependencies, std::string& missingFile);
+
+private:
+  void Queue(std::vector<UnscannedEntry> const& entries);
+  void Scan(std::istream& is, const std::string& directory,
+            const std::string& fullName, cmIncludeLines& lines);
+  void TransformLine(std::string& line);
+
+  cmDependsC& Depends;
+
+  // Matching stores the match positions in the expression object, so
+  // every walk uses its own copies of the regular expressions.
+  cmsys::RegularExpression IncludeRegexScan;
+  cmsys::RegularExpression IncludeRegexComplain;
+  cmsys::RegularExpression IncludeRegexTransform;
+
+  std::set<std::string> Encountered;
+  std::queue<UnscannedEntry> Unscanned;
+};
+
+#ifndef CMAKE_BOOTSTRAP
+namespace {
+class ScanJob : public cmWorkerPool::JobT
+{
+public:
+  using WalkFunction = std::function<void()>;
+
+  ScanJob(WalkFunction walk)
+    : Walk(std::move(walk))
+  {
+  }
+
+private:
+  void Process() override { this->Walk(); }
+
+  WalkFunction Walk;
+};
+}
+#endif
+
+cmDependsC::cmDependsC()
+  : Cache(cm::make_unique<SharedCache>())
+{
+}
 
 cmDependsC::cmDependsC(cmLocalGenerator* lg, const std::string& targetDir,
                        const std::string& lang, const DependencyMap* validDeps)
   : cmDepends(lg, targetDir)
   , ValidDeps(validDeps)
+  , Cache(cm::make_unique<SharedCache>())
 {
   cmMakefile* mf = lg->GetMakefile();
 
@@ -47,8 +262,8 @@ cmDependsC::cmDependsC(cmLocalGenerator* lg, const std::string& targetDir,
     }
   }
 
-  this->IncludeRegexLine.compile(INCLUDE_REGEX_LINE);
   this->IncludeRegexScan.compile(scanRegex);
+  this->ScanAllIncludes = scanRegex == "^.*$";
   this->IncludeRegexComplain.compile(complainRegex);
   this->IncludeRegexLineString = INCLUDE_REGEX_LINE_MARKER INCLUDE_REGEX_LINE;
   this->IncludeRegexScanString =
@@ -58,15 +273,76 @@ cmDependsC::cmDependsC(cmLocalGenerator* lg, const std::string& targetDir,
 
   this->SetupTransforms();
 
-  this->CacheFileName =
-    cmStrCat(this->TargetDirectory, '/', lang, ".includecache");
-
-  this->ReadCacheFile();
+  // Share the include lines of scanned files with all targets in the
+  // build tree that are scanned with the same settings.
+  this->Database = cm::make_unique<cmDependsCDatabase>(
+    cmStrCat(lg->GetBinaryDirectory(), "/CMakeFiles/CMakeDependsC.bin"),
+    cmStrCat(this->IncludeRegexLineString, '\n',
+             this->IncludeRegexScanString, '\n',
+             this->IncludeRegexComplainString, '\n',
+             this->IncludeRegexTransformString));
+  this->Database->Load();
 }
 
 cmDependsC::~cmDependsC()
 {
-  this->WriteCacheFile();
+  if (this->Database) {
+    this->Database->Save(this->Cache->GetUsedIncludeLines(),
+                         this->ScannedObjects);
+  }
+}
+
+std::string cmDependsC::GetObjectKey(std::string const& obj) const
+{
+  // Compute a path to the object file to write to the internal depend file.
+  // Any existing content of the internal depend file has already been
+  // loaded in ValidDeps with this path as a key.
+  return this->LocalGenerator->MaybeConvertToRelativePath(
+    this->LocalGenerator->GetBinaryDirectory(), obj);
+}
+
+bool cmDependsC::PrepareDependencies(
+  const std::map<std::string, std::set<std::string>>& dependencies)
+{
+#ifndef CMAKE_BOOTSTRAP
+  // Collect the object files whose dependencies must be scanned.
+  std::vector<std::pair<std::set<std::string> const*, ScanResult*>> walks;
+  for (auto const& d : dependencies) {
+    if (d.first.empty() || d.second.empty() || d.second.begin()->empty()) {
+      continue;
+    }
+    if (this->ValidDeps != nullptr && !this->ValidDeps->empty() &&
+        this->ValidDeps->find(this->GetObjectKey(d.first)) !=
+          this->ValidDeps->end()) {
+      continue;
+    }
+    walks.emplace_back(&d.second, &this->ScanResults[d.first]);
+  }
+
+  unsigned int const threads = static_cast<unsigned int>(std::min<size_t>(
+    cmGlobalGenerator::GetParallelThreadCount(), walks.size()));
+  if (threads > 1) {
+    // Walk the graphs of all object files concurrently.  The results are
+    // written out in order by WriteDependencies.
+    cmWorkerPool pool;
+    pool.SetThreadCount(threads);
+    for (auto const& w : walks) {
+      std::set<std::string> const* sources = w.first;
+      ScanResult* result = w.second;
+      pool.EmplaceJob<ScanJob>([this, sources, result]() {
+        Walker walker(*this);
+        walker.Walk(*sources, result->Dependencies, result->MissingFile);
+      });
+    }
+    pool.EmplaceJob<cmWorkerPool::JobEndT>();
+    pool.Process();
+  } else {
+    this->ScanResults.clear();
+  }
+#else
+  static_cast<void>(dependencies);
+#endif
+  return true;
 }
 
 bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
@@ -88,12 +364,7 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
   bool haveDeps = false;
 
   std::string binDir = this->LocalGenerator->GetBinaryDirectory();
-
-  // Compute a path to the object file to write to the internal depend file.
-  // Any existing content of the internal depend file has already been
-  // loaded in ValidDeps with this path as a key.
-  std::string obj_i =
-    this->LocalGenerator->MaybeConvertToRelativePath(binDir, obj);
+  std::string obj_i = this->GetObjectKey(obj);
 
   if (this->ValidDeps != nullptr) {
     auto const tmpIt = this->ValidDeps->find(obj_i);
@@ -104,107 +375,22 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
   }
 
   if (!haveDeps) {
-    // Walk the dependency graph starting with the source file.
-    int srcFiles = static_cast<int>(sources.size());
-    this->Encountered.clear();
-
-    for (std::string const& src : sources) {
-      UnscannedEntry root;
-      root.FileName = src;
-      this->Unscanned.push(root);
-      this->Encountered.insert(src);
+    std::string missingFile;
+    auto const resultIt = this->ScanResults.find(obj);
+    if (resultIt != this->ScanResults.end()) {
+      // The dependency graph has been walked by PrepareDependencies.
+      dependencies = std::move(resultIt->second.Dependencies);
+      missingFile = std::move(resultIt->second.MissingFile);
+      this->ScanResults.erase(resultIt);
+    } else {
+      Walker walker(*this);
+      walker.Walk(sources, dependencies, missingFile);
     }
-
-    std::set<std::string> scanned;
-    while (!this->Unscanned.empty()) {
-      // Get the next file to scan.
-      UnscannedEntry current = this->Unscanned.front();
-      this->Unscanned.pop();
-
-      // If not a full path, find the file in the include path.
-      std::string fullName;
-      if ((srcFiles > 0) || cmSystemTools::FileIsFullPath(current.FileName)) {
-        if (cmSystemTools::FileExists(current.FileName, true)) {
-          fullName = current.FileName;
-        }
-      } else if (!current.QuotedLocation.empty() &&
-                 cmSystemTools::FileExists(current.QuotedLocation, true)) {
-        // The include statement producing this entry was a double-quote
-        // include and the included file is present in the directory of
-        // the source containing the include statement.
-        fullName = current.QuotedLocation;
-      } else {
-        auto headerLocationIt =
-          this->HeaderLocationCache.find(current.FileName);
-        if (headerLocationIt != this->HeaderLocationCache.end()) {
-          fullName = headerLocationIt->second;
-        } else {
-          for (std::string const& iPath : this->IncludePath) {
-            // Construct the name of the file as if it were in the current
-            // include directory.  Avoid using a leading "./".
-            std::string tmpPath =
-              cmSystemTools::CollapseFullPath(current.FileName, iPath);
-
-            // Look for the file in this location.
-            if (cmSystemTools::FileExists(tmpPath, true)) {
-              fullName = tmpPath;
-              this->HeaderLocationCache[current.FileName] = std::move(tmpPath);
-              break;
-            }
-          }
-        }
-      }
-
-      // Complain if the file cannot be found and matches the complain
-      // regex.
-      if (fullName.empty() &&
-          this->IncludeRegexComplain.find(current.FileName)) {
-        cmSystemTools::Error("Cannot find file \"" + current.FileName + "\".");
-        return false;
-      }
-
-      // Scan the file if it was found and has not been scanned already.
-      if (!fullName.empty() && (scanned.find(fullName) == scanned.end())) {
-        // Record scanned files.
-        scanned.insert(fullName);
-
-        // Check whether this file is already in the cache
-        auto fileIt = this->FileCache.find(fullName);
-        if (fileIt != this->FileCache.end()) {
-          fileIt->second.Used = true;
-          dependencies.insert(fullName);
-          for (UnscannedEntry const& inc : fileIt->second.UnscannedEntries) {
-            if (this->Encountered.find(inc.FileName) ==
-                this->Encountered.end()) {
-              this->Encountered.insert(inc.FileName);
-              this->Unscanned.push(inc);
-            }
-          }
-        } else {
-
-          // Try to scan the file.  Just leave it out if we cannot find
-          // it.
-          cmsys::ifstream fin(fullName.c_str());
-          if (fin) {
-            cmsys::FStream::BOM bom = cmsys::FStream::ReadBOM(fin);
-            if (bom == cmsys::FStream::BOM_None ||
-                bom == cmsys::FStream::BOM_UTF8) {
-              // Add this file as a dependency.
-              dependencies.insert(fullName);
-
-              // Scan this file for new dependencies.  Pass the directory
-              // containing the file to handle double-quote includes.
-              std::string dir = cmSystemTools::GetFilenamePath(fullName);
-              this->Scan(fin, dir, fullName);
-            } else {
-              // Skip file with encoding we do not implement.
-            }
-          }
-        }
-      }
-
-      srcFiles--;
+    if (!missingFile.empty()) {
+      cmSystemTools::Error("Cannot find file \"" + missingFile + "\".");
+      return false;
     }
+    this->ScannedObjects[obj] = dependencies;
   }
 
   // Write the dependencies to the output stream.  Makefile rules
@@ -227,155 +413,202 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
   return true;
 }
 
-void cmDependsC::ReadCacheFile()
+bool cmDependsC::Walker::Walk(std::set<std::string> const& sources,
+                              std::set<std::string>& dependencies,
+                              std::string& missingFile)
 {
-  if (this->CacheFileName.empty()) {
-    return;
-  }
-  cmsys::ifstream fin(this->CacheFileName.c_str());
-  if (!fin) {
-    return;
+  SharedCache& cache = *this->Depends.Cache;
+  std::vector<std::string> const& includePath = this->Depends.IncludePath;
+
+  // Walk the dependency graph starting with the source file.
+  int srcFiles = static_cast<int>(sources.size());
+  this->Encountered.clear();
+
+  for (std::string const& src : sources) {
+    UnscannedEntry root;
+    root.FileName = src;
+    this->Unscanned.push(root);
+    this->Encountered.insert(src);
   }
 
-  std::string line;
-  cmIncludeLines* cacheEntry = nullptr;
-  bool haveFileName = false;
-
-  cmFileTime cacheFileTime;
-  bool const cacheFileTimeGood = cacheFileTime.Load(this->CacheFileName);
-  while (cmSystemTools::GetLineFromStream(fin, line)) {
-    if (line.empty()) {
-      cacheEntry = nullptr;
-      haveFileName = false;
-      continue;
+  std::set<std::string> scanned;
+  while (!this->Unscanned.empty()) {
+    // Get the next file to scan.
+    UnscannedEntry current = this->Unscanned.front();
+    this->Unscanned.pop();
+
+    // If not a full path, find the file in the include path.
+    std::string fullName;
+    if ((srcFiles > 0) || cmSystemTools::FileIsFullPath(current.FileName)) {
+      if (cmSystemTools::FileExists(current.FileName, true)) {
+        fullName = current.FileName;
+      }
+    } else if (!current.QuotedLocation.empty() &&
+               cmSystemTools::FileExists(current.QuotedLocation, true)) {
+      // The include statement producing this entry was a double-quote
+      // include and the included file is present in the directory of
+      // the source containing the include statement.
+      fullName = current.QuotedLocation;
+    } else if (!cache.GetHeaderLocation(current.FileName, fullName)) {
+      for (std::string const& iPath : includePath) {
+        // Construct the name of the file as if it were in the current
+        // include directory.  Avoid using a leading "./".
+        std::string tmpPath =
+          cmSystemTools::CollapseFullPath(current.FileName, iPath);
+
+        // Look for the file in this location.
+        if (cmSystemTools::FileExists(tmpPath, true)) {
+          cache.StoreHeaderLocation(current.FileName, tmpPath);
+          fullName = std::move(tmpPath);
+          break;
+        }
+      }
     }
-    // the first line after an empty line is the name of the parsed file
-    if (!haveFileName) {
-      haveFileName = true;
 
-      cmFileTime fileTime;
-      bool const res = cacheFileTimeGood && fileTime.Load(line);
-      bool const newer = res && cacheFileTime.Newer(fileTime);
+    // Complain if the file cannot be found and matches the complain
+    // regex.
+    if (fullName.empty() &&
+        this->IncludeRegexComplain.find(current.FileName)) {
+      missingFile = current.FileName;
+      return false;
+    }
 
-      if (res && newer) // cache is newer than the parsed file
-      {
-        cacheEntry = &this->FileCache[line];
-      }
-      // file doesn't exist, check that the regular expressions
-      // haven't changed
-      else if (!res) {
-        if (line.find(INCLUDE_REGEX_LINE_MARKER) == 0) {
-          if (line != this->IncludeRegexLineString) {
-            return;
-          }
-        } else if (line.find(INCLUDE_REGEX_SCAN_MARKER) == 0) {
-          if (line != this->IncludeRegexScanString) {
-            return;
-          }
-        } else if (line.find(INCLUDE_REGEX_COMPLAIN_MARKER) == 0) {
-          if (line != this->IncludeRegexComplainString) {
-            return;
-          }
-        } else if (line.find(INCLUDE_REGEX_TRANSFORM_MARKER) == 0) {
-          if (line != this->IncludeRegexTransformString) {
-            return;
+    // Scan the file if it was found and has not been scanned already.
+    if (!fullName.empty() && (scanned.find(fullName) == scanned.end())) {
+      // Record scanned files.
+      scanned.insert(fullName);
+
+      // Check whether this file is already in the cache
+      cmIncludeLines lines;
+      if (cmIncludeLines const* cached = cache.GetIncludeLines(fullName)) {
+        dependencies.insert(fullName);
+        this->Queue(cached->UnscannedEntries);
+      } else if (this->Depends.Database &&
+                 this->Depends.Database->Lookup(fullName, lines)) {
+        // The file was scanned before by this or another target.
+        dependencies.insert(fullName);
+        this->Queue(lines.UnscannedEntries);
+        cache.StoreIncludeLines(fullName, std::move(lines));
+      } else {
+
+        // Try to scan the file.  Just leave it out if we cannot find
+        // it.
+        cmsys::ifstream fin(fullName.c_str());
+        if (fin) {
+          cmsys::FStream::BOM bom = cmsys::FStream::ReadBOM(fin);
+          if (bom == cmsys::FStream::BOM_None ||
+              bom == cmsys::FStream::BOM_UTF8) {
+            // Add this file as a dependency.
+            dependencies.insert(fullName);
+
+            // Scan this file for new dependencies.  Pass the directory
+            // containing the file to handle double-quote includes.
+            std::string dir = cmSystemTools::GetFilenamePath(fullName);
+            this->Scan(fin, dir, fullName, lines);
+          } else {
+            // Skip file with encoding we do not implement.
           }
         }
       }
-    } else if (cacheEntry != nullptr) {
-      UnscannedEntry entry;
-      entry.FileName = line;
-      if (cmSystemTools::GetLineFromStream(fin, line)) {
-        if (line != "-") {
-          entry.QuotedLocation = line;
-        }
-        cacheEntry->UnscannedEntries.push_back(std::move(entry));
-      }
     }
+
+    srcFiles--;
   }
+
+  return true;
 }
 
-void cmDependsC::WriteCacheFile() const
+void cmDependsC::Walker::Queue(std::vector<UnscannedEntry> const& entries)
 {
-  if (this->CacheFileName.empty()) {
-    return;
-  }
-  cmsys::ofstream cacheOut(this->CacheFileName.c_str());
-  if (!cacheOut) {
-    return;
+  for (UnscannedEntry const& inc : entries) {
+    if (this->Encountered.insert(inc.FileName).second) {
+      this->Unscanned.push(inc);
+    }
   }
+}
 
-  cacheOut << this->IncludeRegexLineString << "\n\n";
-  cacheOut << this->IncludeRegexScanString << "\n\n";
-  cacheOut << this->IncludeRegexComplainString << "\n\n";
-  cacheOut << this->IncludeRegexTransformString << "\n\n";
-
-  for (auto const& fileIt : this->FileCache) {
-    if (fileIt.second.Used) {
-      cacheOut << fileIt.first << std::endl;
+void cmDependsC::Walker::Scan(std::istream& is, const std::string& directory,
+                              const std::string& fullName,
+                              cmIncludeLines& lines)
+{
+  std::vector<UnscannedEntry>& entries = lines.UnscannedEntries;
 
-      for (UnscannedEntry const& inc : fileIt.second.UnscannedEntries) {
-        cacheOut << inc.FileName << std::endl;
-        if (inc.QuotedLocation.empty()) {
-          cacheOut << "-" << std::endl;
-        } else {
-          cacheOut << inc.QuotedLocation << std::endl;
-        }
+  // Read the rest of the file at once and look at one line at a time.
+  std::string content;
+  {
+    std::streampos const begin = is.tellg();
+    if (begin != std::streampos(-1) && is.seekg(0, std::ios::end)) {
+      std::streamoff const size = is.tellg() - begin;
+      is.seekg(begin);
+      if (size > 0) {
+        content.reserve(static_cast<std::size_t>(size));
       }
-      cacheOut << std::endl;
+    }
+    char buffer[16384];
+    while (is.read(buffer, sizeof(buffer)) || is.gcount() > 0) {
+      content.append(buffer, static_cast<std::size_t>(is.gcount()));
     }
   }
-}
 
-void cmDependsC::Scan(std::istream& is, const std::string& directory,
-                      const std::string& fullName)
-{
-  cmIncludeLines& newCacheEntry = this->FileCache[fullName];
-  newCacheEntry.Used = true;
-
-  // Read one line at a time.
   std::string line;
-  while (cmSystemTools::GetLineFromStream(is, line)) {
-    // Transform the line content first.
-    if (!this->TransformRules.empty()) {
-      this->TransformLine(line);
+  std::string fileName;
+  char delimiter = 0;
+  const char* const end = content.data() + content.size();
+  for (const char* pos = content.data(); pos != end;) {
+    const char* eol = static_cast<const char*>(
+      std::memchr(pos, '\n', static_cast<std::size_t>(end - pos)));
+    if (eol == nullptr) {
+      eol = end;
     }
 
-    // Match include directives.
-    if (this->IncludeRegexLine.find(line)) {
-      // Get the file being included.
-      UnscannedEntry entry;
-      entry.FileName = this->IncludeRegexLine.match(2);
-      cmSystemTools::ConvertToUnixSlashes(entry.FileName);
-      if (this->IncludeRegexLine.match(3) == "\"" &&
-          !cmSystemTools::FileIsFullPath(entry.FileName)) {
-        // This was a double-quoted include with a relative path.  We
-        // must check for the file in the directory containing the
-        // file we are scanning.
-        entry.QuotedLocation =
-          cmSystemTools::CollapseFullPath(entry.FileName, directory);
+    // Match include directives, transforming the line content first.
+    bool found;
+    if (!this->Depends.TransformRules.empty()) {
+      line.assign(pos, eol);
+      if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
       }
+      this->TransformLine(line);
+      found = MatchIncludeLine(line.data(), line.data() + line.size(),
+                               fileName, delimiter);
+    } else {
+      found = MatchIncludeLine(pos, eol, fileName, delimiter);
+    }
+    pos = eol == end ? end : eol + 1;
+    if (!found) {
+      continue;
+    }
 
-      // Queue the file if it has not yet been encountered and it
-      // matches the regular expression for recursive scanning.  Note
-      // that this check does not account for the possibility of two
-      // headers with the same name in different directories when one
-      // is included by double-quotes and the other by angle brackets.
-      // It also does not work properly if two header files with the same
-      // name exist in different directories, and both are included from a
-      // file their own directory by simply using "filename.h" (#12619)
-      // This kind of problem will be fixed when a more
-      // preprocessor-like implementation of this scanner is created.
-      if (this->IncludeRegexScan.find(entry.FileName)) {
-        newCacheEntry.UnscannedEntries.push_back(entry);
-        if (this->Encountered.find(entry.FileName) ==
-            this->Encountered.end()) {
-          this->Encountered.insert(entry.FileName);
-          this->Unscanned.push(entry);
-        }
-      }
+    // Get the file being included.
+    UnscannedEntry entry;
+    entry.FileName = fileName;
+    cmSystemTools::ConvertToUnixSlashes(entry.FileName);
+    if (delimiter == '"' && !cmSystemTools::FileIsFullPath(entry.FileName)) {
+      // This was a double-quoted include with a relative path.  We
+      // must check for the file in the directory containing the
+      // file we are scanning.
+      entry.QuotedLocation =
+        cmSystemTools::CollapseFullPath(entry.FileName, directory);
+    }
+
+    // Queue the file if it has not yet been encountered and it
+    // matches the regular expression for recursive scanning.  Note
+    // that this check does not account for the possibility of two
+    // headers with the same name in different directories when one
+    // is included by double-quotes and the other by angle brackets.
+    // It also does not work properly if two header files with the same
+    // name exist in different directories, and both are included from a
+    // file their own directory by simply using "filename.h" (#12619)
+    // This kind of problem will be fixed when a more
+    // preprocessor-like implementation of this scanner is created.
+    if (this->Depends.ScanAllIncludes ||
+        this->IncludeRegexScan.find(entry.FileName)) {
+      entries.push_back(std::move(entry));
     }
   }
+
+  this->Queue(entries);
+  this->Depends.Cache->StoreIncludeLines(fullName, std::move(lines));
 }
 
 void cmDependsC::SetupTransforms()
@@ -429,14 +662,15 @@ void cmDependsC::ParseTransform(std::string const& xform)
   this->TransformRules[name] = value;
 }
 
-void cmDependsC::TransformLine(std::string& line)
+void cmDependsC::Walker::TransformLine(std::string& line)
 {
   // Check for a transform rule match.  Return if none.
   if (!this->IncludeRegexTransform.find(line)) {
     return;
   }
-  auto tri = this->TransformRules.find(this->IncludeRegexTransform.match(3));
-  if (tri == this->TransformRules.end()) {
+  auto tri =
+    this->Depends.TransformRules.find(this->IncludeRegexTransform.match(3));
+  if (tri == this->Depends.TransformRules.end()) {
     return;
   }
 
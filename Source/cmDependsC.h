@@ -7,16 +7,17 @@
 
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
-#include <queue>
-
 #include "cmsys/RegularExpression.hxx"
 
+#include "cmBinaryCacheFile.h"
 #include "cmDepends.h"
 
+class cmDependsCDatabase;
 class cmLocalGenerator;
 
 /** \class cmDependsC
@@ -39,24 +40,23 @@ public:
 
 protected:
   // Implement writing/checking methods required by superclass.
+  bool PrepareDependencies(
+    const std::map<std::string, std::set<std::string>>& dependencies)
+    override;
   bool WriteDependencies(const std::set<std::string>& sources,
                          const std::string& obj, std::ostream& makeDepends,
                          std::ostream& internalDepends) override;
 
-  // Method to scan a single file.
-  void Scan(std::istream& is, const std::string& directory,
-            const std::string& fullName);
-
-  // Regular expression to identify C preprocessor include directives.
-  cmsys::RegularExpression IncludeRegexLine;
-
   // Regular expressions to choose which include files to scan
-  // recursively and which to complain about not finding.
+  // recursively and which to complain about not finding.  The
+  // expression identifying C preprocessor include directives is
+  // matched by hand.
   cmsys::RegularExpression IncludeRegexScan;
   cmsys::RegularExpression IncludeRegexComplain;
   std::string IncludeRegexLineString;
   std::string IncludeRegexScanString;
   std::string IncludeRegexComplainString;
+  bool ScanAllIncludes = false;
 
   // Regex to transform #include lines.
   std::string IncludeRegexTransformString;
@@ -65,7 +65,6 @@ protected:
   TransformRulesType TransformRules;
   void SetupTransforms();
   void ParseTransform(std::string const& xform);
-  void TransformLine(std::string& line);
 
 public:
   // Data structures for dependency graph walk.
@@ -78,21 +77,38 @@ public:
   struct cmIncludeLines
   {
     std::vector<UnscannedEntry> UnscannedEntries;
+    // State of the file when it was scanned.
+    cmBinaryCacheFile::Stamp Stamp;
+    // Scanned by this process and not yet in the database.
+    bool Modified = false;
     bool Used = false;
   };
 
 protected:
-  const DependencyMap* ValidDeps = nullptr;
-  std::set<std::string> Encountered;
-  std::queue<UnscannedEntry> Unscanned;
+  // Dependency graph walk starting at the sources of one object file.
+  class Walker;
+
+  // Include lines of scanned files and locations of headers found in
+  // the include path.  Shared by all walks, which may run concurrently.
+  class SharedCache;
 
-  std::map<std::string, cmIncludeLines> FileCache;
-  std::map<std::string, std::string> HeaderLocationCache;
+  // Result of a walk done ahead of WriteDependencies.
+  struct ScanResult
+  {
+    std::set<std::string> Dependencies;
+    std::string MissingFile;
+  };
+
+  const DependencyMap* ValidDeps = nullptr;
+  std::unique_ptr<SharedCache> Cache;
+  std::map<std::string, ScanResult> ScanResults;
 
-  std::string CacheFileName;
+  std::unique_ptr<cmDependsCDatabase> Database;
+  // Files reached by the walk of each object file scanned by this
+  // instance, to prune the database.
+  std::map<std::string, std::set<std::string>> ScannedObjects;
 
-  void WriteCacheFile() const;
-  void ReadCacheFile();
+  std::string GetObjectKey(std::string const& obj) const;
 };
 
 #endif
@@ -0,0 +1,314 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmDependsCDatabase.h"
+
+#include <utility>
+
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+#if !defined(CMAKE_BOOTSTRAP)
+#  include "cmFileLock.h"
+#  include "cmFileLockResult.h"
+#endif
+
+namespace {
+
+// Bump the last byte whenever the record layout changes.
+cmBinaryCacheFile::Magic const Magic = { 'C', 'M', 'D', 'E', 'P', 'C',
+                                         '\0', '\2' };
+
+std::string SerializeIncludes(cmDependsCDatabase::IncludeLines const& lines)
+{
+  std::string data;
+  cmBinaryCacheWriter w(data);
+  w.Put(static_cast<std::uint32_t>(lines.UnscannedEntries.size()));
+  for (cmDependsC::UnscannedEntry const& entry : lines.UnscannedEntries) {
+    w.PutString(entry.FileName);
+    w.PutString(entry.QuotedLocation);
+  }
+  return data;
+}
+
+bool DeserializeIncludes(cm::string_view data,
+                         cmDependsCDatabase::IncludeLines& lines)
+{
+  cmBinaryCacheReader r(data);
+  std::uint32_t count;
+  if (!r.Get(count)) {
+    return false;
+  }
+  lines.UnscannedEntries.clear();
+  lines.UnscannedEntries.reserve(count);
+  for (std::uint32_t i = 0; i < count; ++i) {
+    cmDependsC::UnscannedEntry entry;
+    if (!r.GetString(entry.FileName) || !r.GetString(entry.QuotedLocation)) {
+      return false;
+    }
+    lines.UnscannedEntries.push_back(std::move(entry));
+  }
+  return r.AtEnd();
+}
+}
+
+cmDependsCDatabase::cmDependsCDatabase(std::string path, std::string settings)
+  : Path(std::move(path))
+  , Settings(std::move(settings))
+{
+}
+
+bool cmDependsCDatabase::Parse(cm::string_view payload, Content& content)
+{
+  cmBinaryCacheReader r(payload);
+  std::uint32_t numSettings;
+  if (!r.Get(numSettings)) {
+    return false;
+  }
+  for (std::uint32_t i = 0; i < numSettings; ++i) {
+    cm::string_view settings;
+    if (!r.GetString(settings)) {
+      return false;
+    }
+    content.Settings.push_back(settings);
+  }
+  std::uint32_t numRecords;
+  if (!r.Get(numRecords)) {
+    return false;
+  }
+  for (std::uint32_t i = 0; i < numRecords; ++i) {
+    Record record;
+    std::uint64_t dataSize;
+    if (!r.Get(record.Settings) || record.Settings >= numSettings ||
+        !r.GetString(record.FileName) || !r.Get(record.Stamp.MTime) ||
+        !r.Get(record.Stamp.Size) || !r.Get(dataSize) ||
+        !r.GetView(record.Data, dataSize)) {
+      return false;
+    }
+    record.Stamp.Exists = true;
+    content.Records.push_back(record);
+  }
+  while (!r.AtEnd()) {
+    Object object;
+    std::uint32_t count;
+    if (!r.Get(object.Settings) || object.Settings >= numSettings ||
+        !r.GetString(object.Name) || !r.Get(count)) {
+      return false;
+    }
+    object.Records.resize(count);
+    for (std::uint32_t& index : object.Records) {
+      if (!r.Get(index) || index >= numRecords) {
+        return false;
+      }
+    }
+    content.Objects.push_back(std::move(object));
+  }
+  return true;
+}
+
+void cmDependsCDatabase::Load()
+{
+  this->Records.clear();
+  cm::string_view payload;
+  Content content;
+  if (!cmBinaryCacheFile::Read(this->Path, Magic, this->Buffer, payload) ||
+      !Parse(payload, content)) {
+    // Missing, truncated or corrupt.  Start over.
+    this->Buffer.clear();
+    return;
+  }
+
+  // Index the records written with the settings of this scanner.
+  for (std::uint32_t i = 0; i < content.Settings.size(); ++i) {
+    if (content.Settings[i] != this->Settings) {
+      continue;
+    }
+    for (Record const& record : content.Records) {
+      if (record.Settings == i) {
+        this->Records[std::string(record.FileName.data(),
+                                  record.FileName.size())] = record;
+      }
+    }
+    break;
+  }
+}
+
+bool cmDependsCDatabase::Lookup(std::string const& fileName,
+                                IncludeLines& lines) const
+{
+  // Remember the state of the file before it is scanned so that a
+  // modification racing with the scanner can never be stored.
+  lines.Stamp = cmBinaryCacheFile::StampPath(fileName);
+  lines.Modified = lines.Stamp.Exists;
+  if (!lines.Modified) {
+    return false;
+  }
+
+  auto i = this->Records.find(fileName);
+  if (i == this->Records.end()) {
+    return false;
+  }
+  Record const& record = i->second;
+  if (record.Stamp != lines.Stamp ||
+      !DeserializeIncludes(record.Data, lines)) {
+    lines.UnscannedEntries.clear();
+    return false;
+  }
+  lines.Modified = false;
+  return true;
+}
+
+bool cmDependsCDatabase::Save(
+  std::map<std::string, IncludeLines const*> const& entries,
+  std::map<std::string, std::set<std::string>> const& objects) const
+{
+  bool modified = !objects.empty();
+  for (auto const& e : entries) {
+    if (e.second->Modified) {
+      modified = true;
+      break;
+    }
+  }
+  if (!modified) {
+    return true;
+  }
+
+#if !defined(CMAKE_BOOTSTRAP)
+  // Serialize with scanners of other targets running concurrently.
+  std::string const lockFile = cmStrCat(this->Path, ".lock");
+  if (!cmSystemTools::Touch(lockFile, true)) {
+    return false;
+  }
+  cmFileLock lock;
+  if (!lock.Lock(lockFile, static_cast<unsigned long>(-1)).IsOk()) {
+    return false;
+  }
+#endif
+
+  // Merge into the records written since this database was loaded.
+  std::string buffer;
+  cm::string_view payload;
+  Content content;
+  if (!cmBinaryCacheFile::Read(this->Path, Magic, buffer, payload) ||
+      !Parse(payload, content)) {
+    content = Content();
+  }
+
+  std::uint32_t settingsIndex = 0;
+  while (settingsIndex < content.Settings.size() &&
+         content.Settings[settingsIndex] != this->Settings) {
+    ++settingsIndex;
+  }
+  if (settingsIndex == content.Settings.size()) {
+    content.Settings.emplace_back(this->Settings);
+  }
+
+  // The files reached from each object file, replacing those of the
+  // object files scanned by this process.
+  using FileKey = std::pair<std::uint32_t, cm::string_view>;
+  std::map<cm::string_view, std::pair<std::uint32_t, std::vector<FileKey>>>
+    reached;
+  for (Object const& object : content.Objects) {
+    auto& r = reached[object.Name];
+    r.first = object.Settings;
+    for (std::uint32_t index : object.Records) {
+      Record const& record = content.Records[index];
+      r.second.emplace_back(record.Settings, record.FileName);
+    }
+  }
+  for (auto const& o : objects) {
+    auto& r = reached[o.first];
+    r.first = settingsIndex;
+    r.second.clear();
+    for (std::string const& file : o.second) {
+      r.second.emplace_back(settingsIndex, file);
+    }
+  }
+  std::set<FileKey> referenced;
+  for (auto const& r : reached) {
+    referenced.insert(r.second.second.begin(), r.second.second.end());
+  }
+
+  // Keep the records of unchanged files still reached from an object
+  // file, and add those scanned by this process.  Files scanned within
+  // a second of now are not stored.
+  std::int64_t const now = cmBinaryCacheFile::Now();
+  std::vector<Record> records;
+  std::vector<std::string> scannedData;
+  scannedData.reserve(entries.size());
+  for (auto const& e : entries) {
+    IncludeLines const& lines = *e.second;
+    if (lines.Modified && cmBinaryCacheFile::IsSettled(lines.Stamp, now) &&
+        referenced.count(FileKey(settingsIndex, e.first))) {
+      scannedData.push_back(SerializeIncludes(lines));
+      Record record;
+      record.Settings = settingsIndex;
+      record.FileName = e.first;
+      record.Stamp = lines.Stamp;
+      record.Data = scannedData.back();
+      records.push_back(record);
+    }
+  }
+  for (Record const& record : content.Records) {
+    if (!referenced.count(FileKey(record.Settings, record.FileName))) {
+      continue;
+    }
+    if (record.Settings == settingsIndex) {
+      auto const i = entries.find(
+        std::string(record.FileName.data(), record.FileName.size()));
+      if (i != entries.end()) {
+        // Unchanged if it was restored from this record.  Otherwise it
+        // is stale, and replaced above unless scanned too recently.
+        if (!i->second->Modified) {
+          records.push_back(record);
+        }
+        continue;
+      }
+    }
+    if (cmBinaryCacheFile::StampPath(std::string(record.FileName.data(),
+                                                 record.FileName.size())) ==
+        record.Stamp) {
+      records.push_back(record);
+    }
+  }
+
+  std::map<FileKey, std::uint32_t> indices;
+  std::string out;
+  cmBinaryCacheWriter w(out);
+  cmBinaryCacheFile::WriteHeader(out, Magic);
+  w.Put(static_cast<std::uint32_t>(content.Settings.size()));
+  for (cm::string_view settings : content.Settings) {
+    w.PutString(settings);
+  }
+  w.Put(static_cast<std::uint32_t>(records.size()));
+  for (Record const& record : records) {
+    indices.emplace(FileKey(record.Settings, record.FileName),
+                    static_cast<std::uint32_t>(indices.size()));
+    w.Put(record.Settings);
+    w.PutString(record.FileName);
+    w.Put(record.Stamp.MTime);
+    w.Put(record.Stamp.Size);
+    w.Put(static_cast<std::uint64_t>(record.Data.size()));
+    out.append(record.Data.data(), record.Data.size());
+  }
+  std::vector<std::uint32_t> objectRecords;
+  for (auto const& r : reached) {
+    objectRecords.clear();
+    for (FileKey const& file : r.second.second) {
+      auto const i = indices.find(file);
+      if (i != indices.end()) {
+        objectRecords.push_back(i->second);
+      }
+    }
+    if (objectRecords.empty()) {
+      continue;
+    }
+    w.Put(r.second.first);
+    w.PutString(r.first);
+    w.Put(static_cast<std::uint32_t>(objectRecords.size()));
+    for (std::uint32_t index : objectRecords) {
+      w.Put(index);
+    }
+  }
+
+  return cmBinaryCacheFile::Write(this->Path, out);
+}
@@ -0,0 +1,96 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmDependsCDatabase_h
+#define cmDependsCDatabase_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cm/string_view>
+
+#include "cmBinaryCacheFile.h"
+#include "cmDependsC.h"
+
+/** \class cmDependsCDatabase
+ * \brief Persist the include lines of files scanned by cmDependsC.
+ *
+ * The include lines found in every file scanned for dependencies are
+ * stored in a single binary file per build tree, shared by all targets
+ * and languages.  Each record is keyed by the scanner settings in
+ * effect, the full path of the file and its modification time and
+ * size, so a header scanned for one target is reused by every other
+ * target as long as it is unchanged.
+ *
+ * The on-disk data is a table of scanner settings, a sequence of
+ * length-prefixed records, and the records reached from each object
+ * file, read into memory in one piece.  Records are only decoded when
+ * they are looked up.  Saving merges the records scanned by this
+ * process into the current content of the file, so concurrent scans of
+ * different targets do not drop each other's results, and drops the
+ * records of files that changed, vanished, or are no longer reached
+ * from any object file.
+ */
+class cmDependsCDatabase
+{
+public:
+  using IncludeLines = cmDependsC::cmIncludeLines;
+
+  cmDependsCDatabase(std::string path, std::string settings);
+
+  cmDependsCDatabase(cmDependsCDatabase const&) = delete;
+  cmDependsCDatabase& operator=(cmDependsCDatabase const&) = delete;
+
+  /** Read the database.  Missing, corrupt, or foreign database files
+      are silently ignored.  */
+  void Load();
+
+  /** Store the current state of the given file in lines and restore its
+      include lines if they were recorded for the same state.  May be
+      called concurrently.  */
+  bool Lookup(std::string const& fileName, IncludeLines& lines) const;
+
+  /** Merge the given entries marked as modified into the database.  The
+      objects map each object file scanned by this process to the files
+      its walk reached, replacing those recorded before.  */
+  bool Save(std::map<std::string, IncludeLines const*> const& entries,
+            std::map<std::string, std::set<std::string>> const& objects)
+    const;
+
+private:
+  struct Record
+  {
+    std::uint32_t Settings = 0;
+    cm::string_view FileName;
+    cmBinaryCacheFile::Stamp Stamp;
+    cm::string_view Data;
+  };
+
+  struct Object
+  {
+    std::uint32_t Settings = 0;
+    cm::string_view Name;
+    std::vector<std::uint32_t> Records;
+  };
+
+  struct Content
+  {
+    std::vector<cm::string_view> Settings;
+    std::vector<Record> Records;
+    std::vector<Object> Objects;
+  };
+
+  static bool Parse(cm::string_view payload, Content& content);
+
+  std::string Path;
+  std::string Settings;
+  std::string Buffer;
+  std::unordered_map<std::string, Record> Records;
+};
+
+#endif
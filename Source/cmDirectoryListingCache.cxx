@@ -0,0 +1,237 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmDirectoryListingCache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "cm_uv.h"
+
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+cmDirectoryListingCache::cmDirectoryListingCache() = default;
+
+cmDirectoryListingCache::~cmDirectoryListingCache() = default;
+
+bool cmDirectoryListingCache::FileExists(std::string const& path, bool isFile)
+{
+  Type const type = this->GetType(path);
+  return type == Type::File || (type == Type::Directory && !isFile);
+}
+
+bool cmDirectoryListingCache::FileIsDirectory(std::string const& path)
+{
+  return this->GetType(path) == Type::Directory;
+}
+
+std::vector<std::string> cmDirectoryListingCache::GetDirectoryContent(
+  std::string const& dir)
+{
+  ++this->Lookups;
+  std::string d = dir;
+  while (d.size() > 1 && d.back() == '/' && d[d.size() - 2] != ':') {
+    d.pop_back();
+  }
+  if (!this->Enabled || !IsCacheable(d)) {
+    this->RecordUncached();
+    Listing listing;
+    this->ReadListing(d, listing);
+    return std::move(listing.Names);
+  }
+  return this->GetListing(d).Names;
+}
+
+void cmDirectoryListingCache::Invalidate(std::string const& path)
+{
+  std::string const p = cmSystemTools::CollapseFullPath(path);
+
+  // The path itself and the entries below it.
+  std::string const prefix = cmHasSuffix(p, '/') ? p : p + '/';
+  for (auto i = this->Directories.lower_bound(p);
+       i != this->Directories.end() && cmHasPrefix(i->first, p);) {
+    if (i->first.size() == p.size() || cmHasPrefix(i->first, prefix)) {
+      i = this->Directories.erase(i);
+    } else {
+      ++i;
+    }
+  }
+
+  // The directories containing it.  Creating a file may create missing
+  // directories on the way, so all of them may change.
+  std::string dir = p;
+  for (;;) {
+    std::string parent = cmSystemTools::GetFilenamePath(dir);
+    if (parent.empty() || parent == dir) {
+      break;
+    }
+    this->Directories.erase(parent);
+    dir = std::move(parent);
+  }
+}
+
+void cmDirectoryListingCache::Clear()
+{
+  this->Directories.clear();
+}
+
+void cmDirectoryListingCache::SetEnabled(bool enabled)
+{
+  this->Enabled = enabled;
+  this->Clear();
+}
+
+void cmDirectoryListingCache::StartRecording(Recording& recording)
+{
+  recording.Outer = this->Active;
+  this->Active = &recording;
+}
+
+void cmDirectoryListingCache::StopRecording(Recording& recording)
+{
+  this->Active = recording.Outer;
+  if (this->Active) {
+    this->Active->Directories.insert(recording.Directories.begin(),
+                                     recording.Directories.end());
+    this->Active->Complete = this->Active->Complete && recording.Complete;
+  }
+}
+
+void cmDirectoryListingCache::RecordUncached()
+{
+  if (this->Active) {
+    this->Active->Complete = false;
+  }
+}
+
+void cmDirectoryListingCache::ResetCounters()
+{
+  this->Lookups = 0;
+  this->Listings = 0;
+  this->Stats = 0;
+}
+
+cmDirectoryListingCache::Type cmDirectoryListingCache::GetType(
+  std::string const& path)
+{
+  ++this->Lookups;
+  if (!this->Enabled || !IsCacheable(path)) {
+    this->RecordUncached();
+    return this->Stat(path);
+  }
+
+  // Split off the last component, ignoring trailing slashes.
+  std::string::size_type end = path.size();
+  while (end > 1 && path[end - 1] == '/') {
+    --end;
+  }
+  std::string::size_type const slash = path.rfind('/', end - 1);
+  if (slash == std::string::npos || slash + 1 == end) {
+    this->RecordUncached();
+    return this->Stat(path);
+  }
+  std::string dir = path.substr(0, slash);
+  if (dir.empty() || dir.back() == ':') {
+    dir += '/';
+  }
+
+  Listing& listing = this->GetListing(dir);
+  if (!listing.Exists) {
+    return Type::Missing;
+  }
+  std::string const name = path.substr(slash + 1, end - slash - 1);
+  auto i = listing.Entries.find(name);
+  if (i == listing.Entries.end()) {
+#if defined(_WIN32) || defined(__APPLE__)
+    // The file system may not distinguish case.
+    if (listing.LowerNames.count(cmSystemTools::LowerCase(name))) {
+      return this->Stat(path);
+    }
+#endif
+    return Type::Missing;
+  }
+  if (i->second == Type::Unknown) {
+    i->second = this->Stat(path);
+  }
+  return i->second;
+}
+
+cmDirectoryListingCache::Type cmDirectoryListingCache::Stat(
+  std::string const& path)
+{
+  ++this->Stats;
+  uv_fs_t req;
+  Type type = Type::Missing;
+  if (uv_fs_stat(nullptr, &req, path.c_str(), nullptr) == 0) {
+    type = (req.statbuf.st_mode & S_IFMT) == S_IFDIR ? Type::Directory
+                                                     : Type::File;
+  }
+  uv_fs_req_cleanup(&req);
+  return type;
+}
+
+cmDirectoryListingCache::Listing& cmDirectoryListingCache::GetListing(
+  std::string const& dir)
+{
+  if (this->Active) {
+    this->Active->Directories.insert(dir);
+  }
+  auto i = this->Directories.find(dir);
+  if (i == this->Directories.end()) {
+    i = this->Directories.emplace(dir, Listing()).first;
+    this->ReadListing(dir, i->second);
+  }
+  return i->second;
+}
+
+void cmDirectoryListingCache::ReadListing(std::string const& dir,
+                                          Listing& listing)
+{
+  ++this->Listings;
+  listing = Listing();
+  uv_fs_t req;
+  if (uv_fs_scandir(nullptr, &req, dir.c_str(), 0, nullptr) >= 0) {
+    listing.Exists = true;
+    uv_dirent_t entry;
+    while (uv_fs_scandir_next(&req, &entry) == 0) {
+      Type type = Type::Unknown;
+      if (entry.type == UV_DIRENT_FILE) {
+        type = Type::File;
+      } else if (entry.type == UV_DIRENT_DIR) {
+        type = Type::Directory;
+      }
+      listing.Entries.emplace(entry.name, type);
+      listing.Names.emplace_back(entry.name);
+#if defined(_WIN32) || defined(__APPLE__)
+      listing.LowerNames.insert(cmSystemTools::LowerCase(entry.name));
+#endif
+    }
+    std::sort(listing.Names.begin(), listing.Names.end());
+  }
+  uv_fs_req_cleanup(&req);
+}
+
+bool cmDirectoryListingCache::IsCacheable(std::string const& path)
+{
+  if (!cmSystemTools::FileIsFullPath(path) ||
+      path.find('\\') != std::string::npos) {
+    return false;
+  }
+  // Reject "." and ".." components and repeated slashes, which would
+  // not match the collapsed paths invalidated after writes.
+  std::string::size_type start = 0;
+  for (;;) {
+    std::string::size_type const slash = path.find('/', start);
+    std::string::size_type const len =
+      (slash == std::string::npos ? path.size() : slash) - start;
+    if ((len == 0 && start > 1 && slash != std::string::npos) ||
+        (len == 1 && path[start] == '.') ||
+        (len == 2 && path[start] == '.' && path[start + 1] == '.')) {
+      return false;
+    }
+    if (slash == std::string::npos) {
+      return true;
+    }
+    start = slash + 1;
+  }
+}
@@ -0,0 +1,124 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmDirectoryListingCache_h
+#define cmDirectoryListingCache_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#if defined(_WIN32) || defined(__APPLE__)
+#  include <unordered_set>
+#endif
+
+/** \class cmDirectoryListingCache
+ * \brief Answer the file queries of the find commands from directory
+ *        listings read once per configure step.
+ *
+ * The cache is enabled only while the project is configured.  Queries
+ * made at other times go straight to the file system.  While enabled,
+ * the first query for a path reads the listing of its parent directory,
+ * and later queries for entries of the same directory are answered from
+ * memory.  A directory that does not exist costs one failed read no
+ * matter how many of its entries are queried.  Entries whose type the
+ * listing does not tell, such as symbolic links, are resolved with a
+ * stat the first time they are queried.  Paths that are relative or
+ * contain "." or ".." components are passed to the file system.
+ *
+ * The cache does not notice changes by itself.  Commands writing files
+ * during the configure step invalidate the affected listings, and those
+ * running arbitrary external processes clear the cache.
+ */
+class cmDirectoryListingCache
+{
+public:
+  cmDirectoryListingCache();
+  ~cmDirectoryListingCache();
+
+  cmDirectoryListingCache(cmDirectoryListingCache const&) = delete;
+  cmDirectoryListingCache& operator=(cmDirectoryListingCache const&) =
+    delete;
+
+  /** Return true if the path names an existing file or directory,
+      following symbolic links.  If isFile is true, return false for
+      directories.  */
+  bool FileExists(std::string const& path, bool isFile = false);
+
+  /** Return true if the path names an existing directory, following
+      symbolic links.  */
+  bool FileIsDirectory(std::string const& path);
+
+  /** Return the sorted names of the entries of a directory, or an empty
+      list if it cannot be read.  */
+  std::vector<std::string> GetDirectoryContent(std::string const& dir);
+
+  /** Forget everything known about the given path, the directories
+      containing it, and the entries below it.  */
+  void Invalidate(std::string const& path);
+
+  /** Forget everything.  */
+  void Clear();
+
+  /** Enable or disable the cache.  Disabling it forgets everything.  */
+  void SetEnabled(bool enabled);
+
+  /** The directories whose listings answered queries while a recording
+      was active.  Complete is false if some query bypassed the cache.  */
+  struct Recording
+  {
+    std::set<std::string> Directories;
+    bool Complete = true;
+    Recording* Outer = nullptr;
+  };
+
+  /** Record queries into the given recording until StopRecording.
+      Recordings may nest; an inner recording is merged into the outer
+      one when it stops.  */
+  void StartRecording(Recording& recording);
+  void StopRecording(Recording& recording);
+
+  /** Tell the active recording that a query bypassed the cache.  */
+  void RecordUncached();
+
+  unsigned long GetLookups() const { return this->Lookups; }
+  unsigned long GetListings() const { return this->Listings; }
+  unsigned long GetStats() const { return this->Stats; }
+  void ResetCounters();
+
+private:
+  enum class Type
+  {
+    Unknown,
+    File,
+    Directory,
+    Missing
+  };
+
+  struct Listing
+  {
+    bool Exists = false;
+    std::unordered_map<std::string, Type> Entries;
+    std::vector<std::string> Names;
+#if defined(_WIN32) || defined(__APPLE__)
+    std::unordered_set<std::string> LowerNames;
+#endif
+  };
+
+  Type GetType(std::string const& path);
+  Type Stat(std::string const& path);
+  Listing& GetListing(std::string const& dir);
+  void ReadListing(std::string const& dir, Listing& listing);
+  static bool IsCacheable(std::string const& path);
+
+  bool Enabled = false;
+  Recording* Active = nullptr;
+  std::map<std::string, Listing> Directories;
+  unsigned long Lookups = 0;
+  unsigned long Listings = 0;
+  unsigned long Stats = 0;
+};
+
+#endif
@@ -6,11 +6,13 @@
 
 #include "cmsys/Process.h"
 
+#include "cmDirectoryListingCache.h"
 #include "cmExecutionStatus.h"
 #include "cmMakefile.h"
 #include "cmProcessOutput.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
+#include "cmake.h"
 
 using Encoding = cmProcessOutput::Encoding;
 
@@ -88,6 +90,11 @@ bool cmExecProgramCommand(std::vector<std::string> const& args,
   int retVal = 0;
   std::string output;
   bool result = true;
+  // The program may change any file the find commands look for.
+  status.GetMakefile()
+    .GetCMakeInstance()
+    ->GetDirectoryListingCache()
+    ->Clear();
   if (args.size() - count == 2) {
     cmSystemTools::MakeDirectory(args[1]);
     result = RunCommand(command, output, retVal, args[1].c_str(), verbose);
@@ -15,12 +15,14 @@
 
 #include "cmAlgorithms.h"
 #include "cmArgumentParser.h"
+#include "cmDirectoryListingCache.h"
 #include "cmExecutionStatus.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmProcessOutput.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
+#include "cmake.h"
 
 namespace {
 bool cmExecuteProcessCommandIsWhitespace(char c)
@@ -225,6 +227,12 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
       std::cerr << command;
     }
   }
+  // The processes may change any file the find commands look for.
+  status.GetMakefile()
+    .GetCMakeInstance()
+    ->GetDirectoryListingCache()
+    ->Clear();
+
   // Start the process.
   cmsysProcess_Execute(cp);
 
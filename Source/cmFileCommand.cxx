@@ -27,6 +27,7 @@
 #include "cmAlgorithms.h"
 #include "cmArgumentParser.h"
 #include "cmCryptoHash.h"
+#include "cmDirectoryListingCache.h"
 #include "cmExecutionStatus.h"
 #include "cmFileCopier.h"
 #include "cmFileInstaller.h"
@@ -90,6 +91,16 @@ std::string fix_file_url_windows(const std::string& url)
 }
 #endif
 
+// Tell the find commands that the entries at a path may have changed.
+void InvalidateDirectoryListings(cmExecutionStatus& status,
+                                 std::string const& path)
+{
+  status.GetMakefile()
+    .GetCMakeInstance()
+    ->GetDirectoryListingCache()
+    ->Invalidate(path);
+}
+
 bool HandleWriteImpl(std::vector<std::string> const& args, bool append,
                      cmExecutionStatus& status)
 {
@@ -114,6 +125,7 @@ bool HandleWriteImpl(std::vector<std::string> const& args, bool append,
   }
   std::string dir = cmSystemTools::GetFilenamePath(fileName);
   cmSystemTools::MakeDirectory(dir);
+  InvalidateDirectoryListings(status, fileName);
 
   mode_t mode = 0;
   bool writable = false;
@@ -862,6 +874,7 @@ bool HandleMakeDirectoryCommand(std::vector<std::string> const& args,
       cmSystemTools::SetFatalErrorOccured();
       return false;
     }
+    InvalidateDirectoryListings(status, *cdir);
     if (!cmSystemTools::MakeDirectory(*cdir)) {
       std::string error = "problem creating directory: " + *cdir;
       status.SetError(error);
@@ -892,6 +905,7 @@ bool HandleTouchImpl(std::vector<std::string> const& args, bool create,
       cmSystemTools::SetFatalErrorOccured();
       return false;
     }
+    InvalidateDirectoryListings(status, tfile);
     if (!cmSystemTools::Touch(tfile, create)) {
       std::string error = "problem touching file: " + tfile;
       status.SetError(error);
@@ -969,7 +983,13 @@ bool HandleCopyCommand(std::vector<std::string> const& args,
                        cmExecutionStatus& status)
 {
   cmFileCopier copier(status);
-  return copier.Run(args);
+  bool const result = copier.Run(args);
+  // The copier may create any number of files and directories.
+  status.GetMakefile()
+    .GetCMakeInstance()
+    ->GetDirectoryListingCache()
+    ->Clear();
+  return result;
 }
 
 bool HandleRPathChangeCommand(std::vector<std::string> const& args,
@@ -1150,6 +1170,7 @@ bool HandleRPathCheckCommand(std::vector<std::string> const& args,
   if (cmSystemTools::FileExists(file, true) &&
       !cmSystemTools::CheckRPath(file, rpath)) {
     cmSystemTools::RemoveFile(file);
+    InvalidateDirectoryListings(status, file);
   }
 
   return true;
@@ -1219,7 +1240,13 @@ bool HandleInstallCommand(std::vector<std::string> const& args,
                           cmExecutionStatus& status)
 {
   cmFileInstaller installer(status);
-  return installer.Run(args);
+  bool const result = installer.Run(args);
+  // The installer may create any number of files and directories.
+  status.GetMakefile()
+    .GetCMakeInstance()
+    ->GetDirectoryListingCache()
+    ->Clear();
+  return result;
 }
 
 bool HandleRelativePathCommand(std::vector<std::string> const& args,
@@ -1273,6 +1300,8 @@ bool HandleRename(std::vector<std::string> const& args,
       cmStrCat(status.GetMakefile().GetCurrentSourceDirectory(), '/', args[2]);
   }
 
+  InvalidateDirectoryListings(status, oldname);
+  InvalidateDirectoryListings(status, newname);
   if (!cmSystemTools::RenameFile(oldname, newname)) {
     std::string err = cmSystemTools::GetLastSystemError();
     status.SetError(cmStrCat("RENAME failed to rename\n  ", oldname,
@@ -1303,6 +1332,7 @@ bool HandleRemoveImpl(std::vector<std::string> const& args, bool recurse,
         cmStrCat(status.GetMakefile().GetCurrentSourceDirectory(), '/', arg);
     }
 
+    InvalidateDirectoryListings(status, fileName);
     if (cmSystemTools::FileIsDirectory(fileName) &&
         !cmSystemTools::FileIsSymlink(fileName) && recurse) {
       cmSystemTools::RepeatedRemoveDirectory(fileName);
@@ -1707,6 +1737,7 @@ bool HandleDownloadCommand(std::vector<std::string> const& args,
   // as we receive downloaded bits from curl...
   //
   std::string dir = cmSystemTools::GetFilenamePath(file);
+  InvalidateDirectoryListings(status, file);
   if (!cmSystemTools::FileExists(dir) && !cmSystemTools::MakeDirectory(dir)) {
     std::string errstring = "DOWNLOAD error: cannot create directory '" + dir +
       "' - Specify file by full path name and verify that you "
@@ -2330,6 +2361,7 @@ bool HandleLockCommand(std::vector<std::string> const& args,
 
   // Create file and directories if needed
   std::string parentDir = cmSystemTools::GetParentDirectory(path);
+  InvalidateDirectoryListings(status, path);
   if (!cmSystemTools::MakeDirectory(parentDir)) {
     status.GetMakefile().IssueMessage(
       MessageType::FATAL_ERROR,
@@ -2548,6 +2580,8 @@ bool HandleCreateLinkCommand(std::vector<std::string> const& args,
     return false;
   }
 
+  InvalidateDirectoryListings(status, newFileName);
+
   // Check if the new file already exists and remove it.
   if ((cmSystemTools::FileExists(newFileName) ||
        cmSystemTools::FileIsSymlink(newFileName)) &&
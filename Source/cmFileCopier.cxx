@@ -17,8 +17,18 @@
 #  include "cmsys/FStream.hxx"
 #endif
 
+#if !defined(CMAKE_BOOTSTRAP)
+#  include "cmWorkerPool.h"
+#  include "cmake.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <functional>
 #include <sstream>
+#include <thread>
+#include <utility>
 
 using namespace cmFSPermissions;
 
@@ -30,6 +40,7 @@ cmFileCopier::cmFileCopier(cmExecutionStatus& status, const char* name)
   , MatchlessFiles(true)
   , FilePermissions(0)
   , DirPermissions(0)
+  , ParallelLevel(1)
   , CurrentMatchRule(nullptr)
   , UseGivenPermissionsFile(false)
   , UseGivenPermissionsDir(false)
@@ -437,10 +448,12 @@ bool cmFileCopier::Run(std::vector<std::string> const& args)
     }
 
     if (!this->Install(fromFile, toFile)) {
+      // Do not leave the files already reported behind half-copied.
+      this->FinishPendingCopies();
       return false;
     }
   }
-  return true;
+  return this->FinishPendingCopies();
 }
 
 bool cmFileCopier::Install(const std::string& fromFile,
@@ -507,7 +520,11 @@ bool cmFileCopier::InstallSymlinkChain(std::string& fromFile,
       }
     }
 
-    this->ReportCopy(toFile, TypeLink, copy);
+    this->Report(toFile, TypeLink, copy);
+
+    if (copy && !this->FinishPendingCopy(toFile)) {
+      return false;
+    }
 
     if (copy) {
       cmSystemTools::RemoveFile(toFile);
@@ -556,7 +573,11 @@ bool cmFileCopier::InstallSymlink(const std::string& fromFile,
   }
 
   // Inform the user about this file installation.
-  this->ReportCopy(toFile, TypeLink, copy);
+  this->Report(toFile, TypeLink, copy);
+
+  if (copy && !this->FinishPendingCopy(toFile)) {
+    return false;
+  }
 
   if (copy) {
     // Remove the destination file so we can always create the symlink.
@@ -583,54 +604,210 @@ bool cmFileCopier::InstallFile(const std::string& fromFile,
                                const std::string& toFile,
                                MatchProperties match_properties)
 {
+  // A previous copy to the same destination must complete first.
+  if (!this->FinishPendingCopy(toFile)) {
+    return false;
+  }
+
+  PendingCopy pending;
+  pending.FromFile = fromFile;
+  pending.ToFile = toFile;
+
   // Determine whether we will copy the file.
-  bool copy = true;
+  pending.Copy = true;
   if (!this->Always) {
     // If both files exist with the same time do not copy.
     if (!this->FileTimes.DifferS(fromFile, toFile)) {
-      copy = false;
+      pending.Copy = false;
     }
   }
+  pending.CopyTimes = pending.Copy && !this->Always;
+
+  // Compute the permissions of the destination file.
+  pending.Permissions =
+    (match_properties.Permissions ? match_properties.Permissions
+                                  : this->FilePermissions);
+  if (!pending.Permissions) {
+    // No permissions were explicitly provided but the user requested
+    // that the source file permissions be used.
+    cmSystemTools::GetPermissions(fromFile, pending.Permissions);
+  }
+
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->ParallelLevel > 1) {
+    // The file is reported once its copy has succeeded.
+    pending.Deferred = true;
+    this->PendingDestinations.insert(toFile);
+    this->PendingCopies.push_back(std::move(pending));
+    return true;
+  }
+#endif
 
   // Inform the user about this file installation.
-  this->ReportCopy(toFile, TypeFile, copy);
+  this->ReportCopy(toFile, TypeFile, pending.Copy);
+
+  if (!this->CopyContent(pending)) {
+    this->Status.SetError(pending.Error);
+    return false;
+  }
 
-  // Copy the file.
-  if (copy && !cmSystemTools::CopyAFile(fromFile, toFile, true)) {
+  // Set permissions of the destination file.
+  return this->SetPermissions(toFile, pending.Permissions);
+}
+
+bool cmFileCopier::CopyContent(PendingCopy& pending) const
+{
+  // Copy the file.  A destination with only a different time stamp
+  // keeps its content if the fingerprint cache knows it is identical.
+  bool const sameContent = pending.CopyTimes &&
+    cmSystemTools::GetFileFingerprintCache() &&
+    !cmSystemTools::FilesDiffer(pending.FromFile, pending.ToFile);
+  if (pending.Copy && !sameContent &&
+      !cmSystemTools::CopyAFile(pending.FromFile, pending.ToFile, true)) {
     std::ostringstream e;
-    e << this->Name << " cannot copy file \"" << fromFile << "\" to \""
-      << toFile << "\": " << cmSystemTools::GetLastSystemError() << ".";
-    this->Status.SetError(e.str());
+    e << this->Name << " cannot copy file \"" << pending.FromFile
+      << "\" to \"" << pending.ToFile
+      << "\": " << cmSystemTools::GetLastSystemError() << ".";
+    pending.Error = e.str();
     return false;
   }
 
   // Set the file modification time of the destination file.
-  if (copy && !this->Always) {
+  if (pending.CopyTimes) {
     // Add write permission so we can set the file time.
-    // Permissions are set unconditionally below anyway.
+    // Permissions are set unconditionally afterwards anyway.
     mode_t perm = 0;
-    if (cmSystemTools::GetPermissions(toFile, perm)) {
-      cmSystemTools::SetPermissions(toFile, perm | mode_owner_write);
+    if (cmSystemTools::GetPermissions(pending.ToFile, perm)) {
+      cmSystemTools::SetPermissions(pending.ToFile, perm | mode_owner_write);
     }
-    if (!cmFileTimes::Copy(fromFile, toFile)) {
+    if (!cmFileTimes::Copy(pending.FromFile, pending.ToFile)) {
       std::ostringstream e;
-      e << this->Name << " cannot set modification time on \"" << toFile
+      e << this->Name << " cannot set modification time on \""
+        << pending.ToFile
         << "\": " << cmSystemTools::GetLastSystemError() << ".";
-      this->Status.SetError(e.str());
+      pending.Error = e.str();
       return false;
     }
   }
+  return true;
+}
 
-  // Set permissions of the destination file.
-  mode_t permissions =
-    (match_properties.Permissions ? match_properties.Permissions
-                                  : this->FilePermissions);
-  if (!permissions) {
-    // No permissions were explicitly provided but the user requested
-    // that the source file permissions be used.
-    cmSystemTools::GetPermissions(fromFile, permissions);
+void cmFileCopier::CompletePendingCopy(PendingCopy& pending) const
+{
+  if (!this->CopyContent(pending)) {
+    return;
+  }
+  if (pending.Permissions &&
+      !cmSystemTools::SetPermissions(pending.ToFile, pending.Permissions)) {
+    std::ostringstream e;
+    e << this->Name << " cannot set permissions on \"" << pending.ToFile
+      << "\": " << cmSystemTools::GetLastSystemError() << ".";
+    pending.Error = e.str();
+  }
+}
+
+#if !defined(CMAKE_BOOTSTRAP)
+namespace {
+class CopyJob : public cmWorkerPool::JobT
+{
+public:
+  CopyJob(std::function<void()> copy)
+    : Copy(std::move(copy))
+  {
+  }
+
+private:
+  void Process() override { this->Copy(); }
+
+  std::function<void()> Copy;
+};
+}
+#endif
+
+bool cmFileCopier::FinishPendingCopies()
+{
+  std::vector<PendingCopy> copies = std::move(this->PendingCopies);
+  this->PendingCopies.clear();
+  this->PendingDestinations.clear();
+  if (copies.empty()) {
+    return true;
+  }
+
+#if !defined(CMAKE_BOOTSTRAP)
+  size_t const deferred = static_cast<size_t>(
+    std::count_if(copies.begin(), copies.end(),
+                  [](PendingCopy const& pending) { return pending.Deferred; }));
+  unsigned int const threads =
+    static_cast<unsigned int>(std::min<size_t>(this->ParallelLevel, deferred));
+  if (threads > 1) {
+    std::thread::id const mainThread = std::this_thread::get_id();
+    std::atomic<size_t> onWorkers(0);
+    cmWorkerPool pool;
+    pool.SetThreadCount(threads);
+    for (PendingCopy& pending : copies) {
+      if (pending.Deferred) {
+        pool.EmplaceJob<CopyJob>([this, &pending, &onWorkers, mainThread]() {
+          if (std::this_thread::get_id() != mainThread) {
+            ++onWorkers;
+          }
+          this->CompletePendingCopy(pending);
+        });
+      }
+    }
+    pool.EmplaceJob<cmWorkerPool::JobEndT>();
+    pool.Process();
+    if (this->Makefile->GetCMakeInstance()->GetLogLevel() >=
+        cmake::LogLevel::LOG_DEBUG) {
+      this->Makefile->DisplayStatus(
+        cmStrCat(this->Name, " copied ", onWorkers.load(), " of ", deferred,
+                 " files on ", threads, " worker threads"),
+        -1);
+    }
+  } else
+#endif
+  {
+    for (PendingCopy& pending : copies) {
+      if (pending.Deferred) {
+        this->CompletePendingCopy(pending);
+      }
+    }
   }
-  return this->SetPermissions(toFile, permissions);
+
+  // Report the files in the order they were visited, up to the first
+  // failure.
+  for (PendingCopy const& pending : copies) {
+    if (!pending.Error.empty()) {
+      if (this->Status.GetError().empty()) {
+        this->Status.SetError(pending.Error);
+      }
+      return false;
+    }
+    this->ReportCopy(pending.ToFile, pending.ReportType, pending.Copy);
+  }
+  return true;
+}
+
+bool cmFileCopier::FinishPendingCopy(const std::string& toFile)
+{
+  if (this->PendingDestinations.find(toFile) ==
+      this->PendingDestinations.end()) {
+    return true;
+  }
+  return this->FinishPendingCopies();
+}
+
+void cmFileCopier::Report(const std::string& toFile, Type type, bool copy)
+{
+  if (this->PendingCopies.empty()) {
+    this->ReportCopy(toFile, type, copy);
+    return;
+  }
+  // Keep the order with the files whose copies are still pending.
+  PendingCopy report;
+  report.ToFile = toFile;
+  report.ReportType = type;
+  report.Copy = copy;
+  this->PendingCopies.push_back(std::move(report));
 }
 
 bool cmFileCopier::InstallDirectory(const std::string& source,
@@ -638,8 +815,8 @@ bool cmFileCopier::InstallDirectory(const std::string& source,
                                     MatchProperties match_properties)
 {
   // Inform the user about this directory installation.
-  this->ReportCopy(destination, TypeDir,
-                   !cmSystemTools::FileIsDirectory(destination));
+  this->Report(destination, TypeDir,
+               !cmSystemTools::FileIsDirectory(destination));
 
   // check if default dir creation permissions were set
   mode_t default_dir_mode_v = 0;
@@ -706,6 +883,12 @@ bool cmFileCopier::InstallDirectory(const std::string& source,
     }
   }
 
+  // Files may not be copied into the destination directory after
+  // the temporary permissions are removed.
+  if (permissions_after && !this->FinishPendingCopies()) {
+    return false;
+  }
+
   // Set the requested permissions of the destination directory.
   return this->SetPermissions(destination, permissions_after);
 }
@@ -6,6 +6,7 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "cmsys/RegularExpression.hxx"
@@ -66,6 +67,43 @@ protected:
   // Translate an argument to a permissions bit.
   bool CheckPermissions(std::string const& arg, mode_t& permissions);
 
+  enum Type
+  {
+    TypeFile,
+    TypeDir,
+    TypeLink
+  };
+
+  // File copies deferred to worker threads when ParallelLevel > 1.
+  // A file is reported, and so added to the manifest, only once its
+  // copy succeeded.  Links and directories visited meanwhile are queued
+  // as report-only entries to keep the messages in the visiting order.
+  struct PendingCopy
+  {
+    std::string FromFile;
+    std::string ToFile;
+    Type ReportType = TypeFile;
+    bool Deferred = false;
+    bool Copy = false;
+    bool CopyTimes = false;
+    mode_t Permissions = 0;
+    std::string Error;
+  };
+  unsigned int ParallelLevel;
+  std::vector<PendingCopy> PendingCopies;
+  std::unordered_set<std::string> PendingDestinations;
+
+  // Perform the copy and time stamp update of a file installation.
+  bool CopyContent(PendingCopy& pending) const;
+
+  // Complete a deferred copy on a worker thread.
+  void CompletePendingCopy(PendingCopy& pending) const;
+
+  // Wait for the deferred copies, e.g. before the destination is
+  // modified again or made read-only.
+  bool FinishPendingCopies();
+  bool FinishPendingCopy(const std::string& toFile);
+
   bool InstallSymlinkChain(std::string& fromFile, std::string& toFile);
   bool InstallSymlink(const std::string& fromFile, const std::string& toFile);
   bool InstallFile(const std::string& fromFile, const std::string& toFile,
@@ -76,12 +114,7 @@ protected:
   virtual bool Install(const std::string& fromFile, const std::string& toFile);
   virtual std::string const& ToName(std::string const& fromName);
 
-  enum Type
-  {
-    TypeFile,
-    TypeDir,
-    TypeLink
-  };
+  void Report(const std::string& toFile, Type type, bool copy);
   virtual void ReportCopy(const std::string&, Type, bool) {}
   virtual bool ReportMissing(const std::string& fromFile);
 
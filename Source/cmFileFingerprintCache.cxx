@@ -0,0 +1,269 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmFileFingerprintCache.h"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include <cm/string_view>
+
+#include "cmsys/FStream.hxx"
+
+namespace {
+
+// Bump the last byte whenever the record layout changes.
+cmBinaryCacheFile::Magic const Magic = { 'C', 'M', 'F', 'F', 'P', 'C',
+                                         '\0', '\1' };
+
+// The 64-bit xxHash algorithm, reading words in native byte order.
+// It is not a cryptographic hash but is fast and well distributed.
+class ContentHash
+{
+public:
+  static size_t const StripeSize = 32;
+
+  ContentHash()
+  {
+    this->Lanes[0] = P1 + P2;
+    this->Lanes[1] = P2;
+    this->Lanes[2] = 0;
+    this->Lanes[3] = 0 - P1;
+  }
+
+  // Consume a whole number of stripes.
+  void Stripes(char const* data, size_t size)
+  {
+    for (char const* end = data + size; data != end; data += StripeSize) {
+      for (int i = 0; i < 4; ++i) {
+        this->Lanes[i] = Round(this->Lanes[i], Read64(data + 8 * i));
+      }
+    }
+    this->Length += size;
+  }
+
+  // Consume the last partial stripe and return the hash.
+  std::uint64_t Finish(char const* data, size_t size)
+  {
+    std::uint64_t h;
+    if (this->Length >= StripeSize) {
+      h = Rotl(this->Lanes[0], 1) + Rotl(this->Lanes[1], 7) +
+        Rotl(this->Lanes[2], 12) + Rotl(this->Lanes[3], 18);
+      for (std::uint64_t lane : this->Lanes) {
+        h = (h ^ Round(0, lane)) * P1 + P4;
+      }
+    } else {
+      h = P5;
+    }
+    h += this->Length + size;
+    char const* end = data + size;
+    for (; end - data >= 8; data += 8) {
+      h ^= Round(0, Read64(data));
+      h = Rotl(h, 27) * P1 + P4;
+    }
+    if (end - data >= 4) {
+      std::uint32_t w;
+      std::memcpy(&w, data, sizeof(w));
+      h ^= w * P1;
+      h = Rotl(h, 23) * P2 + P3;
+      data += 4;
+    }
+    for (; data != end; ++data) {
+      h ^= static_cast<unsigned char>(*data) * P5;
+      h = Rotl(h, 11) * P1;
+    }
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    return h;
+  }
+
+private:
+  static std::uint64_t const P1 = 11400714785074694791ULL;
+  static std::uint64_t const P2 = 14029467366897019727ULL;
+  static std::uint64_t const P3 = 1609587929392839161ULL;
+  static std::uint64_t const P4 = 9650029242287828579ULL;
+  static std::uint64_t const P5 = 2870177450012600261ULL;
+
+  static std::uint64_t Rotl(std::uint64_t x, int r)
+  {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  static std::uint64_t Read64(char const* p)
+  {
+    std::uint64_t w;
+    std::memcpy(&w, p, sizeof(w));
+    return w;
+  }
+
+  static std::uint64_t Round(std::uint64_t acc, std::uint64_t input)
+  {
+    acc += input * P2;
+    return Rotl(acc, 31) * P1;
+  }
+
+  std::uint64_t Lanes[4];
+  std::uint64_t Length = 0;
+};
+}
+
+cmFileFingerprintCache::cmFileFingerprintCache(std::string path)
+  : Path(std::move(path))
+{
+}
+
+void cmFileFingerprintCache::Load()
+{
+  this->Fingerprints.clear();
+  this->Modified = false;
+
+  std::string buffer;
+  cm::string_view payload;
+  if (!cmBinaryCacheFile::Read(this->Path, Magic, buffer, payload)) {
+    return;
+  }
+
+  cmBinaryCacheReader r(payload);
+  std::unordered_map<std::string, Fingerprint> fingerprints;
+  while (!r.AtEnd()) {
+    std::string fileName;
+    Fingerprint fp;
+    if (!r.GetString(fileName) || !r.Get(fp.Stamp.Size) ||
+        !r.Get(fp.Stamp.MTime) || !r.Get(fp.Stamp.Inode) ||
+        !r.Get(fp.Hash)) {
+      // Truncated or corrupt.  Start over.
+      return;
+    }
+    fp.Stamp.Exists = true;
+    fp.Stamp.Regular = true;
+    fingerprints[fileName] = fp;
+  }
+  this->Fingerprints = std::move(fingerprints);
+}
+
+bool cmFileFingerprintCache::Save() const
+{
+  bool modified = this->Modified;
+  for (auto const& f : this->Fingerprints) {
+    if (!f.second.Used) {
+      // Drop fingerprints of files no longer compared.
+      modified = true;
+      break;
+    }
+  }
+  if (!modified) {
+    return true;
+  }
+
+  std::string out;
+  cmBinaryCacheWriter w(out);
+  cmBinaryCacheFile::WriteHeader(out, Magic);
+  for (auto const& f : this->Fingerprints) {
+    if (!f.second.Used) {
+      continue;
+    }
+    w.PutString(f.first);
+    w.Put(f.second.Stamp.Size);
+    w.Put(f.second.Stamp.MTime);
+    w.Put(f.second.Stamp.Inode);
+    w.Put(f.second.Hash);
+  }
+  return cmBinaryCacheFile::Write(this->Path, out);
+}
+
+bool cmFileFingerprintCache::HashFile(std::string const& fileName,
+                                      std::uint64_t& hash)
+{
+  cmsys::ifstream fin(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+
+  // Read whole stripes so that only the last chunk has a partial one.
+  static size_t const ChunkSize = 64 * 1024;
+  static_assert(ChunkSize % ContentHash::StripeSize == 0,
+                "chunks must hold whole stripes");
+  std::unique_ptr<char[]> buffer(new char[ChunkSize]);
+  ContentHash h;
+  for (;;) {
+    fin.read(buffer.get(), ChunkSize);
+    size_t const n = static_cast<size_t>(fin.gcount());
+    if (n < ChunkSize) {
+      if (fin.bad()) {
+        return false;
+      }
+      size_t const whole = n - n % ContentHash::StripeSize;
+      h.Stripes(buffer.get(), whole);
+      hash = h.Finish(buffer.get() + whole, n - whole);
+      return true;
+    }
+    h.Stripes(buffer.get(), n);
+  }
+}
+
+bool cmFileFingerprintCache::GetHash(std::string const& fileName,
+                                     Stamp const& st, std::uint64_t& hash)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto i = this->Fingerprints.find(fileName);
+    if (i != this->Fingerprints.end()) {
+      Fingerprint& fp = i->second;
+      if (IsSame(fp.Stamp, st)) {
+        fp.Used = true;
+        hash = fp.Hash;
+        ++this->Hits;
+        return true;
+      }
+      this->Fingerprints.erase(i);
+      this->Modified = true;
+    }
+    ++this->Misses;
+  }
+
+  std::int64_t const now = cmBinaryCacheFile::Now();
+  if (!HashFile(fileName, hash)) {
+    return false;
+  }
+
+  // Only fingerprint files that have not been modified for a while and
+  // did not change while they were hashed.
+  if (cmBinaryCacheFile::IsSettled(st, now) &&
+      IsSame(cmBinaryCacheFile::StampPath(fileName), st)) {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    Fingerprint& fp = this->Fingerprints[fileName];
+    fp.Stamp = st;
+    fp.Hash = hash;
+    fp.Used = true;
+    this->Modified = true;
+  }
+  return true;
+}
+
+bool cmFileFingerprintCache::FilesDiffer(std::string const& source,
+                                         std::string const& destination)
+{
+  Stamp const sourceStat = cmBinaryCacheFile::StampPath(source);
+  Stamp const destinationStat = cmBinaryCacheFile::StampPath(destination);
+  if (!sourceStat.Regular || !destinationStat.Regular) {
+    return true;
+  }
+  if (sourceStat.Size != destinationStat.Size) {
+    return true;
+  }
+  if (sourceStat.Inode != 0 && sourceStat.Inode == destinationStat.Inode &&
+      sourceStat.Device == destinationStat.Device) {
+    return false;
+  }
+
+  std::uint64_t sourceHash;
+  std::uint64_t destinationHash;
+  if (!this->GetHash(source, sourceStat, sourceHash) ||
+      !this->GetHash(destination, destinationStat, destinationHash)) {
+    return true;
+  }
+  return sourceHash != destinationHash;
+}
@@ -0,0 +1,80 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmFileFingerprintCache_h
+#define cmFileFingerprintCache_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cmBinaryCacheFile.h"
+
+/** \class cmFileFingerprintCache
+ * \brief Compare file content using persistent content fingerprints.
+ *
+ * A fingerprint records the size, modification time and inode of a file
+ * together with a 64-bit hash of its content.  Two files are considered
+ * identical if their sizes and content hashes match, so a file whose
+ * fingerprint is still valid does not have to be read again to decide
+ * whether another file differs from it.  Typical users are the
+ * copy-if-different steps that compare freshly generated files against
+ * the unchanged outputs of a previous run.
+ *
+ * Fingerprints are stored in a single binary file in the build tree.
+ * Only files last modified more than a second before they were hashed
+ * get a fingerprint, so a file rewritten within the resolution of its
+ * time stamp is never mistaken for its earlier content.  Fingerprints
+ * not used since Load are dropped when the cache is saved.
+ */
+class cmFileFingerprintCache
+{
+public:
+  cmFileFingerprintCache(std::string path);
+
+  cmFileFingerprintCache(cmFileFingerprintCache const&) = delete;
+  cmFileFingerprintCache& operator=(cmFileFingerprintCache const&) = delete;
+
+  /** Read the cache file.  Missing, corrupt, or foreign cache files
+      are silently ignored.  */
+  void Load();
+
+  /** Write the fingerprints used since Load back to the cache file.  */
+  bool Save() const;
+
+  /** Return true if the content of the given files differs, or if
+      either cannot be read.  May be called concurrently.  */
+  bool FilesDiffer(std::string const& source, std::string const& destination);
+
+  unsigned long GetHits() const { return this->Hits; }
+  unsigned long GetMisses() const { return this->Misses; }
+
+private:
+  using Stamp = cmBinaryCacheFile::Stamp;
+
+  struct Fingerprint
+  {
+    cmBinaryCacheFile::Stamp Stamp;
+    std::uint64_t Hash = 0;
+    bool Used = false;
+  };
+
+  static bool IsSame(Stamp const& a, Stamp const& b)
+  {
+    return a == b && a.Inode == b.Inode;
+  }
+  static bool HashFile(std::string const& fileName, std::uint64_t& hash);
+  bool GetHash(std::string const& fileName, Stamp const& st,
+               std::uint64_t& hash);
+
+  std::string Path;
+  std::mutex Mutex;
+  std::unordered_map<std::string, Fingerprint> Fingerprints;
+  unsigned long Hits = 0;
+  unsigned long Misses = 0;
+  bool Modified = false;
+};
+
+#endif
@@ -31,6 +31,20 @@ cmFileInstaller::cmFileInstaller(cmExecutionStatus& status)
   if (cmSystemTools::GetEnv("CMAKE_INSTALL_ALWAYS", install_always)) {
     this->Always = cmIsOn(install_always);
   }
+  // Check whether to copy files on multiple threads.
+  unsigned long parallel = 0;
+  if (cmStrToULong(
+        this->Makefile->GetSafeDefinition("CMAKE_INSTALL_PARALLEL_LEVEL"),
+        &parallel) &&
+      parallel > 1) {
+    this->ParallelLevel = static_cast<unsigned int>(parallel);
+  }
+#ifdef _WIN32
+  // Permissions are stored in an alternate stream when cross compiling.
+  if (this->Makefile->IsOn("CMAKE_CROSSCOMPILING")) {
+    this->ParallelLevel = 1;
+  }
+#endif
   // Get the current manifest.
   this->Manifest =
     this->Makefile->GetSafeDefinition("CMAKE_INSTALL_MANIFEST_FILES");
@@ -12,6 +12,7 @@
 #include "cmMakefile.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
+#include "cmake.h"
 
 cmFindCommon::PathGroup cmFindCommon::PathGroup::All("ALL");
 cmFindCommon::PathLabel cmFindCommon::PathLabel::PackageRoot(
@@ -28,6 +29,9 @@ cmFindCommon::PathLabel cmFindCommon::PathLabel::Guess("GUESS");
 cmFindCommon::cmFindCommon(cmExecutionStatus& status)
   : Makefile(&status.GetMakefile())
   , Status(status)
+  , DirectoryListings(status.GetMakefile()
+                        .GetCMakeInstance()
+                        ->GetDirectoryListingCache())
 {
   this->FindRootPathMode = RootPathModeBoth;
   this->NoDefaultPath = false;
@@ -13,6 +13,7 @@
 #include "cmPathLabel.h"
 #include "cmSearchPath.h"
 
+class cmDirectoryListingCache;
 class cmExecutionStatus;
 class cmMakefile;
 
@@ -133,6 +134,10 @@ protected:
 
   cmMakefile* Makefile;
   cmExecutionStatus& Status;
+
+  // Directory listings shared by all find commands.  Use these instead
+  // of cmSystemTools to check for candidate files.
+  cmDirectoryListingCache* DirectoryListings;
 };
 
 #endif
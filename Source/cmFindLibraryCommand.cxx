@@ -5,17 +5,18 @@
 #include <algorithm>
 #include <cstdio>
 #include <cstring>
-#include <set>
+#include <vector>
 #include <utility>
 
 #include "cmsys/RegularExpression.hxx"
 
-#include "cmGlobalGenerator.h"
+#include "cmDirectoryListingCache.h"
 #include "cmMakefile.h"
 #include "cmState.h"
 #include "cmStateTypes.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
+#include "cmake.h"
 
 class cmExecutionStatus;
 
@@ -116,11 +117,11 @@ void cmFindLibraryCommand::AddArchitecturePath(
   if (pos != std::string::npos) {
     // Check for "lib".
     std::string lib = dir.substr(0, pos + 3);
-    bool use_lib = cmSystemTools::FileIsDirectory(lib);
+    bool use_lib = this->DirectoryListings->FileIsDirectory(lib);
 
     // Check for "lib<suffix>" and use it first.
     std::string libX = lib + suffix;
-    bool use_libX = cmSystemTools::FileIsDirectory(libX);
+    bool use_libX = this->DirectoryListings->FileIsDirectory(libX);
 
     // Avoid copies of the same directory due to symlinks.
     if (use_libX && use_lib && cmLibDirsLinked(libX, lib)) {
@@ -140,11 +141,11 @@ void cmFindLibraryCommand::AddArchitecturePath(
 
   if (fresh) {
     // Check for the original unchanged path.
-    bool use_dir = cmSystemTools::FileIsDirectory(dir);
+    bool use_dir = this->DirectoryListings->FileIsDirectory(dir);
 
     // Check for <dir><suffix>/ and use it first.
     std::string dirX = dir + suffix;
-    bool use_dirX = cmSystemTools::FileIsDirectory(dirX);
+    bool use_dirX = this->DirectoryListings->FileIsDirectory(dirX);
 
     // Avoid copies of the same directory due to symlinks.
     if (use_dirX && use_dir && cmLibDirsLinked(dirX, dir)) {
@@ -183,7 +184,7 @@ struct cmFindLibraryHelper
 
   // Context information.
   cmMakefile* Makefile;
-  cmGlobalGenerator* GG;
+  cmDirectoryListingCache* DirectoryListings;
 
   // List of valid prefixes and suffixes.
   std::vector<std::string> Prefixes;
@@ -232,7 +233,8 @@ struct cmFindLibraryHelper
 cmFindLibraryHelper::cmFindLibraryHelper(cmMakefile* mf)
   : Makefile(mf)
 {
-  this->GG = this->Makefile->GetGlobalGenerator();
+  this->DirectoryListings =
+    this->Makefile->GetCMakeInstance()->GetDirectoryListingCache();
 
   // Collect the list of library name prefixes/suffixes to try.
   std::string const& prefixes_list =
@@ -350,7 +352,7 @@ bool cmFindLibraryHelper::CheckDirectoryForName(std::string const& path,
   // library or an import library).
   if (name.TryRaw) {
     this->TestPath = cmStrCat(path, name.Raw);
-    if (cmSystemTools::FileExists(this->TestPath, true)) {
+    if (this->DirectoryListings->FileExists(this->TestPath, true)) {
       this->BestPath = cmSystemTools::CollapseFullPath(this->TestPath);
       cmSystemTools::ConvertToUnixSlashes(this->BestPath);
       return true;
@@ -366,7 +368,8 @@ bool cmFindLibraryHelper::CheckDirectoryForName(std::string const& path,
   // Search for a file matching the library name regex.
   std::string dir = path;
   cmSystemTools::ConvertToUnixSlashes(dir);
-  std::set<std::string> const& files = this->GG->GetDirectoryContent(dir);
+  std::vector<std::string> const files =
+    this->DirectoryListings->GetDirectoryContent(dir);
   for (std::string const& origName : files) {
 #if defined(_WIN32) || defined(__APPLE__)
     std::string testName = cmSystemTools::LowerCase(origName);
@@ -375,7 +378,7 @@ bool cmFindLibraryHelper::CheckDirectoryForName(std::string const& path,
 #endif
     if (name.Regex.find(testName)) {
       this->TestPath = cmStrCat(path, origName);
-      if (!cmSystemTools::FileIsDirectory(this->TestPath)) {
+      if (!this->DirectoryListings->FileIsDirectory(this->TestPath)) {
         // This is a matching file.  Check if it is better than the
         // best name found so far.  Earlier prefixes are preferred,
         // followed by earlier suffixes.  For OpenBSD, shared library
@@ -465,7 +468,7 @@ std::string cmFindLibraryCommand::FindFrameworkLibraryNamesPerDir()
   for (std::string const& d : this->SearchPaths) {
     for (std::string const& n : this->Names) {
       fwPath = cmStrCat(d, n, ".framework");
-      if (cmSystemTools::FileIsDirectory(fwPath)) {
+      if (this->DirectoryListings->FileIsDirectory(fwPath)) {
         return cmSystemTools::CollapseFullPath(fwPath);
       }
     }
@@ -482,7 +485,7 @@ std::string cmFindLibraryCommand::FindFrameworkLibraryDirsPerName()
   for (std::string const& n : this->Names) {
     for (std::string const& d : this->SearchPaths) {
       fwPath = cmStrCat(d, n, ".framework");
-      if (cmSystemTools::FileIsDirectory(fwPath)) {
+      if (this->DirectoryListings->FileIsDirectory(fwPath)) {
         return cmSystemTools::CollapseFullPath(fwPath);
       }
     }
@@ -21,6 +21,8 @@
 #include "cmsys/String.h"
 
 #include "cmAlgorithms.h"
+#include "cmDirectoryListingCache.h"
+#include "cmFindPackageResolutionCache.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmPolicies.h"
@@ -31,6 +33,7 @@
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmVersion.h"
+#include "cmake.h"
 
 #if defined(__HAIKU__)
 #  include <FindDirectory.h>
@@ -980,6 +983,36 @@ bool cmFindPackageCommand::FindConfig()
   this->ComputePrefixes();
 
   // Look for the project's configuration file.
+  bool found;
+#if !defined(CMAKE_BOOTSTRAP)
+  cmFindPackageResolutionCache* cache =
+    this->Makefile->GetCMakeInstance()->GetFindPackageResolutionCache();
+  if (cache && !this->DebugMode) {
+    found = this->FindCachedConfig(*cache);
+  } else
+#endif
+  {
+    found = this->SearchConfig();
+  }
+
+  // Store the entry in the cache so it can be set by the user.
+  std::string init;
+  if (found) {
+    init = cmSystemTools::GetFilenamePath(this->FileFound);
+  } else {
+    init = this->Variable + "-NOTFOUND";
+  }
+  std::string help =
+    cmStrCat("The directory containing a CMake configuration file for ",
+             this->Name, '.');
+  // We force the value since we do not get here if it was already set.
+  this->Makefile->AddCacheDefinition(this->Variable, init.c_str(),
+                                     help.c_str(), cmStateEnums::PATH, true);
+  return found;
+}
+
+bool cmFindPackageCommand::SearchConfig()
+{
   bool found = false;
 
   // Search for frameworks.
@@ -1007,22 +1040,75 @@ bool cmFindPackageCommand::FindConfig()
     found = this->FindAppBundleConfig();
   }
 
-  // Store the entry in the cache so it can be set by the user.
-  std::string init;
+  return found;
+}
+
+#if !defined(CMAKE_BOOTSTRAP)
+bool cmFindPackageCommand::FindCachedConfig(
+  cmFindPackageResolutionCache& cache)
+{
+  std::string const key = this->ComputeResolutionKey();
+  cmFindPackageResolutionCache::Result result;
+  if (cache.Lookup(key, result)) {
+    for (auto const& considered : result.Considered) {
+      ConfigFileInfo configFileInfo;
+      configFileInfo.filename = considered.first;
+      configFileInfo.version = considered.second;
+      this->ConsideredConfigs.push_back(std::move(configFileInfo));
+    }
+    if (result.FileFound.empty()) {
+      return false;
+    }
+    this->FileFound = std::move(result.FileFound);
+    this->VersionFound = std::move(result.VersionFound);
+    this->ParseVersionFound();
+    return true;
+  }
+
+  // Search while recording the directories and version files the
+  // outcome depends on.
+  size_t const numConsidered = this->ConsideredConfigs.size();
+  this->EvaluatedVersionFiles.clear();
+  cmDirectoryListingCache::Recording recording;
+  this->DirectoryListings->StartRecording(recording);
+  bool const found = this->SearchConfig();
+  this->DirectoryListings->StopRecording(recording);
+  if (!recording.Complete) {
+    return found;
+  }
+
   if (found) {
-    init = cmSystemTools::GetFilenamePath(this->FileFound);
-  } else {
-    init = this->Variable + "-NOTFOUND";
+    result.FileFound = this->FileFound;
+    result.VersionFound = this->VersionFound;
   }
-  std::string help =
-    cmStrCat("The directory containing a CMake configuration file for ",
-             this->Name, '.');
-  // We force the value since we do not get here if it was already set.
-  this->Makefile->AddCacheDefinition(this->Variable, init.c_str(),
-                                     help.c_str(), cmStateEnums::PATH, true);
+  for (ConfigFileInfo const& info :
+       cmMakeRange(this->ConsideredConfigs).advance(numConsidered)) {
+    result.Considered.emplace_back(info.filename, info.version);
+  }
+  cache.Store(key, std::move(result), recording.Directories,
+              this->EvaluatedVersionFiles);
   return found;
 }
 
+std::string cmFindPackageCommand::ComputeResolutionKey() const
+{
+  // Everything the search procedure depends on.  Version files commonly
+  // check the pointer size of the target.
+  return cmStrCat(
+    this->Name, '\n', this->Version, '\n', this->VersionExact, '\n',
+    this->Makefile->GetSafeDefinition(this->Name + "_FIND_COMPONENTS"), '\n',
+    this->Makefile->GetSafeDefinition("CMAKE_SIZEOF_VOID_P"), '\n',
+    cmJoin(this->Names, ";"), '\n', cmJoin(this->Configs, ";"), '\n',
+    cmJoin(this->SearchPaths, ";"), '\n', cmJoin(this->IgnoredPaths, ";"),
+    '\n', this->LibraryArchitecture, '\n', this->UseLib32Paths,
+    this->UseLib64Paths, this->UseLibx32Paths, this->UseRealPath,
+    this->SearchFrameworkFirst, this->SearchFrameworkOnly,
+    this->SearchFrameworkLast, this->SearchAppBundleFirst,
+    this->SearchAppBundleOnly, this->SearchAppBundleLast, this->SortOrder,
+    this->SortDirection);
+}
+#endif
+
 bool cmFindPackageCommand::FindPrefixedConfig()
 {
   std::vector<std::string> const& prefixes = this->SearchPaths;
@@ -1515,7 +1601,8 @@ bool cmFindPackageCommand::FindConfigFile(std::string const& dir,
     if (this->DebugMode) {
       fprintf(stderr, "Checking file [%s]\n", file.c_str());
     }
-    if (cmSystemTools::FileExists(file, true) && this->CheckVersion(file)) {
+    if (this->DirectoryListings->FileExists(file, true) &&
+        this->CheckVersion(file)) {
       // Allow resolving symlinks when the config file is found through a link
       if (this->UseRealPath) {
         file = cmSystemTools::GetRealPath(file);
@@ -1538,14 +1625,16 @@ bool cmFindPackageCommand::CheckVersion(std::string const& config_file)
 
   // Look for foo-config-version.cmake
   std::string version_file = cmStrCat(version_file_base, "-version.cmake");
-  if (!haveResult && cmSystemTools::FileExists(version_file, true)) {
+  if (!haveResult &&
+      this->DirectoryListings->FileExists(version_file, true)) {
     result = this->CheckVersionFile(version_file, version);
     haveResult = true;
   }
 
   // Look for fooConfigVersion.cmake
   version_file = cmStrCat(version_file_base, "Version.cmake");
-  if (!haveResult && cmSystemTools::FileExists(version_file, true)) {
+  if (!haveResult &&
+      this->DirectoryListings->FileExists(version_file, true)) {
     result = this->CheckVersionFile(version_file, version);
     haveResult = true;
   }
@@ -1595,6 +1684,7 @@ bool cmFindPackageCommand::CheckVersionFile(std::string const& version_file,
 
   // Load the version check file.  Pass NoPolicyScope because we do
   // our own policy push/pop independent of CMP0011.
+  this->EvaluatedVersionFiles.insert(version_file);
   bool suitable = false;
   if (this->ReadListFile(version_file, NoPolicyScope)) {
     // Check the output variables.
@@ -1611,32 +1701,7 @@ bool cmFindPackageCommand::CheckVersionFile(std::string const& version_file,
       // Get the version found.
       this->VersionFound =
         this->Makefile->GetSafeDefinition("PACKAGE_VERSION");
-
-      // Try to parse the version number and store the results that were
-      // successfully parsed.
-      unsigned int parsed_major;
-      unsigned int parsed_minor;
-      unsigned int parsed_patch;
-      unsigned int parsed_tweak;
-      this->VersionFoundCount =
-        sscanf(this->VersionFound.c_str(), "%u.%u.%u.%u", &parsed_major,
-               &parsed_minor, &parsed_patch, &parsed_tweak);
-      switch (this->VersionFoundCount) {
-        case 4:
-          this->VersionFoundTweak = parsed_tweak;
-          CM_FALLTHROUGH;
-        case 3:
-          this->VersionFoundPatch = parsed_patch;
-          CM_FALLTHROUGH;
-        case 2:
-          this->VersionFoundMinor = parsed_minor;
-          CM_FALLTHROUGH;
-        case 1:
-          this->VersionFoundMajor = parsed_major;
-          CM_FALLTHROUGH;
-        default:
-          break;
-      }
+      this->ParseVersionFound();
     }
   }
 
@@ -1649,6 +1714,35 @@ bool cmFindPackageCommand::CheckVersionFile(std::string const& version_file,
   return suitable;
 }
 
+void cmFindPackageCommand::ParseVersionFound()
+{
+  // Try to parse the version number and store the results that were
+  // successfully parsed.
+  unsigned int parsed_major;
+  unsigned int parsed_minor;
+  unsigned int parsed_patch;
+  unsigned int parsed_tweak;
+  this->VersionFoundCount =
+    sscanf(this->VersionFound.c_str(), "%u.%u.%u.%u", &parsed_major,
+           &parsed_minor, &parsed_patch, &parsed_tweak);
+  switch (this->VersionFoundCount) {
+    case 4:
+      this->VersionFoundTweak = parsed_tweak;
+      CM_FALLTHROUGH;
+    case 3:
+      this->VersionFoundPatch = parsed_patch;
+      CM_FALLTHROUGH;
+    case 2:
+      this->VersionFoundMinor = parsed_minor;
+      CM_FALLTHROUGH;
+    case 1:
+      this->VersionFoundMajor = parsed_major;
+      CM_FALLTHROUGH;
+    default:
+      break;
+  }
+}
+
 void cmFindPackageCommand::StoreVersionFound()
 {
   // Store the whole version string.
@@ -1680,6 +1774,7 @@ public:
 
 protected:
   bool Consider(std::string const& fullPath, cmFileList& listing);
+  static cmDirectoryListingCache& GetDirectoryListings(cmFileList& listing);
 
 private:
   bool Search(cmFileList&);
@@ -1693,6 +1788,10 @@ private:
 class cmFileList
 {
 public:
+  explicit cmFileList(cmDirectoryListingCache* listings)
+    : DirectoryListings(listings)
+  {
+  }
   virtual ~cmFileList() = default;
   cmFileList& operator/(cmFileListGeneratorBase const& rhs)
   {
@@ -1715,6 +1814,7 @@ public:
 private:
   virtual bool Visit(std::string const& fullPath) = 0;
   friend class cmFileListGeneratorBase;
+  cmDirectoryListingCache* DirectoryListings;
   std::unique_ptr<cmFileListGeneratorBase> First;
   cmFileListGeneratorBase* Last = nullptr;
 };
@@ -1723,7 +1823,8 @@ class cmFindPackageFileList : public cmFileList
 {
 public:
   cmFindPackageFileList(cmFindPackageCommand* fpc, bool use_suffixes = true)
-    : FPC(fpc)
+    : cmFileList(fpc->DirectoryListings)
+    , FPC(fpc)
     , UseSuffixes(use_suffixes)
   {
   }
@@ -1761,6 +1862,12 @@ bool cmFileListGeneratorBase::Consider(std::string const& fullPath,
   return listing.Visit(fullPath + "/");
 }
 
+cmDirectoryListingCache& cmFileListGeneratorBase::GetDirectoryListings(
+  cmFileList& listing)
+{
+  return *listing.DirectoryListings;
+}
+
 class cmFileListGeneratorFixed : public cmFileListGeneratorBase
 {
 public:
@@ -1853,16 +1960,12 @@ private:
   {
     // Construct a list of matches.
     std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent);
-    for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
-      const char* fname = d.GetFile(i);
-      if (strcmp(fname, ".") == 0 || strcmp(fname, "..") == 0) {
-        continue;
-      }
+    for (std::string const& fname :
+         GetDirectoryListings(lister).GetDirectoryContent(parent)) {
       for (std::string const& n : this->Names) {
-        if (cmsysString_strncasecmp(fname, n.c_str(), n.length()) == 0) {
-          matches.emplace_back(fname);
+        if (cmsysString_strncasecmp(fname.c_str(), n.c_str(), n.length()) ==
+            0) {
+          matches.push_back(fname);
         }
       }
     }
@@ -1911,17 +2014,12 @@ private:
   {
     // Construct a list of matches.
     std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent);
-    for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
-      const char* fname = d.GetFile(i);
-      if (strcmp(fname, ".") == 0 || strcmp(fname, "..") == 0) {
-        continue;
-      }
+    for (std::string const& fname :
+         GetDirectoryListings(lister).GetDirectoryContent(parent)) {
       for (std::string name : this->Names) {
         name += this->Extension;
-        if (cmsysString_strcasecmp(fname, name.c_str()) == 0) {
-          matches.emplace_back(fname);
+        if (cmsysString_strcasecmp(fname.c_str(), name.c_str()) == 0) {
+          matches.push_back(fname);
         }
       }
     }
@@ -1959,15 +2057,9 @@ private:
   bool Search(std::string const& parent, cmFileList& lister) override
   {
     // Look for matching files.
-    std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent);
-    for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
-      const char* fname = d.GetFile(i);
-      if (strcmp(fname, ".") == 0 || strcmp(fname, "..") == 0) {
-        continue;
-      }
-      if (cmsysString_strcasecmp(fname, this->String.c_str()) == 0) {
+    for (std::string const& fname :
+         GetDirectoryListings(lister).GetDirectoryContent(parent)) {
+      if (cmsysString_strcasecmp(fname.c_str(), this->String.c_str()) == 0) {
         if (this->Consider(parent + fname, lister)) {
           return true;
         }
@@ -1999,7 +2091,9 @@ private:
   std::string Pattern;
   bool Search(std::string const& parent, cmFileList& lister) override
   {
-    // Glob the set of matching files.
+    // Glob the set of matching files.  The globbed directories are not
+    // known to the directory listings.
+    GetDirectoryListings(lister).RecordUncached();
     std::string expr = cmStrCat(parent, this->Pattern);
     cmsys::Glob g;
     if (!g.FindFiles(expr)) {
@@ -2009,7 +2103,7 @@ private:
 
     // Look for directories among the matches.
     for (std::string const& f : files) {
-      if (cmSystemTools::FileIsDirectory(f)) {
+      if (GetDirectoryListings(lister).FileIsDirectory(f)) {
         if (this->Consider(f, lister)) {
           return true;
         }
@@ -2031,7 +2125,7 @@ bool cmFindPackageCommand::SearchPrefix(std::string const& prefix_in)
   }
 
   // Skip this if the prefix does not exist.
-  if (!cmSystemTools::FileIsDirectory(prefix_in)) {
+  if (!this->DirectoryListings->FileIsDirectory(prefix_in)) {
     return false;
   }
 
@@ -29,6 +29,7 @@ namespace std {
 #endif
 
 class cmExecutionStatus;
+class cmFindPackageResolutionCache;
 class cmSearchPath;
 
 /** \class cmFindPackageCommand
@@ -102,6 +103,9 @@ private:
   bool HandlePackageMode(HandlePackageModeType type);
 
   bool FindConfig();
+  bool SearchConfig();
+  bool FindCachedConfig(cmFindPackageResolutionCache& cache);
+  std::string ComputeResolutionKey() const;
   bool FindPrefixedConfig();
   bool FindFrameworkConfig();
   bool FindAppBundleConfig();
@@ -111,6 +115,7 @@ private:
     DoPolicyScope
   };
   bool ReadListFile(const std::string& f, PolicyScopeRule psr);
+  void ParseVersionFound();
   void StoreVersionFound();
 
   void ComputePrefixes();
@@ -184,6 +189,7 @@ private:
   std::vector<std::string> Names;
   std::vector<std::string> Configs;
   std::set<std::string> IgnoredPaths;
+  std::set<std::string> EvaluatedVersionFiles;
 
   /*! the selected sortOrder (None by default)*/
   SortOrderType SortOrder;
@@ -0,0 +1,143 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmFindPackageResolutionCache.h"
+
+#include <cstdint>
+#include <initializer_list>
+
+#include <cm/string_view>
+
+namespace {
+
+// Bump the last byte whenever the record layout changes.
+cmBinaryCacheFile::Magic const Magic = { 'C', 'M', 'F', 'P', 'R', 'C',
+                                         '\0', '\1' };
+}
+
+cmFindPackageResolutionCache::cmFindPackageResolutionCache(std::string path)
+  : Path(std::move(path))
+{
+}
+
+void cmFindPackageResolutionCache::Load()
+{
+  this->Entries.clear();
+  this->Modified = false;
+
+  std::string buffer;
+  cm::string_view payload;
+  if (!cmBinaryCacheFile::Read(this->Path, Magic, buffer, payload)) {
+    return;
+  }
+
+  cmBinaryCacheReader r(payload);
+  std::unordered_map<std::string, Entry> entries;
+  while (!r.AtEnd()) {
+    std::string key;
+    Entry entry;
+    std::uint32_t numConsidered;
+    if (!r.GetString(key) || !r.GetString(entry.Outcome.FileFound) ||
+        !r.GetString(entry.Outcome.VersionFound) || !r.Get(numConsidered)) {
+      // Truncated or corrupt.  Start over.
+      return;
+    }
+    for (std::uint32_t i = 0; i < numConsidered; ++i) {
+      std::pair<std::string, std::string> considered;
+      if (!r.GetString(considered.first) || !r.GetString(considered.second)) {
+        return;
+      }
+      entry.Outcome.Considered.push_back(std::move(considered));
+    }
+    std::uint32_t numStamps;
+    if (!r.Get(numStamps)) {
+      return;
+    }
+    for (std::uint32_t i = 0; i < numStamps; ++i) {
+      PathStamp stamp;
+      std::uint8_t exists;
+      if (!r.GetString(stamp.Path) || !r.Get(exists) ||
+          !r.Get(stamp.Stamp.Size) || !r.Get(stamp.Stamp.MTime)) {
+        return;
+      }
+      stamp.Stamp.Exists = exists != 0;
+      entry.Stamps.push_back(std::move(stamp));
+    }
+    entries[key] = std::move(entry);
+  }
+  this->Entries = std::move(entries);
+}
+
+bool cmFindPackageResolutionCache::Save() const
+{
+  if (!this->Modified) {
+    return true;
+  }
+
+  std::string out;
+  cmBinaryCacheWriter w(out);
+  cmBinaryCacheFile::WriteHeader(out, Magic);
+  for (auto const& e : this->Entries) {
+    Result const& outcome = e.second.Outcome;
+    w.PutString(e.first);
+    w.PutString(outcome.FileFound);
+    w.PutString(outcome.VersionFound);
+    w.Put(static_cast<std::uint32_t>(outcome.Considered.size()));
+    for (auto const& considered : outcome.Considered) {
+      w.PutString(considered.first);
+      w.PutString(considered.second);
+    }
+    w.Put(static_cast<std::uint32_t>(e.second.Stamps.size()));
+    for (PathStamp const& stamp : e.second.Stamps) {
+      w.PutString(stamp.Path);
+      w.Put(static_cast<std::uint8_t>(stamp.Stamp.Exists ? 1 : 0));
+      w.Put(stamp.Stamp.Size);
+      w.Put(stamp.Stamp.MTime);
+    }
+  }
+
+  return cmBinaryCacheFile::Write(this->Path, out);
+}
+
+bool cmFindPackageResolutionCache::Lookup(std::string const& key,
+                                          Result& result)
+{
+  auto i = this->Entries.find(key);
+  if (i == this->Entries.end()) {
+    ++this->Misses;
+    return false;
+  }
+  for (PathStamp const& stamp : i->second.Stamps) {
+    if (cmBinaryCacheFile::StampPath(stamp.Path) != stamp.Stamp) {
+      this->Entries.erase(i);
+      this->Modified = true;
+      ++this->Misses;
+      return false;
+    }
+  }
+  result = i->second.Outcome;
+  ++this->Hits;
+  return true;
+}
+
+void cmFindPackageResolutionCache::Store(
+  std::string const& key, Result result,
+  std::set<std::string> const& directories, std::set<std::string> const& files)
+{
+  std::int64_t const now = cmBinaryCacheFile::Now();
+
+  Entry entry;
+  entry.Outcome = std::move(result);
+  for (std::set<std::string> const* paths : { &directories, &files }) {
+    for (std::string const& path : *paths) {
+      PathStamp stamp;
+      stamp.Path = path;
+      stamp.Stamp = cmBinaryCacheFile::StampPath(path);
+      if (!cmBinaryCacheFile::IsSettled(stamp.Stamp, now)) {
+        return;
+      }
+      entry.Stamps.push_back(std::move(stamp));
+    }
+  }
+  this->Entries[key] = std::move(entry);
+  this->Modified = true;
+}
@@ -0,0 +1,92 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmFindPackageResolutionCache_h
+#define cmFindPackageResolutionCache_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cmBinaryCacheFile.h"
+
+/** \class cmFindPackageResolutionCache
+ * \brief Remember the outcome of find_package config file searches
+ *        across configure steps and build trees.
+ *
+ * An entry is keyed by everything the search depends on, such as the
+ * package name, requested version, components and the ordered list of
+ * search prefixes.  It stores the configuration file found, if any, and
+ * the candidates that were considered, together with stamps of the
+ * directories listed and the version files evaluated by the search.  A
+ * later search with the same key reuses the outcome as long as none of
+ * these stamps changed, without listing any directory or evaluating any
+ * version file.
+ *
+ * The cache lives in a single file that may be shared by any number of
+ * build trees.  Only searches whose directories and version files were
+ * last modified more than a second earlier are stored, so a change
+ * within the resolution of a time stamp is never missed.
+ */
+class cmFindPackageResolutionCache
+{
+public:
+  struct Result
+  {
+    std::string FileFound;
+    std::string VersionFound;
+    // The configuration files considered and their versions.
+    std::vector<std::pair<std::string, std::string>> Considered;
+  };
+
+  cmFindPackageResolutionCache(std::string path);
+
+  cmFindPackageResolutionCache(cmFindPackageResolutionCache const&) =
+    delete;
+  cmFindPackageResolutionCache& operator=(
+    cmFindPackageResolutionCache const&) = delete;
+
+  /** Read the cache file.  Missing, corrupt, or foreign cache files
+      are silently ignored.  */
+  void Load();
+
+  /** Write the entries back to the cache file if any changed.  */
+  bool Save() const;
+
+  /** Look up the result of a search.  Return false if there is no entry
+      for the key or if the file system changed since it was stored.  */
+  bool Lookup(std::string const& key, Result& result);
+
+  /** Store the result of a search that listed the given directories and
+      evaluated the given version files.  */
+  void Store(std::string const& key, Result result,
+             std::set<std::string> const& directories,
+             std::set<std::string> const& files);
+
+  unsigned long GetHits() const { return this->Hits; }
+  unsigned long GetMisses() const { return this->Misses; }
+
+private:
+  struct PathStamp
+  {
+    std::string Path;
+    cmBinaryCacheFile::Stamp Stamp;
+  };
+
+  struct Entry
+  {
+    Result Outcome;
+    std::vector<PathStamp> Stamps;
+  };
+
+  std::string Path;
+  std::unordered_map<std::string, Entry> Entries;
+  unsigned long Hits = 0;
+  unsigned long Misses = 0;
+  bool Modified = false;
+};
+
+#endif
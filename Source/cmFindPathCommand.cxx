@@ -4,6 +4,7 @@
 
 #include "cmsys/Glob.hxx"
 
+#include "cmDirectoryListingCache.h"
 #include "cmMakefile.h"
 #include "cmStateTypes.h"
 #include "cmStringAlgorithms.h"
@@ -91,7 +92,7 @@ std::string cmFindPathCommand::FindHeaderInFramework(std::string const& file,
     if (!frameWorkName.empty()) {
       std::string fpath = cmStrCat(dir, frameWorkName, ".framework");
       std::string intPath = cmStrCat(fpath, "/Headers/", fileName);
-      if (cmSystemTools::FileExists(intPath)) {
+      if (this->DirectoryListings->FileExists(intPath)) {
         if (this->IncludeFileInPath) {
           return intPath;
         }
@@ -122,7 +123,7 @@ std::string cmFindPathCommand::FindNormalHeader()
   for (std::string const& n : this->Names) {
     for (std::string const& sp : this->SearchPaths) {
       tryPath = cmStrCat(sp, n);
-      if (cmSystemTools::FileExists(tryPath)) {
+      if (this->DirectoryListings->FileExists(tryPath)) {
         if (this->IncludeFileInPath) {
           return tryPath;
         }
@@ -2,6 +2,7 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmFindProgramCommand.h"
 
+#include "cmDirectoryListingCache.h"
 #include "cmMakefile.h"
 #include "cmStateTypes.h"
 #include "cmStringAlgorithms.h"
@@ -15,7 +16,8 @@ class cmExecutionStatus;
 
 struct cmFindProgramHelper
 {
-  cmFindProgramHelper()
+  explicit cmFindProgramHelper(cmDirectoryListingCache* listings)
+    : DirectoryListings(listings)
   {
 #if defined(_WIN32) || defined(__CYGWIN__) || defined(__MINGW32__)
     // Consider platform-specific extensions.
@@ -26,6 +28,9 @@ struct cmFindProgramHelper
     this->Extensions.emplace_back();
   }
 
+  // Directory listings shared by the find commands.
+  cmDirectoryListingCache* DirectoryListings;
+
   // List of valid extensions.
   std::vector<std::string> Extensions;
 
@@ -79,7 +84,7 @@ struct cmFindProgramHelper
       this->TestPath =
         cmSystemTools::CollapseFullPath(this->TestNameExt, path);
 
-      if (cmSystemTools::FileExists(this->TestPath, true)) {
+      if (this->DirectoryListings->FileExists(this->TestPath, true)) {
         this->BestPath = this->TestPath;
         return true;
       }
@@ -158,7 +163,7 @@ std::string cmFindProgramCommand::FindNormalProgram()
 std::string cmFindProgramCommand::FindNormalProgramNamesPerDir()
 {
   // Search for all names in each directory.
-  cmFindProgramHelper helper;
+  cmFindProgramHelper helper(this->DirectoryListings);
   for (std::string const& n : this->Names) {
     helper.AddName(n);
   }
@@ -181,7 +186,7 @@ std::string cmFindProgramCommand::FindNormalProgramNamesPerDir()
 std::string cmFindProgramCommand::FindNormalProgramDirsPerName()
 {
   // Search the entire path for each name.
-  cmFindProgramHelper helper;
+  cmFindProgramHelper helper(this->DirectoryListings);
   for (std::string const& n : this->Names) {
     // Switch to searching for this name.
     helper.SetName(n);
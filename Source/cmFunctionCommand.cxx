@@ -19,6 +19,11 @@
 #include "cmRange.h"
 #include "cmState.h"
 #include "cmStringAlgorithms.h"
+#include "cmake.h"
+
+#if !defined(CMAKE_BOOTSTRAP)
+#  include "cmMakefileProfilingData.h"
+#endif
 
 namespace {
 // define the class for function commands
@@ -59,6 +64,13 @@ bool cmFunctionHelperCommand::operator()(
     return false;
   }
 
+#if !defined(CMAKE_BOOTSTRAP)
+  if (cmMakefileProfilingData* profilingOutput =
+        makefile.GetCMakeInstance()->GetProfilingOutput()) {
+    profilingOutput->RefineEntry("function", expandedArgs);
+  }
+#endif
+
   cmMakefile::FunctionPushPop functionScope(&makefile, this->FilePath,
                                             this->Policies);
 
@@ -2,16 +2,71 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmGeneratedFileStream.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <utility>
 
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
 #if !defined(CMAKE_BOOTSTRAP)
+#  include <mutex>
+
 #  include "cm_codecvt.hxx"
 #  include "cm_zlib.h"
+
+#  include "cmWorkerPool.h"
+#endif
+
+namespace {
+#ifndef CMAKE_BOOTSTRAP
+using ActiveMutex = std::mutex;
+using ActiveLock = std::lock_guard<std::mutex>;
+#else
+// The bootstrap cmake closes streams on the main thread only.
+struct ActiveMutex
+{
+};
+struct ActiveLock
+{
+  ActiveLock(ActiveMutex& /*unused*/) {}
+};
 #endif
 
+// The cmGeneratedFileStream::ParallelReplace instance currently deferring
+// replacements, if any.  Guarded by ActiveReplaceMutex together with the
+// pending files of that instance.
+ActiveMutex ActiveReplaceMutex;
+cmGeneratedFileStream::ParallelReplace* ActiveReplace = nullptr;
+
+using PendingFile = cmGeneratedFileStream::ParallelReplace::PendingFile;
+
+#ifndef CMAKE_BOOTSTRAP
+class ReplaceJob : public cmWorkerPool::JobT
+{
+public:
+  ReplaceJob(std::vector<PendingFile> const& files, size_t begin, size_t end)
+    : Files(files)
+    , Begin(begin)
+    , End(end)
+  {
+  }
+
+private:
+  void Process() override
+  {
+    for (size_t i = this->Begin; i != this->End; ++i) {
+      this->Files[i].Replace();
+    }
+  }
+
+  std::vector<PendingFile> const& Files;
+  size_t Begin;
+  size_t End;
+};
+#endif
+}
+
 cmGeneratedFileStream::cmGeneratedFileStream(Encoding encoding)
 {
 #ifndef CMAKE_BOOTSTRAP
@@ -110,6 +165,17 @@ cmGeneratedFileStreamBase::cmGeneratedFileStreamBase(std::string const& name)
 
 cmGeneratedFileStreamBase::~cmGeneratedFileStreamBase()
 {
+  if (!this->TempName.empty()) {
+    ActiveLock lock(ActiveReplaceMutex);
+    if (ActiveReplace) {
+      // Leave the temporary file for the active ParallelReplace.
+      ActiveReplace->Defer(
+        PendingFile{ std::move(this->Name), std::move(this->TempName),
+                     this->Okay, this->CopyIfDifferent, this->Compress,
+                     this->CompressExtraExtension });
+      return;
+    }
+  }
   this->Close();
 }
 
@@ -126,6 +192,15 @@ void cmGeneratedFileStreamBase::Open(std::string const& name)
   this->TempName += ".tmp";
 #endif
 
+  // A previous stream for the same file may still have a pending
+  // replacement using the same temporary file.  Finish it first.
+  {
+    ActiveLock lock(ActiveReplaceMutex);
+    if (ActiveReplace) {
+      ActiveReplace->ReplaceEarly(this->TempName);
+    }
+  }
+
   // Make sure the temporary file that will be used is not present.
   cmSystemTools::RemoveFile(this->TempName);
 
@@ -134,29 +209,45 @@ void cmGeneratedFileStreamBase::Open(std::string const& name)
 }
 
 bool cmGeneratedFileStreamBase::Close()
+{
+  if (this->TempName.empty()) {
+    // Never opened or already closed.
+    return false;
+  }
+  bool replaced =
+    ReplaceFile(this->Name, this->TempName, this->Okay, this->CopyIfDifferent,
+                this->Compress, this->CompressExtraExtension);
+  this->TempName.clear();
+  return replaced;
+}
+
+bool cmGeneratedFileStreamBase::ReplaceFile(std::string const& name,
+                                            std::string const& tempName,
+                                            bool okay, bool copyIfDifferent,
+                                            bool compress,
+                                            bool compressExtraExtension)
 {
   bool replaced = false;
 
-  std::string resname = this->Name;
-  if (this->Compress && this->CompressExtraExtension) {
+  std::string resname = name;
+  if (compress && compressExtraExtension) {
     resname += ".gz";
   }
 
   // Only consider replacing the destination file if no error
   // occurred.
-  if (!this->Name.empty() && this->Okay &&
-      (!this->CopyIfDifferent ||
-       cmSystemTools::FilesDiffer(this->TempName, resname))) {
+  if (!name.empty() && okay &&
+      (!copyIfDifferent || cmSystemTools::FilesDiffer(tempName, resname))) {
     // The destination is to be replaced.  Rename the temporary to the
     // destination atomically.
-    if (this->Compress) {
-      std::string gzname = cmStrCat(this->TempName, ".temp.gz");
-      if (this->CompressFile(this->TempName, gzname)) {
-        this->RenameFile(gzname, resname);
+    if (compress) {
+      std::string gzname = cmStrCat(tempName, ".temp.gz");
+      if (CompressFile(tempName, gzname)) {
+        RenameFile(gzname, resname);
       }
       cmSystemTools::RemoveFile(gzname);
     } else {
-      this->RenameFile(this->TempName, resname);
+      RenameFile(tempName, resname);
     }
 
     replaced = true;
@@ -165,7 +256,7 @@ bool cmGeneratedFileStreamBase::Close()
   // Else, the destination was not replaced.
   //
   // Always delete the temporary file. We never want it to stay around.
-  cmSystemTools::RemoveFile(this->TempName);
+  cmSystemTools::RemoveFile(tempName);
 
   return replaced;
 }
@@ -214,3 +305,92 @@ void cmGeneratedFileStream::SetName(const std::string& fname)
 {
   this->Name = fname;
 }
+
+bool cmGeneratedFileStream::ParallelReplace::PendingFile::Replace() const
+{
+  return cmGeneratedFileStreamBase::ReplaceFile(
+    this->Name, this->TempName, this->Okay, this->CopyIfDifferent,
+    this->Compress, this->CompressExtraExtension);
+}
+
+cmGeneratedFileStream::ParallelReplace::ParallelReplace(unsigned int threads)
+  : Threads(threads)
+{
+  // Nested instances leave the pending files to the outermost one.
+  ActiveLock lock(ActiveReplaceMutex);
+  if (!ActiveReplace) {
+    ActiveReplace = this;
+    this->Active = true;
+  }
+}
+
+cmGeneratedFileStream::ParallelReplace::~ParallelReplace()
+{
+  this->Finish();
+}
+
+void cmGeneratedFileStream::ParallelReplace::Defer(PendingFile file)
+{
+  this->Index[file.TempName] = this->Files.size();
+  this->Files.push_back(std::move(file));
+}
+
+void cmGeneratedFileStream::ParallelReplace::ReplaceEarly(
+  std::string const& tempName)
+{
+  // A previous stream for the same file still has a pending replacement
+  // using the same temporary file.
+  auto i = this->Index.find(tempName);
+  if (i != this->Index.end()) {
+    PendingFile& p = this->Files[i->second];
+    p.Replace();
+    p.TempName.clear();
+    this->Index.erase(i);
+  }
+}
+
+void cmGeneratedFileStream::ParallelReplace::Finish()
+{
+  if (!this->Active) {
+    return;
+  }
+  this->Active = false;
+  std::vector<PendingFile> files;
+  {
+    ActiveLock lock(ActiveReplaceMutex);
+    ActiveReplace = nullptr;
+    this->Index.clear();
+    files = std::move(this->Files);
+    this->Files.clear();
+  }
+
+  // Files replaced early by a later Open have an empty temporary name.
+  files.erase(std::remove_if(files.begin(), files.end(),
+                             [](PendingFile const& p) {
+                               return p.TempName.empty();
+                             }),
+              files.end());
+
+#ifndef CMAKE_BOOTSTRAP
+  unsigned int const threads =
+    static_cast<unsigned int>(std::min<size_t>(this->Threads, files.size()));
+  if (threads > 1) {
+    // Hand each worker a contiguous range of files.  The destination
+    // files are distinct, so the order of replacement does not matter.
+    cmWorkerPool pool;
+    pool.SetThreadCount(threads);
+    size_t const chunk = (files.size() + threads - 1) / threads;
+    for (size_t begin = 0; begin < files.size(); begin += chunk) {
+      pool.EmplaceJob<ReplaceJob>(files, begin,
+                                  std::min(begin + chunk, files.size()));
+    }
+    pool.EmplaceJob<cmWorkerPool::JobEndT>();
+    pool.Process();
+    return;
+  }
+#endif
+
+  for (PendingFile const& p : files) {
+    p.Replace();
+  }
+}
@@ -6,6 +6,8 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "cmsys/FStream.hxx"
 
@@ -16,6 +18,15 @@
 // therefore be used to manage the temporary file.
 class cmGeneratedFileStreamBase
 {
+public:
+  // Replace the destination file with the temporary file if needed and
+  // remove the temporary file.  Returns whether the destination was
+  // replaced.
+  static bool ReplaceFile(std::string const& name,
+                          std::string const& tempName, bool okay,
+                          bool copyIfDifferent, bool compress,
+                          bool compressExtraExtension);
+
 protected:
   // This constructor does not prepare the temporary file.  The open
   // method must be used.
@@ -35,10 +46,12 @@ protected:
   bool Close();
 
   // Internal file replacement implementation.
-  int RenameFile(std::string const& oldname, std::string const& newname);
+  static int RenameFile(std::string const& oldname,
+                        std::string const& newname);
 
   // Internal file compression implementation.
-  int CompressFile(std::string const& oldname, std::string const& newname);
+  static int CompressFile(std::string const& oldname,
+                          std::string const& newname);
 
   // The name of the final destination file for the output.
   std::string Name;
@@ -138,6 +151,60 @@ public:
    * the output file to be changed during the use of cmGeneratedFileStream.
    */
   void SetName(const std::string& fname);
+
+  /** \class ParallelReplace
+   * \brief Replace destination files concurrently.
+   *
+   * While an instance of this class is alive, streams that are
+   * destroyed without an explicit Close() leave their temporary file
+   * in place instead of comparing it to the destination file and
+   * renaming it right away.  All pending files are replaced by a pool
+   * of worker threads when Finish() is called or the instance is
+   * destroyed.  Content is still written in the original order, so the
+   * resulting files are the same as without deferral.
+   *
+   * The pending files belong to the instance.  Only one instance defers
+   * at a time; nested instances leave the pending files to the
+   * outermost one.  Streams may be closed on any thread.
+   */
+  class ParallelReplace
+  {
+  public:
+    ParallelReplace(unsigned int threads);
+    ~ParallelReplace();
+
+    ParallelReplace(ParallelReplace const&) = delete;
+    ParallelReplace& operator=(ParallelReplace const&) = delete;
+
+    /** Replace all pending destination files and stop deferring.  */
+    void Finish();
+
+    /** A destination file whose replacement has been deferred.  */
+    struct PendingFile
+    {
+      std::string Name;
+      std::string TempName;
+      bool Okay;
+      bool CopyIfDifferent;
+      bool Compress;
+      bool CompressExtraExtension;
+
+      bool Replace() const;
+    };
+
+  private:
+    friend class cmGeneratedFileStreamBase;
+
+    // Called by streams while holding the lock of the active instance.
+    void Defer(PendingFile file);
+    void ReplaceEarly(std::string const& tempName);
+
+    std::vector<PendingFile> Files;
+    // Indices into Files by temporary file name.
+    std::unordered_map<std::string, size_t> Index;
+    unsigned int Threads;
+    bool Active = false;
+  };
 };
 
 #endif
@@ -9,11 +9,14 @@
 #include "cmsys/RegularExpression.hxx"
 
 #include "cmAlgorithms.h"
+#include "cmGeneratorExpressionCache.h"
 #include "cmGeneratorExpressionContext.h"
 #include "cmGeneratorExpressionDAGChecker.h"
 #include "cmGeneratorExpressionEvaluator.h"
 #include "cmGeneratorExpressionLexer.h"
 #include "cmGeneratorExpressionParser.h"
+#include "cmGlobalGenerator.h"
+#include "cmLocalGenerator.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
@@ -84,6 +87,24 @@ const std::string& cmCompiledGeneratorExpression::EvaluateWithContext(
     return this->Input;
   }
 
+  cmGeneratorExpressionCache* cache = nullptr;
+  if (this->Memoizable && context.LG) {
+    cache = &context.LG->GetGlobalGenerator()->GetGeneratorExpressionCache();
+    if (cmGeneratorExpressionCache::Result const* result = cache->Find(
+          this->Input, context.Config, context.Language,
+          context.CurrentTarget)) {
+      this->Output = result->Output;
+      this->MaxLanguageStandard.clear();
+      this->HadContextSensitiveCondition =
+        result->HadContextSensitiveCondition;
+      this->HadHeadSensitiveCondition = false;
+      this->SourceSensitiveTargets.clear();
+      this->DependTargets.clear();
+      this->AllTargetsSeen.clear();
+      return this->Output;
+    }
+  }
+
   this->Output.clear();
 
   for (const cmGeneratorExpressionEvaluator* it : this->Evaluators) {
@@ -107,6 +128,18 @@ const std::string& cmCompiledGeneratorExpression::EvaluateWithContext(
 
   this->DependTargets = context.DependTargets;
   this->AllTargetsSeen = context.AllTargets;
+
+  // Do not look up this expression again once it depended on more than
+  // the parts of the context the cache is keyed by.
+  if (!context.Memoizable) {
+    this->Memoizable = false;
+  } else if (cache && !context.HadError) {
+    cmGeneratorExpressionCache::Result result;
+    result.Output = this->Output;
+    result.HadContextSensitiveCondition = context.HadContextSensitiveCondition;
+    cache->Store(this->Input, context.Config, context.Language,
+                 context.CurrentTarget, std::move(result));
+  }
   return this->Output;
 }
 
@@ -116,6 +149,7 @@ cmCompiledGeneratorExpression::cmCompiledGeneratorExpression(
   , Input(std::move(input))
   , EvaluateForBuildsystem(false)
   , Quiet(false)
+  , Memoizable(true)
   , HadContextSensitiveCondition(false)
   , HadHeadSensitiveCondition(false)
 {
@@ -165,6 +165,7 @@ private:
   bool NeedsEvaluation;
   bool EvaluateForBuildsystem;
   bool Quiet;
+  mutable bool Memoizable;
 
   mutable std::set<cmGeneratorTarget*> DependTargets;
   mutable std::set<cmGeneratorTarget const*> AllTargetsSeen;
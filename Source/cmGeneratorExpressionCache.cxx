@@ -0,0 +1,59 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmGeneratorExpressionCache.h"
+
+#include <functional>
+#include <utility>
+
+size_t cmGeneratorExpressionCache::KeyHash::operator()(Key const& key) const
+{
+  return std::hash<std::string>()(key.Text) ^
+    std::hash<cmGeneratorTarget const*>()(key.CurrentTarget);
+}
+
+cmGeneratorExpressionCache::Key cmGeneratorExpressionCache::MakeKey(
+  std::string const& input, std::string const& config,
+  std::string const& language, cmGeneratorTarget const* currentTarget)
+{
+  // Configuration and language names never contain a NUL character.
+  Key key;
+  key.Text.reserve(config.size() + language.size() + input.size() + 2);
+  key.Text += config;
+  key.Text += '\0';
+  key.Text += language;
+  key.Text += '\0';
+  key.Text += input;
+  key.CurrentTarget = currentTarget;
+  return key;
+}
+
+cmGeneratorExpressionCache::Result const* cmGeneratorExpressionCache::Find(
+  std::string const& input, std::string const& config,
+  std::string const& language, cmGeneratorTarget const* currentTarget)
+{
+  auto i =
+    this->Results.find(MakeKey(input, config, language, currentTarget));
+  if (i == this->Results.end()) {
+    return nullptr;
+  }
+  ++this->Hits;
+  return &i->second;
+}
+
+void cmGeneratorExpressionCache::Store(std::string const& input,
+                                       std::string const& config,
+                                       std::string const& language,
+                                       cmGeneratorTarget const* currentTarget,
+                                       Result result)
+{
+  this->Results[MakeKey(input, config, language, currentTarget)] =
+    std::move(result);
+  ++this->Misses;
+}
+
+void cmGeneratorExpressionCache::Clear()
+{
+  this->Results.clear();
+  this->Hits = 0;
+  this->Misses = 0;
+}
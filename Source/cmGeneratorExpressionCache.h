@@ -0,0 +1,79 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmGeneratorExpressionCache_h
+#define cmGeneratorExpressionCache_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+class cmGeneratorTarget;
+
+/** \class cmGeneratorExpressionCache
+ * \brief Memoize results of generator expression evaluation.
+ *
+ * The same INTERFACE_ property values are evaluated for every consumer,
+ * configuration and language.  Expressions made only of nodes whose
+ * result depends on nothing but their parameters, the configuration,
+ * the language and the current target (see
+ * cmGeneratorExpressionNode::IsMemoizable) are stored here by their
+ * input text together with those parts of the context, and are not
+ * parsed or evaluated again.  Evaluations that report errors are never
+ * stored.
+ */
+class cmGeneratorExpressionCache
+{
+public:
+  struct Result
+  {
+    std::string Output;
+    bool HadContextSensitiveCondition = false;
+  };
+
+  /** Look up the result of a previous evaluation.  */
+  Result const* Find(std::string const& input, std::string const& config,
+                     std::string const& language,
+                     cmGeneratorTarget const* currentTarget);
+
+  /** Store the result of an evaluation that was not found.  Only
+      these count as misses; expressions that cannot be memoized are
+      not counted at all.  */
+  void Store(std::string const& input, std::string const& config,
+             std::string const& language,
+             cmGeneratorTarget const* currentTarget, Result result);
+
+  void Clear();
+
+  unsigned long GetHits() const { return this->Hits; }
+  unsigned long GetMisses() const { return this->Misses; }
+
+private:
+  struct Key
+  {
+    std::string Text;
+    cmGeneratorTarget const* CurrentTarget;
+
+    bool operator==(Key const& other) const
+    {
+      return this->CurrentTarget == other.CurrentTarget &&
+        this->Text == other.Text;
+    }
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(Key const& key) const;
+  };
+
+  static Key MakeKey(std::string const& input, std::string const& config,
+                     std::string const& language,
+                     cmGeneratorTarget const* currentTarget);
+
+  std::unordered_map<Key, Result, KeyHash> Results;
+  unsigned long Hits = 0;
+  unsigned long Misses = 0;
+};
+
+#endif
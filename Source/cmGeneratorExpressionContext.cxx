@@ -19,6 +19,7 @@ cmGeneratorExpressionContext::cmGeneratorExpressionContext(
   , HadError(false)
   , HadContextSensitiveCondition(false)
   , HadHeadSensitiveCondition(false)
+  , Memoizable(true)
   , EvaluateForBuildsystem(evaluateForBuildsystem)
 {
 }
@@ -40,6 +40,8 @@ struct cmGeneratorExpressionContext
   bool HadError;
   bool HadContextSensitiveCondition;
   bool HadHeadSensitiveCondition;
+  // Whether only memoizable nodes have been evaluated.
+  bool Memoizable;
   bool EvaluateForBuildsystem;
 };
 
@@ -82,6 +82,10 @@ std::string GeneratorExpressionContent::Evaluate(
     return std::string();
   }
 
+  if (!node->IsMemoizable()) {
+    context->Memoizable = false;
+  }
+
   if (!node->GeneratesContent()) {
     if (node->NumExpectedParameters() == 1 &&
         node->AcceptsArbitraryContentParameter()) {
@@ -22,6 +22,7 @@
 
 #include "cmAlgorithms.h"
 #include "cmGeneratorExpression.h"
+#include "cmGeneratorExpressionCache.h"
 #include "cmGeneratorExpressionContext.h"
 #include "cmGeneratorExpressionDAGChecker.h"
 #include "cmGeneratorExpressionEvaluator.h"
@@ -49,6 +50,19 @@ std::string cmGeneratorExpressionNode::EvaluateDependentExpression(
   cmGeneratorExpressionDAGChecker* dagChecker,
   cmGeneratorTarget const* currentTarget)
 {
+  // Property values are parsed anew on every evaluation, so look for a
+  // memoized result before parsing.
+  cmGeneratorExpressionCache& cache =
+    lg->GetGlobalGenerator()->GetGeneratorExpressionCache();
+  if (cmGeneratorExpressionCache::Result const* cached =
+        cache.Find(prop, context->Config, context->Language,
+                   currentTarget ? currentTarget : headTarget)) {
+    if (cached->HadContextSensitiveCondition) {
+      context->HadContextSensitiveCondition = true;
+    }
+    return cached->Output;
+  }
+
   cmGeneratorExpression ge(context->Backtrace);
   std::unique_ptr<cmCompiledGeneratorExpression> cge = ge.Parse(prop);
   cge->SetEvaluateForBuildsystem(context->EvaluateForBuildsystem);
@@ -69,6 +83,8 @@ static const struct ZeroNode : public cmGeneratorExpressionNode
 {
   ZeroNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   bool GeneratesContent() const override { return false; }
 
   bool AcceptsArbitraryContentParameter() const override { return true; }
@@ -87,6 +103,8 @@ static const struct OneNode : public cmGeneratorExpressionNode
 {
   OneNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   bool AcceptsArbitraryContentParameter() const override { return true; }
 
   std::string Evaluate(
@@ -113,6 +131,8 @@ struct BooleanOpNode : public cmGeneratorExpressionNode
   {
   }
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return OneOrMoreParameters; }
 
   std::string Evaluate(const std::vector<std::string>& parameters,
@@ -144,6 +164,8 @@ static const struct NotNode : public cmGeneratorExpressionNode
 {
   NotNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   std::string Evaluate(
     const std::vector<std::string>& parameters,
     cmGeneratorExpressionContext* context,
@@ -164,6 +186,8 @@ static const struct BoolNode : public cmGeneratorExpressionNode
 {
   BoolNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return 1; }
 
   std::string Evaluate(
@@ -180,6 +204,8 @@ static const struct IfNode : public cmGeneratorExpressionNode
 {
   IfNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return 3; }
 
   std::string Evaluate(const std::vector<std::string>& parameters,
@@ -201,6 +227,8 @@ static const struct StrEqualNode : public cmGeneratorExpressionNode
 {
   StrEqualNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return 2; }
 
   std::string Evaluate(
@@ -217,6 +245,8 @@ static const struct EqualNode : public cmGeneratorExpressionNode
 {
   EqualNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return 2; }
 
   std::string Evaluate(
@@ -318,6 +348,8 @@ static const struct FilterNode : public cmGeneratorExpressionNode
 {
   FilterNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return 3; }
 
   std::string Evaluate(
@@ -364,6 +396,8 @@ static const struct RemoveDuplicatesNode : public cmGeneratorExpressionNode
 {
   RemoveDuplicatesNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return 1; }
 
   std::string Evaluate(
@@ -563,6 +597,8 @@ static const struct LowerCaseNode : public cmGeneratorExpressionNode
 {
   LowerCaseNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   bool AcceptsArbitraryContentParameter() const override { return true; }
 
   std::string Evaluate(
@@ -579,6 +615,8 @@ static const struct UpperCaseNode : public cmGeneratorExpressionNode
 {
   UpperCaseNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   bool AcceptsArbitraryContentParameter() const override { return true; }
 
   std::string Evaluate(
@@ -595,6 +633,8 @@ static const struct MakeCIdentifierNode : public cmGeneratorExpressionNode
 {
   MakeCIdentifierNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   bool AcceptsArbitraryContentParameter() const override { return true; }
 
   std::string Evaluate(
@@ -612,6 +652,8 @@ struct CharacterNode : public cmGeneratorExpressionNode
 {
   CharacterNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return 0; }
 
   std::string Evaluate(
@@ -812,6 +854,8 @@ struct VersionNode : public cmGeneratorExpressionNode
 {
   VersionNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return 2; }
 
   std::string Evaluate(
@@ -859,6 +903,8 @@ static const struct ConfigurationNode : public cmGeneratorExpressionNode
 {
   ConfigurationNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return 0; }
 
   std::string Evaluate(
@@ -876,6 +922,8 @@ static const struct ConfigurationTestNode : public cmGeneratorExpressionNode
 {
   ConfigurationTestNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return OneOrZeroParameters; }
 
   std::string Evaluate(
@@ -933,6 +981,8 @@ static const struct JoinNode : public cmGeneratorExpressionNode
 {
   JoinNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return 2; }
 
   bool AcceptsArbitraryContentParameter() const override { return true; }
@@ -952,6 +1002,8 @@ static const struct CompileLanguageNode : public cmGeneratorExpressionNode
 {
   CompileLanguageNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool IsMemoizable() const override { return true; }
+
   int NumExpectedParameters() const override { return ZeroOrMoreParameters; }
 
   std::string Evaluate(
@@ -34,6 +34,11 @@ struct cmGeneratorExpressionNode
 
   virtual int NumExpectedParameters() const { return 1; }
 
+  // Whether the result depends only on the parameters, the configuration,
+  // the language and the current target.  Expressions made only of such
+  // nodes are memoized by cmGeneratorExpressionCache.
+  virtual bool IsMemoizable() const { return false; }
+
   virtual std::string Evaluate(
     const std::vector<std::string>& parameters,
     cmGeneratorExpressionContext* context,
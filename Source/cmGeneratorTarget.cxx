@@ -657,6 +657,12 @@ void cmGeneratorTarget::ClearSourcesCache()
   this->Objects.clear();
 }
 
+void cmGeneratorTarget::ClearCompileInfoCache()
+{
+  this->IncludeDirectoriesCache.clear();
+  this->CompileDefinitionsCache.clear();
+}
+
 void cmGeneratorTarget::AddSourceCommon(const std::string& src, bool before)
 {
   this->SourceEntries.insert(
@@ -687,6 +693,7 @@ void cmGeneratorTarget::AddIncludeDirectory(const std::string& src,
     before ? this->IncludeDirectoriesEntries.begin()
            : this->IncludeDirectoriesEntries.end(),
     CreateTargetPropertyEntry(src, this->Makefile->GetBacktrace(), true));
+  this->ClearCompileInfoCache();
 }
 
 std::vector<cmSourceFile*> const* cmGeneratorTarget::GetSourceDepends(
@@ -3041,8 +3048,34 @@ void processIncludeDirectories(
 }
 }
 
+std::vector<BT<std::string>> const& cmGeneratorTarget::GetCachedCompileInfo(
+  CompileInfoCache& cache, std::string const& config,
+  std::string const& language,
+  std::vector<BT<std::string>> (cmGeneratorTarget::*compute)(
+    std::string const&, std::string const&) const) const
+{
+  CompileInfoCacheKey key(config, language);
+  auto i = cache.find(key);
+  if (i == cache.end()) {
+    i = cache.emplace(std::move(key), (this->*compute)(config, language))
+          .first;
+  }
+  return i->second;
+}
+
 std::vector<BT<std::string>> cmGeneratorTarget::GetIncludeDirectories(
   const std::string& config, const std::string& lang) const
+{
+  if (!this->GlobalGenerator->GetComputeDone()) {
+    return this->ComputeIncludeDirectories(config, lang);
+  }
+  return this->GetCachedCompileInfo(
+    this->IncludeDirectoriesCache, config, lang,
+    &cmGeneratorTarget::ComputeIncludeDirectories);
+}
+
+std::vector<BT<std::string>> cmGeneratorTarget::ComputeIncludeDirectories(
+  const std::string& config, const std::string& lang) const
 {
   std::vector<BT<std::string>> includes;
   std::unordered_set<std::string> uniqueIncludes;
@@ -3247,6 +3280,17 @@ void cmGeneratorTarget::GetCompileDefinitions(
 
 std::vector<BT<std::string>> cmGeneratorTarget::GetCompileDefinitions(
   std::string const& config, std::string const& language) const
+{
+  if (!this->GlobalGenerator->GetComputeDone()) {
+    return this->ComputeCompileDefinitions(config, language);
+  }
+  return this->GetCachedCompileInfo(
+    this->CompileDefinitionsCache, config, language,
+    &cmGeneratorTarget::ComputeCompileDefinitions);
+}
+
+std::vector<BT<std::string>> cmGeneratorTarget::ComputeCompileDefinitions(
+  std::string const& config, std::string const& language) const
 {
   std::vector<BT<std::string>> list;
   std::unordered_set<std::string> uniqueOptions;
@@ -575,6 +575,11 @@ public:
    */
   void ClearSourcesCache();
 
+  /** Clears the cached include directories and compile definitions.
+   * They will be recomputed on demand.
+   */
+  void ClearCompileInfoCache();
+
   void AddSource(const std::string& src, bool before = false);
   void AddTracedSources(std::vector<std::string> const& srcs);
 
@@ -763,6 +768,25 @@ private:
   std::set<cmSourceFile const*> ExplicitObjectName;
   mutable std::map<std::string, std::vector<std::string>> SystemIncludesCache;
 
+  // Include directories and compile definitions by configuration and
+  // language.  Only populated once the global generator is done
+  // computing, because targets may still be modified until then.
+  // Cleared together whenever a property they are computed from changes.
+  using CompileInfoCacheKey = std::pair<std::string, std::string>;
+  using CompileInfoCache =
+    std::map<CompileInfoCacheKey, std::vector<BT<std::string>>>;
+  mutable CompileInfoCache IncludeDirectoriesCache;
+  mutable CompileInfoCache CompileDefinitionsCache;
+  std::vector<BT<std::string>> const& GetCachedCompileInfo(
+    CompileInfoCache& cache, std::string const& config,
+    std::string const& language,
+    std::vector<BT<std::string>> (cmGeneratorTarget::*compute)(
+      std::string const&, std::string const&) const) const;
+  std::vector<BT<std::string>> ComputeIncludeDirectories(
+    const std::string& config, const std::string& lang) const;
+  std::vector<BT<std::string>> ComputeCompileDefinitions(
+    std::string const& config, std::string const& language) const;
+
   mutable std::string ExportMacro;
 
   void ConstructSourceFileFlags() const;
@@ -0,0 +1,214 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmGlobSnapshot.h"
+
+#include <cstdint>
+#include <utility>
+
+#include <cm/string_view>
+
+#include "cmsys/Directory.hxx"
+
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+
+// Bump the last byte whenever the record layout changes.
+cmBinaryCacheFile::Magic const Magic = { 'C', 'M', 'V', 'G', 'S', 'N',
+                                         '\0', '\2' };
+
+bool HasWildcard(std::string const& component)
+{
+  return component.find_first_of("*?[") != std::string::npos;
+}
+}
+
+void cmGlobSnapshot::AddGlob(bool recurse, bool followSymlinks,
+                             std::string const& expression)
+{
+  Glob glob;
+  glob.Recurse = recurse;
+  glob.FollowSymlinks = followSymlinks;
+  glob.Expression = expression;
+  this->Globs.push_back(std::move(glob));
+}
+
+bool cmGlobSnapshot::Load(std::string const& path)
+{
+  this->Globs.clear();
+  this->Stamps.clear();
+  this->Recorded = false;
+
+  std::string buffer;
+  cm::string_view payload;
+  if (!cmBinaryCacheFile::Read(path, Magic, buffer, payload)) {
+    return false;
+  }
+
+  cmBinaryCacheReader r(payload);
+  std::uint8_t recorded;
+  std::uint32_t numGlobs;
+  if (!r.Get(recorded) || !r.Get(numGlobs)) {
+    return false;
+  }
+  for (std::uint32_t i = 0; i < numGlobs; ++i) {
+    Glob glob;
+    std::uint8_t recurse;
+    std::uint8_t followSymlinks;
+    if (!r.Get(recurse) || !r.Get(followSymlinks) ||
+        !r.GetString(glob.Expression)) {
+      this->Globs.clear();
+      return false;
+    }
+    glob.Recurse = recurse != 0;
+    glob.FollowSymlinks = followSymlinks != 0;
+    this->Globs.push_back(std::move(glob));
+  }
+  while (!r.AtEnd()) {
+    PathStamp stamp;
+    std::uint8_t exists;
+    if (!r.GetString(stamp.Path) || !r.Get(exists) ||
+        !r.Get(stamp.Stamp.Size) || !r.Get(stamp.Stamp.MTime)) {
+      // Truncated or corrupt.  Keep the globs but never trust the times.
+      this->Stamps.clear();
+      return true;
+    }
+    stamp.Stamp.Exists = exists != 0;
+    this->Stamps.push_back(std::move(stamp));
+  }
+  this->Recorded = recorded != 0;
+  return true;
+}
+
+bool cmGlobSnapshot::Save(std::string const& path) const
+{
+  std::string out;
+  cmBinaryCacheWriter w(out);
+  cmBinaryCacheFile::WriteHeader(out, Magic);
+  w.Put(static_cast<std::uint8_t>(this->Recorded ? 1 : 0));
+  w.Put(static_cast<std::uint32_t>(this->Globs.size()));
+  for (Glob const& glob : this->Globs) {
+    w.Put(static_cast<std::uint8_t>(glob.Recurse ? 1 : 0));
+    w.Put(static_cast<std::uint8_t>(glob.FollowSymlinks ? 1 : 0));
+    w.PutString(glob.Expression);
+  }
+  for (PathStamp const& stamp : this->Stamps) {
+    w.PutString(stamp.Path);
+    w.Put(static_cast<std::uint8_t>(stamp.Stamp.Exists ? 1 : 0));
+    w.Put(stamp.Stamp.Size);
+    w.Put(stamp.Stamp.MTime);
+  }
+  return cmBinaryCacheFile::Write(path, out);
+}
+
+bool cmGlobSnapshot::IsUpToDate() const
+{
+  if (!this->Recorded) {
+    return false;
+  }
+  for (PathStamp const& stamp : this->Stamps) {
+    if (cmBinaryCacheFile::StampPath(stamp.Path) != stamp.Stamp) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool cmGlobSnapshot::Record(std::int64_t start)
+{
+  std::set<std::string> dirs;
+  for (Glob const& glob : this->Globs) {
+    std::vector<std::string> components;
+    cmSystemTools::SplitPath(glob.Expression, components, false);
+    if (components.size() < 2) {
+      continue;
+    }
+
+    // The last component always names the entries to match.  Leading
+    // components free of wildcards name the directory the glob starts
+    // from, and every further component is one more level to read.
+    size_t const last = components.size() - 1;
+    size_t k = 1;
+    while (k < last && !HasWildcard(components[k])) {
+      ++k;
+    }
+    std::string const root =
+      cmSystemTools::JoinPath(components.begin(), components.begin() + k);
+
+    // A glob starting from a directory that does not exist yet matches
+    // once the missing ancestors are created.  The parent also changes
+    // when the starting directory is replaced.
+    dirs.insert(root);
+    std::string dir = cmSystemTools::GetFilenamePath(root);
+    while (!dir.empty()) {
+      dirs.insert(dir);
+      std::string const parent = cmSystemTools::GetFilenamePath(dir);
+      if (cmSystemTools::FileIsDirectory(dir) || parent == dir) {
+        break;
+      }
+      dir = parent;
+    }
+
+    if (cmSystemTools::FileIsDirectory(root)) {
+      // Non-recursive globs match through symbolic links to directories.
+      int const depth = glob.Recurse ? -1 : static_cast<int>(last - k);
+      std::set<std::string> realPaths;
+      ListDirectories(root, depth, !glob.Recurse || glob.FollowSymlinks,
+                      realPaths, dirs);
+    }
+  }
+
+  std::vector<PathStamp> stamps;
+  stamps.reserve(dirs.size());
+  for (std::string const& dir : dirs) {
+    PathStamp stamp;
+    stamp.Path = dir;
+    stamp.Stamp = cmBinaryCacheFile::StampPath(dir);
+    if (!cmBinaryCacheFile::IsSettled(stamp.Stamp, start)) {
+      return false;
+    }
+    stamps.push_back(std::move(stamp));
+  }
+  this->Stamps = std::move(stamps);
+  this->Recorded = true;
+  return true;
+}
+
+void cmGlobSnapshot::ListDirectories(std::string const& dir, int depth,
+                                     bool followSymlinks,
+                                     std::set<std::string>& realPaths,
+                                     std::set<std::string>& dirs)
+{
+  dirs.insert(dir);
+  if (depth == 0) {
+    return;
+  }
+  // Links may form cycles.  Read each directory of an unlimited walk
+  // only once.
+  if (depth < 0 && followSymlinks &&
+      !realPaths.insert(cmSystemTools::GetRealPath(dir)).second) {
+    return;
+  }
+
+  cmsys::Directory d;
+  if (!d.Load(dir)) {
+    return;
+  }
+  unsigned long const n = d.GetNumberOfFiles();
+  for (unsigned long i = 0; i < n; ++i) {
+    std::string const name = d.GetFile(i);
+    if (name == "." || name == "..") {
+      continue;
+    }
+    std::string const path = cmStrCat(dir, '/', name);
+    if (!cmSystemTools::FileIsDirectory(path)) {
+      continue;
+    }
+    if (!followSymlinks && cmSystemTools::FileIsSymlink(path)) {
+      continue;
+    }
+    ListDirectories(path, depth < 0 ? depth : depth - 1, followSymlinks,
+                    realPaths, dirs);
+  }
+}
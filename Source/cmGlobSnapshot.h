@@ -0,0 +1,80 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmGlobSnapshot_h
+#define cmGlobSnapshot_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "cmBinaryCacheFile.h"
+
+/** \class cmGlobSnapshot
+ * \brief Modification times of the directories read by the globs of
+ *        the glob verification script.
+ *
+ * The result of a glob can change only if an entry is added to, removed
+ * from, or renamed in one of the directories it reads, which changes the
+ * modification time of that directory.  The snapshot lists the globs
+ * verified by the script together with the modification times of every
+ * directory they may read, so that checking them takes one stat call per
+ * directory instead of running the script.
+ *
+ * The globs are written when the build system is generated.  The times
+ * are recorded only after the script verified the globs, and only if no
+ * directory changed since the script was started.  Directories modified
+ * within a second before that are not trusted either, so a change within
+ * the resolution of a time stamp is never missed.
+ */
+class cmGlobSnapshot
+{
+public:
+  /** Add a glob expression verified by the script.  */
+  void AddGlob(bool recurse, bool followSymlinks,
+               std::string const& expression);
+
+  /** Read the snapshot file.  Return false if it is missing, corrupt,
+      or written by another version of CMake.  */
+  bool Load(std::string const& path);
+
+  /** Write the snapshot file.  */
+  bool Save(std::string const& path) const;
+
+  /** Return true if the directory times were recorded and none of the
+      directories changed since.  */
+  bool IsUpToDate() const;
+
+  /** Record the times of all directories the globs may read.  Return
+      false, and record nothing, if a directory was modified after, or
+      within a second before, the given time from
+      cmBinaryCacheFile::Now().  */
+  bool Record(std::int64_t start);
+
+private:
+  struct Glob
+  {
+    bool Recurse = false;
+    bool FollowSymlinks = false;
+    std::string Expression;
+  };
+
+  struct PathStamp
+  {
+    std::string Path;
+    cmBinaryCacheFile::Stamp Stamp;
+  };
+
+  static void ListDirectories(std::string const& dir, int depth,
+                              bool followSymlinks,
+                              std::set<std::string>& realPaths,
+                              std::set<std::string>& dirs);
+
+  std::vector<Glob> Globs;
+  std::vector<PathStamp> Stamps;
+  bool Recorded = false;
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include "cmsys/FStream.hxx"
 
 #include "cmGeneratedFileStream.h"
+#include "cmGlobSnapshot.h"
 #include "cmListFileCache.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
@@ -19,9 +20,11 @@ bool cmGlobVerificationManager::SaveVerificationScript(const std::string& path)
   }
 
   std::string scriptFile = cmStrCat(path, "/CMakeFiles");
+  std::string snapshotFile = scriptFile;
   std::string stampFile = scriptFile;
   cmSystemTools::MakeDirectory(scriptFile);
   scriptFile += "/VerifyGlobs.cmake";
+  snapshotFile += "/VerifyGlobs.bin";
   stampFile += "/cmake.verify_globs";
   cmGeneratedFileStream verifyScriptFile(scriptFile);
   verifyScriptFile.SetCopyIfDifferent(true);
@@ -32,6 +35,8 @@ bool cmGlobVerificationManager::SaveVerificationScript(const std::string& path)
     return false;
   }
 
+  cmGlobSnapshot snapshot;
+
   verifyScriptFile << std::boolalpha;
   verifyScriptFile << "# CMAKE generated file: DO NOT EDIT!\n"
                    << "# Generated by CMake Version "
@@ -55,6 +60,7 @@ bool cmGlobVerificationManager::SaveVerificationScript(const std::string& path)
     }
 
     k.PrintGlobCommand(verifyScriptFile, "NEW_GLOB");
+    snapshot.AddGlob(k.Recurse, k.FollowSymlinks, k.Expression);
     verifyScriptFile << "\n";
 
     verifyScriptFile << "set(OLD_GLOB\n";
@@ -70,6 +76,14 @@ bool cmGlobVerificationManager::SaveVerificationScript(const std::string& path)
   }
   verifyScriptFile.Close();
 
+  // The directory times are recorded by the first build that verifies
+  // the globs with the script.
+  if (!snapshot.Save(snapshotFile)) {
+    cmSystemTools::Error("Unable to write verification snapshot file. " +
+                         snapshotFile);
+    return false;
+  }
+
   cmsys::ofstream verifyStampFile(stampFile.c_str());
   if (!verifyStampFile) {
     cmSystemTools::Error("Unable to open verification stamp file for write. " +
@@ -79,6 +93,7 @@ bool cmGlobVerificationManager::SaveVerificationScript(const std::string& path)
   verifyStampFile << "# This file is generated by CMake for checking of the "
                      "VerifyGlobs.cmake file\n";
   this->VerifyScript = scriptFile;
+  this->VerifySnapshot = snapshotFile;
   this->VerifyStamp = stampFile;
   return true;
 }
@@ -175,5 +190,6 @@ void cmGlobVerificationManager::Reset()
 {
   this->Cache.clear();
   this->VerifyScript.clear();
+  this->VerifySnapshot.clear();
   this->VerifyStamp.clear();
 }
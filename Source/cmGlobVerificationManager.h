@@ -24,6 +24,7 @@ class cmGlobVerificationManager
 protected:
   //! Save verification script for given makefile.
   //! Saves to output <path>/<CMakeFilesDirectory>/VerifyGlobs.cmake
+  //! along with the directory snapshot VerifyGlobs.bin
   bool SaveVerificationScript(const std::string& path);
 
   //! Add an entry into the glob cache
@@ -40,8 +41,12 @@ protected:
   //! Check targets should be written in generated build system.
   bool DoWriteVerifyTarget() const;
 
-  //! Get the paths to the generated script and stamp files
+  //! Get the paths to the generated script, snapshot and stamp files
   std::string const& GetVerifyScript() const { return this->VerifyScript; }
+  std::string const& GetVerifySnapshot() const
+  {
+    return this->VerifySnapshot;
+  }
   std::string const& GetVerifyStamp() const { return this->VerifyStamp; }
 
 private:
@@ -75,6 +80,7 @@ private:
   using CacheEntryMap = std::map<CacheEntryKey, CacheEntryValue>;
   CacheEntryMap Cache;
   std::string VerifyScript;
+  std::string VerifySnapshot;
   std::string VerifyStamp;
 
   // Only cmState should be able to add cache values.
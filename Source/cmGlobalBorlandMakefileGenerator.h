@@ -44,6 +44,10 @@ public:
 
   bool AllowNotParallel() const override { return false; }
   bool AllowDeleteOnError() const override { return false; }
+  bool GetKeepGoingOptions(std::vector<std::string>&) const override
+  {
+    return false;
+  }
 
 protected:
   std::vector<GeneratedMakeCommand> GenerateBuildCommand(
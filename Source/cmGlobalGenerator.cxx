@@ -11,6 +11,8 @@
 #include <iterator>
 #include <sstream>
 
+#include <cm/algorithm>
+
 #include "cmsys/Directory.hxx"
 #include "cmsys/FStream.hxx"
 
@@ -49,6 +51,8 @@
 #  include "cm_jsoncpp_value.h"
 #  include "cm_jsoncpp_writer.h"
 
+#  include "cmsys/SystemInformation.hxx"
+
 #  include "cmCryptoHash.h"
 #  include "cmQtAutoGenGlobalInitializer.h"
 #endif
@@ -1355,6 +1359,9 @@ void cmGlobalGenerator::ComputeBuildFileGenerators()
 
 bool cmGlobalGenerator::Compute()
 {
+  this->ComputeDone = false;
+  this->GeneratorExpressionCache.Clear();
+
   // Some generators track files replaced during the Generate.
   // Start with an empty vector:
   this->FilesReplacedDuringGenerate.clear();
@@ -1449,9 +1456,39 @@ bool cmGlobalGenerator::Compute()
     localGen->ComputeHomeRelativeOutputPath();
   }
 
+  this->ComputeDone = true;
   return true;
 }
 
+void cmGlobalGenerator::ClearCompileInfoCaches()
+{
+  // Nothing is cached before Compute() is done.
+  if (!this->ComputeDone) {
+    return;
+  }
+  for (cmLocalGenerator* lg : this->LocalGenerators) {
+    for (cmGeneratorTarget* gt : lg->GetGeneratorTargets()) {
+      gt->ClearCompileInfoCache();
+    }
+  }
+}
+
+unsigned int cmGlobalGenerator::GetParallelThreadCount()
+{
+#ifndef CMAKE_BOOTSTRAP
+  static unsigned int count = 0;
+  // Detect only on the first call
+  if (count == 0) {
+    cmsys::SystemInformation info;
+    info.RunCPUCheck();
+    count = cm::clamp(info.GetNumberOfPhysicalCPU(), 1u, 64u);
+  }
+  return count;
+#else
+  return 1;
+#endif
+}
+
 void cmGlobalGenerator::Generate()
 {
   // Create a map from local generator to the complete set of targets
@@ -1460,7 +1497,11 @@ void cmGlobalGenerator::Generate()
 
   this->ProcessEvaluationFiles();
 
-  // Generate project files
+  // Generate project files.  The content is written one directory at a
+  // time but comparing and replacing the files on disk is done by
+  // multiple threads at the end.
+  cmGeneratedFileStream::ParallelReplace parallelReplace(
+    GetParallelThreadCount());
   for (unsigned int i = 0; i < this->LocalGenerators.size(); ++i) {
     this->SetCurrentMakefile(this->LocalGenerators[i]->GetMakefile());
     this->LocalGenerators[i]->Generate();
@@ -1475,6 +1516,7 @@ void cmGlobalGenerator::Generate()
         static_cast<float>(this->LocalGenerators.size()));
   }
   this->SetCurrentMakefile(nullptr);
+  parallelReplace.Finish();
 
   if (!this->GenerateCPackPropertiesFile()) {
     this->GetCMakeInstance()->IssueMessage(
@@ -1785,8 +1827,10 @@ void cmGlobalGenerator::CheckTargetProperties()
 int cmGlobalGenerator::TryCompile(int jobs, const std::string& srcdir,
                                   const std::string& bindir,
                                   const std::string& projectName,
-                                  const std::string& target, bool fast,
-                                  std::string& output, cmMakefile* mf)
+                                  std::vector<std::string> const& targetNames,
+                                  bool fast, std::string& output,
+                                  cmMakefile* mf,
+                                  std::vector<std::string> const& nativeOptions)
 {
   // if this is not set, then this is a first time configure
   // and there is a good chance that the try compile stuff will
@@ -1806,14 +1850,11 @@ int cmGlobalGenerator::TryCompile(int jobs, const std::string& srcdir,
                                         this->FirstTimeProgress);
   }
 
-  std::vector<std::string> newTarget = {};
-  if (!target.empty()) {
-    newTarget = { target };
-  }
   std::string config =
     mf->GetSafeDefinition("CMAKE_TRY_COMPILE_CONFIGURATION");
-  return this->Build(jobs, srcdir, bindir, projectName, newTarget, output, "",
-                     config, false, fast, false, this->TryCompileTimeout);
+  return this->Build(jobs, srcdir, bindir, projectName, targetNames, output,
+                     "", config, false, fast, false, this->TryCompileTimeout,
+                     cmSystemTools::OUTPUT_NONE, nativeOptions);
 }
 
 std::vector<cmGlobalGenerator::GeneratedMakeCommand>
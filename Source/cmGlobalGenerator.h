@@ -20,6 +20,7 @@
 #include "cmCustomCommandLines.h"
 #include "cmDuration.h"
 #include "cmExportSet.h"
+#include "cmGeneratorExpressionCache.h"
 #include "cmStateSnapshot.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
@@ -158,6 +159,9 @@ public:
    */
   virtual void Generate();
 
+  /** Number of threads to use for parallel work during generation.  */
+  static unsigned int GetParallelThreadCount();
+
   virtual cmLinkLineComputer* CreateLinkLineComputer(
     cmOutputConverter* outputConverter,
     cmStateDirectory const& stateDir) const;
@@ -194,12 +198,15 @@ public:
 
   /**
    * Try running cmake and building a file. This is used for dynamically
-   * loaded commands, not as part of the usual build process.
+   * loaded commands, not as part of the usual build process.  If no
+   * target names are given then all is assumed.
    */
   int TryCompile(int jobs, const std::string& srcdir,
                  const std::string& bindir, const std::string& projectName,
-                 const std::string& targetName, bool fast, std::string& output,
-                 cmMakefile* mf);
+                 std::vector<std::string> const& targetNames, bool fast,
+                 std::string& output, cmMakefile* mf,
+                 std::vector<std::string> const& nativeOptions =
+                   std::vector<std::string>());
 
   /**
    * Build a file given the following information. This is a more direct call
@@ -420,6 +427,14 @@ public:
 
   virtual bool IsIPOSupported() const { return false; }
 
+  /** Return whether the native build tool can keep building the other
+      targets requested after one of them fails, and if so the options
+      to do that.  Try-compile batches need this.  */
+  virtual bool GetKeepGoingOptions(std::vector<std::string>& /*options*/) const
+  {
+    return false;
+  }
+
   /** Return whether the generator can import external visual studio project
       using INCLUDE_EXTERNAL_MSPROJECT */
   virtual bool IsIncludeExternalMSProjectSupported() const { return false; }
@@ -472,6 +487,19 @@ public:
     return this->ConfigureDoneCMP0026AndCMP0024;
   }
 
+  /** Whether Compute() has finalized all generator targets.  */
+  bool GetComputeDone() const { return this->ComputeDone; }
+
+  /** Clear the include directories and compile definitions cached by all
+      generator targets.  Called when a target property they may be
+      computed from changes after Compute().  */
+  void ClearCompileInfoCaches();
+
+  cmGeneratorExpressionCache& GetGeneratorExpressionCache()
+  {
+    return this->GeneratorExpressionCache;
+  }
+
   std::string MakeSilentFlag;
 
   int RecursionDepth;
@@ -680,6 +708,8 @@ protected:
   bool ToolSupportsColor;
   bool InstallTargetEnabled;
   bool ConfigureDoneCMP0026AndCMP0024;
+  bool ComputeDone = false;
+  cmGeneratorExpressionCache GeneratorExpressionCache;
 };
 
 #endif
@@ -44,6 +44,12 @@ public:
   void EnableLanguage(std::vector<std::string> const& languages, cmMakefile*,
                       bool optional) override;
 
+  bool GetKeepGoingOptions(std::vector<std::string>& options) const override
+  {
+    options.emplace_back("/K");
+    return true;
+  }
+
 protected:
   std::vector<GeneratedMakeCommand> GenerateBuildCommand(
     const std::string& makeProgram, const std::string& projectName,
@@ -46,6 +46,8 @@ class cmLinkLineComputer;
 
 const char* cmGlobalNinjaGenerator::NINJA_BUILD_FILE = "build.ninja";
 const char* cmGlobalNinjaGenerator::NINJA_RULES_FILE = "rules.ninja";
+const char* cmGlobalNinjaGenerator::NINJA_DIRECTORY_BUILD_FILE =
+  "directory.ninja";
 const char* cmGlobalNinjaGenerator::INDENT = "  ";
 #ifdef _WIN32
 std::string const cmGlobalNinjaGenerator::SHELL_NOOP = "cd .";
@@ -282,7 +284,7 @@ void cmGlobalNinjaGenerator::WriteCustomCommandBuild(
     if (!depfile.empty()) {
       vars["depfile"] = depfile;
     }
-    this->WriteBuild(*this->BuildFileStream, build);
+    this->WriteBuild(*this->GetBuildFileStream(), build);
   }
 
   if (this->ComputingUnknownDependencies) {
@@ -311,7 +313,7 @@ void cmGlobalNinjaGenerator::WriteMacOSXContentBuild(std::string input,
     cmNinjaBuild build("COPY_OSX_CONTENT");
     build.Outputs.push_back(std::move(output));
     build.ExplicitDeps.push_back(std::move(input));
-    this->WriteBuild(*this->BuildFileStream, build);
+    this->WriteBuild(*this->GetBuildFileStream(), build);
   }
 }
 
@@ -490,6 +492,10 @@ void cmGlobalNinjaGenerator::Generate()
     (this->PolicyCMP0058 == cmPolicies::OLD ||
      this->PolicyCMP0058 == cmPolicies::WARN);
 
+  this->SplitBuildFiles =
+    this->LocalGenerators[0]->GetMakefile()->IsOn(
+      "CMAKE_NINJA_SPLIT_BUILD_FILES");
+
   this->cmGlobalGenerator::Generate();
 
   this->WriteAssumedSourceDependencies();
@@ -744,6 +750,60 @@ bool cmGlobalNinjaGenerator::OpenBuildFileStream()
   return true;
 }
 
+bool cmGlobalNinjaGenerator::OpenDirectoryBuildFileStream(
+  cmLocalGenerator* lg)
+{
+  if (!this->SplitBuildFiles) {
+    return false;
+  }
+
+  std::string const buildFilePath =
+    cmStrCat(lg->GetCurrentBinaryDirectory(), "/CMakeFiles/",
+             cmGlobalNinjaGenerator::NINJA_DIRECTORY_BUILD_FILE);
+  this->DirectoryBuildFileStream = cm::make_unique<cmGeneratedFileStream>(
+    buildFilePath, false, this->GetMakefileEncoding());
+  if (!(*this->DirectoryBuildFileStream)) {
+    // An error message is generated by the constructor if it cannot
+    // open the file.
+    this->DirectoryBuildFileStream.reset();
+    return false;
+  }
+  // Leave the file alone if the build statements of the directory did
+  // not change.
+  this->DirectoryBuildFileStream->SetCopyIfDifferent(true);
+
+  // Write the do not edit header.
+  this->WriteDisclaimer(*this->DirectoryBuildFileStream);
+
+  // Write a comment about this file.
+  *this->DirectoryBuildFileStream
+    << "# This file contains the build statements of the directory\n"
+    << "# " << lg->GetCurrentSourceDirectory() << "\n"
+    << "# It is included in the main '" << NINJA_BUILD_FILE << "'.\n\n";
+
+  // Include the file from the main build file.
+  std::string const relPath = this->NinjaOutputPath(
+    lg->MaybeConvertToRelativePath(
+      this->GetCMakeInstance()->GetHomeOutputDirectory(), buildFilePath));
+  cmGlobalNinjaGenerator::WriteComment(
+    *this->BuildFileStream,
+    cmStrCat("Build statements of directory ",
+             lg->GetCurrentSourceDirectory()));
+  *this->BuildFileStream << "subninja " << this->EncodePath(relPath)
+                         << "\n\n";
+  return true;
+}
+
+void cmGlobalNinjaGenerator::CloseDirectoryBuildFileStream()
+{
+  if (this->DirectoryBuildFileStream) {
+    if (cmSystemTools::GetErrorOccuredFlag()) {
+      this->DirectoryBuildFileStream->setstate(std::ios::failbit);
+    }
+    this->DirectoryBuildFileStream.reset();
+  }
+}
+
 void cmGlobalNinjaGenerator::CloseBuildFileStream()
 {
   if (this->BuildFileStream) {
@@ -1306,10 +1366,13 @@ void cmGlobalNinjaGenerator::WriteTargetRebuildManifest(std::ostream& os)
   if (this->SupportsManifestRestat() && cm->DoWriteGlobVerifyTarget()) {
     {
       cmNinjaRule rule("VERIFY_GLOBS");
-      rule.Command =
-        cmStrCat(CMakeCmd(), " -P ",
-                 lg->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
-                                           cmOutputConverter::SHELL));
+      rule.Command = cmStrCat(
+        CMakeCmd(), " -E __verify_globs ",
+        lg->ConvertToOutputFormat(cm->GetGlobVerifySnapshot(),
+                                  cmOutputConverter::SHELL),
+        ' ',
+        lg->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
+                                  cmOutputConverter::SHELL));
       rule.Description = "Re-checking globbed directories...";
       rule.Comment = "Rule for re-checking globbed directories.";
       rule.Generator = true;
@@ -60,6 +60,11 @@ public:
   /// It is included in the main build.ninja file.
   static const char* NINJA_RULES_FILE;
 
+  /// The name of the file holding the build statements of a directory
+  /// relative to its CMakeFiles directory, when they are split from the
+  /// main build file.  It is included in the main build.ninja file.
+  static const char* NINJA_DIRECTORY_BUILD_FILE;
+
   /// The indentation string used when generating Ninja's build file.
   static const char* INDENT;
 
@@ -100,6 +105,13 @@ public:
 
   bool IsIPOSupported() const override { return true; }
 
+  bool GetKeepGoingOptions(std::vector<std::string>& options) const override
+  {
+    options.emplace_back("-k");
+    options.emplace_back("0");
+    return true;
+  }
+
   /**
    * Write a build statement @a build to @a os.
    * @warning no escaping of any kind is done here.
@@ -206,9 +218,17 @@ public:
 
   cmGeneratedFileStream* GetBuildFileStream() const
   {
+    if (this->DirectoryBuildFileStream) {
+      return this->DirectoryBuildFileStream.get();
+    }
     return this->BuildFileStream.get();
   }
 
+  /// Redirect the build statements of the given directory to a file of
+  /// its own included by the main build file via 'subninja', if enabled.
+  bool OpenDirectoryBuildFileStream(cmLocalGenerator* lg);
+  void CloseDirectoryBuildFileStream();
+
   cmGeneratedFileStream* GetRulesFileStream() const
   {
     return this->RulesFileStream.get();
@@ -386,6 +406,10 @@ private:
   /// edge of the compilation DAG).
   std::unique_ptr<cmGeneratedFileStream> RulesFileStream;
   std::unique_ptr<cmGeneratedFileStream> CompileCommandsStream;
+  /// The file containing the build statements of the directory currently
+  /// being generated, if they are split from the main build file.
+  std::unique_ptr<cmGeneratedFileStream> DirectoryBuildFileStream;
+  bool SplitBuildFiles = false;
 
   /// The set of rules added to the generated build system.
   std::unordered_set<std::string> Rules;
@@ -25,8 +25,15 @@
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmTargetDepend.h"
+#include "cmTargetFingerprint.h"
 #include "cmake.h"
 
+#if !defined(CMAKE_BOOTSTRAP)
+#  include "cm_jsoncpp_value.h"
+
+#  include "cmMakefileProfilingData.h"
+#endif
+
 cmGlobalUnixMakefileGenerator3::cmGlobalUnixMakefileGenerator3(cmake* cm)
   : cmGlobalCommonGenerator(cm)
 {
@@ -48,6 +55,8 @@ cmGlobalUnixMakefileGenerator3::cmGlobalUnixMakefileGenerator3(cmake* cm)
   this->UnixCD = true;
 }
 
+cmGlobalUnixMakefileGenerator3::~cmGlobalUnixMakefileGenerator3() = default;
+
 void cmGlobalUnixMakefileGenerator3::EnableLanguage(
   std::vector<std::string> const& languages, cmMakefile* mf, bool optional)
 {
@@ -124,9 +133,39 @@ void cmGlobalUnixMakefileGenerator3::Configure()
 
 void cmGlobalUnixMakefileGenerator3::Generate()
 {
+#if !defined(CMAKE_BOOTSTRAP)
+  // Keep the rule files of targets whose generator inputs did not change
+  // since they were written, if requested.
+  this->NumberOfReusedTargets = 0;
+  this->NumberOfWrittenTargets = 0;
+  if (!this->CMakeInstance->GetIsInTryCompile() &&
+      this->Makefiles[0]->IsOn("CMAKE_REUSE_UNCHANGED_TARGETS")) {
+    this->TargetFingerprint = cm::make_unique<cmTargetFingerprint>(this);
+  }
+#endif
+
   // first do superclass method
   this->cmGlobalGenerator::Generate();
 
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->TargetFingerprint) {
+    this->TargetFingerprint.reset();
+    this->CMakeInstance->UpdateProgress(
+      cmStrCat("Reused build files of ", this->NumberOfReusedTargets,
+               " out of ",
+               this->NumberOfReusedTargets + this->NumberOfWrittenTargets,
+               " targets"),
+      -1);
+    if (cmMakefileProfilingData* profilingOutput =
+          this->CMakeInstance->GetProfilingOutput()) {
+      Json::Value counters(Json::objectValue);
+      counters["reused"] = Json::Value::UInt64(this->NumberOfReusedTargets);
+      counters["written"] = Json::Value::UInt64(this->NumberOfWrittenTargets);
+      profilingOutput->WriteCounter("TargetFingerprint", std::move(counters));
+    }
+  }
+#endif
+
   // initialize progress
   unsigned long total = 0;
   for (auto const& pmi : this->ProgressMap) {
@@ -827,6 +866,34 @@ void cmGlobalUnixMakefileGenerator3::RecordTargetProgress(
   tp.VariableFile = tg->GetProgressFileNameFull();
 }
 
+std::string cmGlobalUnixMakefileGenerator3::GetTargetFingerprint(
+  cmGeneratorTarget const* target, std::string const& config)
+{
+#if !defined(CMAKE_BOOTSTRAP)
+  // The rule files of targets whose generation has side effects beyond
+  // their own target directory are always written.
+  if (this->TargetFingerprint &&
+      !target->Makefile->IsOn("CMAKE_EXPORT_COMPILE_COMMANDS") &&
+      !target->IsAppBundleOnApple() && !target->IsFrameworkOnApple() &&
+      !target->IsCFBundleOnApple()) {
+    return this->TargetFingerprint->Compute(target, config);
+  }
+#else
+  static_cast<void>(target);
+  static_cast<void>(config);
+#endif
+  return std::string();
+}
+
+void cmGlobalUnixMakefileGenerator3::RecordTargetReuse(bool reused)
+{
+  if (reused) {
+    ++this->NumberOfReusedTargets;
+  } else {
+    ++this->NumberOfWrittenTargets;
+  }
+}
+
 void cmGlobalUnixMakefileGenerator3::TargetProgress::WriteProgressVariables(
   unsigned long total, unsigned long& current)
 {
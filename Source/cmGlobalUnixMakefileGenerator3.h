@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -22,6 +23,7 @@ class cmLocalGenerator;
 class cmLocalUnixMakefileGenerator3;
 class cmMakefile;
 class cmMakefileTargetGenerator;
+class cmTargetFingerprint;
 class cmake;
 struct cmDocumentationEntry;
 
@@ -61,6 +63,7 @@ class cmGlobalUnixMakefileGenerator3 : public cmGlobalCommonGenerator
 {
 public:
   cmGlobalUnixMakefileGenerator3(cmake* cm);
+  ~cmGlobalUnixMakefileGenerator3() override;
   static cmGlobalGeneratorFactory* NewFactory()
   {
     return new cmGlobalGeneratorSimpleFactory<
@@ -137,6 +140,16 @@ public:
   /** Record per-target progress information.  */
   void RecordTargetProgress(cmMakefileTargetGenerator* tg);
 
+  /** Get the fingerprint of the generator inputs of a target.  The rule
+      files of the target may be kept if it matches the fingerprint
+      recorded when they were written.  Returns an empty string if the
+      rule files must be written.  */
+  std::string GetTargetFingerprint(cmGeneratorTarget const* target,
+                                   std::string const& config);
+
+  /** Record whether the rule files of a target were kept.  */
+  void RecordTargetReuse(bool reused);
+
   void AddCXXCompileCommand(const std::string& sourceFile,
                             const std::string& workingDirectory,
                             const std::string& compileCommand);
@@ -149,6 +162,12 @@ public:
 
   bool IsIPOSupported() const override { return true; }
 
+  bool GetKeepGoingOptions(std::vector<std::string>& options) const override
+  {
+    options.emplace_back("-k");
+    return true;
+  }
+
   void ComputeTargetObjectDirectory(cmGeneratorTarget* gt) const override;
 
   std::string IncludeDirective;
@@ -231,6 +250,10 @@ protected:
 
   cmGeneratedFileStream* CommandDatabase;
 
+  std::unique_ptr<cmTargetFingerprint> TargetFingerprint;
+  unsigned long NumberOfReusedTargets = 0;
+  unsigned long NumberOfWrittenTargets = 0;
+
 private:
   const char* GetBuildIgnoreErrorsFlag() const override { return "-i"; }
   std::string GetEditCacheCommand() const override;
@@ -149,7 +149,8 @@ bool cmGlobalVisualStudio8Generator::AddCheckTarget()
     cmake* cm = this->GetCMakeInstance();
     if (cm->DoWriteGlobVerifyTarget()) {
       cmCustomCommandLines verifyCommandLines = cmMakeSingleCommandLine(
-        { cmSystemTools::GetCMakeCommand(), "-P", cm->GetGlobVerifyScript() });
+        { cmSystemTools::GetCMakeCommand(), "-E", "__verify_globs",
+          cm->GetGlobVerifySnapshot(), cm->GetGlobVerifyScript() });
       std::vector<std::string> byproducts;
       byproducts.push_back(cm->GetGlobVerifyStamp());
 
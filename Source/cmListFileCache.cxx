@@ -15,6 +15,10 @@
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
+#ifndef CMAKE_BOOTSTRAP
+#  include "cmParsedListFileCache.h"
+#endif
+
 cmCommandContext::cmCommandName& cmCommandContext::cmCommandName::operator=(
   std::string const& name)
 {
@@ -42,6 +46,7 @@ struct cmListFileParser
   const char* FileName;
   cmListFileLexer* Lexer;
   cmListFileFunction Function;
+  bool IssuedWarning = false;
   enum
   {
     SeparationOkay,
@@ -145,19 +150,40 @@ bool cmListFileParser::ParseFile()
 }
 
 bool cmListFile::ParseFile(const char* filename, cmMessenger* messenger,
-                           cmListFileBacktrace const& lfbt)
+                           cmListFileBacktrace const& lfbt,
+                           cmParsedListFileCache* cache)
 {
   if (!cmSystemTools::FileExists(filename) ||
       cmSystemTools::FileIsDirectory(filename)) {
     return false;
   }
 
+#ifndef CMAKE_BOOTSTRAP
+  if (cache && cache->Lookup(filename, this->Functions)) {
+    return true;
+  }
+#else
+  static_cast<void>(cache);
+#endif
+
   bool parseError = false;
+  bool issuedWarning = false;
 
   {
     cmListFileParser parser(this, lfbt, messenger, filename);
     parseError = !parser.ParseFile();
+    issuedWarning = parser.IssuedWarning;
+  }
+
+#ifndef CMAKE_BOOTSTRAP
+  // Only cache files that parse cleanly so that diagnostics are
+  // reported again on the next run.
+  if (cache && !parseError && !issuedWarning) {
+    cache->Store(filename, this->Functions);
   }
+#else
+  static_cast<void>(issuedWarning);
+#endif
 
   return !parseError;
 }
@@ -284,6 +310,7 @@ bool cmListFileParser::AddArgument(cmListFileLexer_Token* token,
     return false;
   }
   this->Messenger->IssueMessage(MessageType::AUTHOR_WARNING, m.str(), lfbt);
+  this->IssuedWarning = true;
   return true;
 }
 
@@ -22,6 +22,7 @@
  */
 
 class cmMessenger;
+class cmParsedListFileCache;
 
 struct cmCommandContext
 {
@@ -181,8 +182,12 @@ std::vector<BT<std::string>> ExpandListWithBacktrace(
 
 struct cmListFile
 {
+  // Parse the given file.  If a parsed list file cache is given, the
+  // functions are restored from it when the file is unchanged, and
+  // stored in it after a parse that produced no diagnostics.
   bool ParseFile(const char* path, cmMessenger* messenger,
-                 cmListFileBacktrace const& lfbt);
+                 cmListFileBacktrace const& lfbt,
+                 cmParsedListFileCache* cache = nullptr);
 
   std::vector<cmListFileFunction> Functions;
 };
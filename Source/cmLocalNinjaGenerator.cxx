@@ -82,6 +82,9 @@ void cmLocalNinjaGenerator::Generate()
     }
   }
 
+  cmGlobalNinjaGenerator* gg = this->GetGlobalNinjaGenerator();
+  gg->OpenDirectoryBuildFileStream(this);
+
   for (cmGeneratorTarget* target : this->GetGeneratorTargets()) {
     if (target->GetType() == cmStateEnums::INTERFACE_LIBRARY) {
       continue;
@@ -94,6 +97,8 @@ void cmLocalNinjaGenerator::Generate()
 
   this->WriteCustomCommandBuildStatements();
   this->AdditionalCleanFiles();
+
+  gg->CloseDirectoryBuildFileStream();
 }
 
 // TODO: Picked up from cmLocalUnixMakefileGenerator3.  Refactor it.
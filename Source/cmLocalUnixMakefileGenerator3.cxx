@@ -128,7 +128,7 @@ void cmLocalUnixMakefileGenerator3::Generate()
     std::unique_ptr<cmMakefileTargetGenerator> tg(
       cmMakefileTargetGenerator::New(target));
     if (tg) {
-      tg->WriteRuleFiles();
+      tg->WriteRuleFilesIfChanged();
       gg->RecordTargetProgress(tg.get());
     }
   }
@@ -760,10 +760,13 @@ void cmLocalUnixMakefileGenerator3::WriteSpecialTargetsBottom(
     std::vector<std::string> commands;
     cmake* cm = this->GlobalGenerator->GetCMakeInstance();
     if (cm->DoWriteGlobVerifyTarget()) {
-      std::string rescanRule =
-        cmStrCat("$(CMAKE_COMMAND) -P ",
-                 this->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
-                                             cmOutputConverter::SHELL));
+      std::string rescanRule = cmStrCat(
+        "$(CMAKE_COMMAND) -E __verify_globs ",
+        this->ConvertToOutputFormat(cm->GetGlobVerifySnapshot(),
+                                    cmOutputConverter::SHELL),
+        ' ',
+        this->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
+                                    cmOutputConverter::SHELL));
       commands.push_back(rescanRule);
     }
     std::string cmakefileName = "CMakeFiles/Makefile.cmake";
@@ -1686,10 +1689,13 @@ void cmLocalUnixMakefileGenerator3::WriteLocalAllRules(
     commands.clear();
     cmake* cm = this->GlobalGenerator->GetCMakeInstance();
     if (cm->DoWriteGlobVerifyTarget()) {
-      std::string rescanRule =
-        cmStrCat("$(CMAKE_COMMAND) -P ",
-                 this->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
-                                             cmOutputConverter::SHELL));
+      std::string rescanRule = cmStrCat(
+        "$(CMAKE_COMMAND) -E __verify_globs ",
+        this->ConvertToOutputFormat(cm->GetGlobVerifySnapshot(),
+                                    cmOutputConverter::SHELL),
+        ' ',
+        this->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
+                                    cmOutputConverter::SHELL));
       commands.push_back(rescanRule);
     }
     std::string cmakefileName = "CMakeFiles/Makefile.cmake";
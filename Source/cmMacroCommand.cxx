@@ -20,6 +20,11 @@
 #include "cmState.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
+#include "cmake.h"
+
+#if !defined(CMAKE_BOOTSTRAP)
+#  include "cmMakefileProfilingData.h"
+#endif
 
 namespace {
 
@@ -60,6 +65,13 @@ bool cmMacroHelperCommand::operator()(
     return false;
   }
 
+#if !defined(CMAKE_BOOTSTRAP)
+  if (cmMakefileProfilingData* profilingOutput =
+        makefile.GetCMakeInstance()->GetProfilingOutput()) {
+    profilingOutput->RefineEntry("macro", expandedArgs);
+  }
+#endif
+
   cmMakefile::MacroPushPop macroScope(&makefile, this->FilePath,
                                       this->Policies);
 
@@ -2,9 +2,11 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmMakeDirectoryCommand.h"
 
+#include "cmDirectoryListingCache.h"
 #include "cmExecutionStatus.h"
 #include "cmMakefile.h"
 #include "cmSystemTools.h"
+#include "cmake.h"
 
 // cmMakeDirectoryCommand
 bool cmMakeDirectoryCommand(std::vector<std::string> const& args,
@@ -21,6 +23,10 @@ bool cmMakeDirectoryCommand(std::vector<std::string> const& args,
     cmSystemTools::SetFatalErrorOccured();
     return false;
   }
+  status.GetMakefile()
+    .GetCMakeInstance()
+    ->GetDirectoryListingCache()
+    ->Invalidate(args[0]);
   cmSystemTools::MakeDirectory(args[0]);
   return true;
 }
@@ -25,6 +25,7 @@
 #include "cmCommandArgumentParserHelper.h"
 #include "cmCustomCommand.h"
 #include "cmCustomCommandLines.h"
+#include "cmDirectoryListingCache.h"
 #include "cmExecutionStatus.h"
 #include "cmExpandedCommandArgument.h" // IWYU pragma: keep
 #include "cmFileLockPool.h"
@@ -49,11 +50,13 @@
 #include "cmTargetLinkLibraryType.h"
 #include "cmTest.h"
 #include "cmTestGenerator.h" // IWYU pragma: keep
+#include "cmTryCompileBatch.h"
 #include "cmVersion.h"
 #include "cmWorkingDirectory.h"
 #include "cmake.h"
 
 #ifndef CMAKE_BOOTSTRAP
+#  include "cmMakefileProfilingData.h"
 #  include "cmVariableWatch.h"
 #endif
 
@@ -390,6 +393,12 @@ bool cmMakefile::ExecuteCommand(const cmListFileFunction& lff,
   cmMakefileCall stack_manager(this, lff, status);
   static_cast<void>(stack_manager);
 
+#if !defined(CMAKE_BOOTSTRAP)
+  cmMakefileProfilingData::RAII profilingRAII(
+    this->GetCMakeInstance()->GetProfilingOutput(), lff, this->Backtrace);
+  static_cast<void>(profilingRAII);
+#endif
+
   // Check for maximum recursion depth.
   int depth = CMake_DEFAULT_RECURSION_LIMIT;
   const char* depthStr = this->GetDefinition("CMAKE_MAXIMUM_RECURSION_DEPTH");
@@ -587,8 +596,7 @@ bool cmMakefile::ReadDependentFile(const std::string& filename,
   IncludeScope incScope(this, filenametoread, noPolicyScope);
 
   cmListFile listFile;
-  if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!this->ParseListFile(listFile, filenametoread)) {
     return false;
   }
 
@@ -641,8 +649,7 @@ bool cmMakefile::ReadListFile(const std::string& filename)
   ListFileScope scope(this, filenametoread);
 
   cmListFile listFile;
-  if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!this->ParseListFile(listFile, filenametoread)) {
     return false;
   }
 
@@ -653,12 +660,30 @@ bool cmMakefile::ReadListFile(const std::string& filename)
   return true;
 }
 
+bool cmMakefile::ParseListFile(cmListFile& listFile,
+                               const std::string& filename)
+{
+  cmParsedListFileCache* cache = nullptr;
+#if !defined(CMAKE_BOOTSTRAP)
+  cache = this->GetCMakeInstance()->GetParsedListFileCache();
+#endif
+  return listFile.ParseFile(filename.c_str(), this->GetMessenger(),
+                            this->Backtrace, cache);
+}
+
 void cmMakefile::ReadListFile(cmListFile const& listFile,
                               std::string const& filenametoread)
 {
   // add this list file to the list of dependencies
   this->ListFiles.push_back(filenametoread);
 
+#if !defined(CMAKE_BOOTSTRAP)
+  cmMakefileProfilingData::RAII profilingRAII(
+    this->GetCMakeInstance()->GetProfilingOutput(), "listfile",
+    filenametoread, this->Backtrace);
+  static_cast<void>(profilingRAII);
+#endif
+
   std::string currentParentFile =
     this->GetSafeDefinition("CMAKE_PARENT_LIST_FILE");
   std::string currentFile = this->GetSafeDefinition("CMAKE_CURRENT_LIST_FILE");
@@ -1601,14 +1626,14 @@ void cmMakefile::Configure()
   // make sure the CMakeFiles dir is there
   std::string filesDir = cmStrCat(
     this->StateSnapshot.GetDirectory().GetCurrentBinary(), "/CMakeFiles");
+  this->GetCMakeInstance()->GetDirectoryListingCache()->Invalidate(filesDir);
   cmSystemTools::MakeDirectory(filesDir);
 
   assert(cmSystemTools::FileExists(currentStart, true));
   this->AddDefinition("CMAKE_PARENT_LIST_FILE", currentStart);
 
   cmListFile listFile;
-  if (!listFile.ParseFile(currentStart.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!this->ParseListFile(listFile, currentStart)) {
     return;
   }
   if (this->IsRootMakefile()) {
@@ -1691,7 +1716,12 @@ void cmMakefile::Configure()
   this->ReadListFile(listFile, currentStart);
   if (cmSystemTools::GetFatalErrorOccured()) {
     scope.Quiet();
+  } else if (this->TryCompileBatch) {
+    this->IssueMessage(MessageType::FATAL_ERROR,
+                       "cmake_check_batch(BEGIN) has no matching "
+                       "cmake_check_batch(END).");
   }
+  this->TryCompileBatch.reset();
 
   // at the end handle any old style subdirs
   std::vector<cmMakefile*> subdirs = this->UnConfiguredDirectories;
@@ -1774,6 +1804,7 @@ void cmMakefile::AddSubDirectory(const std::string& srcPath,
   newSnapshot.GetDirectory().SetCurrentSource(srcPath);
   newSnapshot.GetDirectory().SetCurrentBinary(binPath);
 
+  this->GetCMakeInstance()->GetDirectoryListingCache()->Invalidate(binPath);
   cmSystemTools::MakeDirectory(binPath);
 
   cmMakefile* subMf = new cmMakefile(this->GlobalGenerator, newSnapshot);
@@ -3603,15 +3634,20 @@ void cmMakefile::EnableLanguage(std::vector<std::string> const& lang,
 int cmMakefile::TryCompile(const std::string& srcdir,
                            const std::string& bindir,
                            const std::string& projectName,
-                           const std::string& targetName, bool fast, int jobs,
+                           std::vector<std::string> const& targetNames,
+                           bool fast, int jobs,
                            const std::vector<std::string>* cmakeArgs,
-                           std::string& output)
+                           std::string& output,
+                           std::vector<std::string> const& nativeOptions,
+                           bool* configureFailed)
 {
   this->IsSourceFileTryCompile = fast;
   // does the binary directory exist ? If not create it...
   if (!cmSystemTools::FileIsDirectory(bindir)) {
     cmSystemTools::MakeDirectory(bindir);
   }
+  // The test project writes its files below the binary directory.
+  this->GetCMakeInstance()->GetDirectoryListingCache()->Invalidate(bindir);
 
   // change to the tests directory and run cmake
   // use the cmake object instead of calling cmake
@@ -3706,24 +3742,33 @@ int cmMakefile::TryCompile(const std::string& srcdir,
                      cmStateEnums::INTERNAL);
   }
   if (cm.Configure() != 0) {
-    this->IssueMessage(MessageType::FATAL_ERROR,
-                       "Failed to configure test project build system.");
-    cmSystemTools::SetFatalErrorOccured();
+    if (configureFailed) {
+      *configureFailed = true;
+    } else {
+      this->IssueMessage(MessageType::FATAL_ERROR,
+                         "Failed to configure test project build system.");
+      cmSystemTools::SetFatalErrorOccured();
+    }
     this->IsSourceFileTryCompile = false;
     return 1;
   }
 
   if (cm.Generate() != 0) {
-    this->IssueMessage(MessageType::FATAL_ERROR,
-                       "Failed to generate test project build system.");
-    cmSystemTools::SetFatalErrorOccured();
+    if (configureFailed) {
+      *configureFailed = true;
+    } else {
+      this->IssueMessage(MessageType::FATAL_ERROR,
+                         "Failed to generate test project build system.");
+      cmSystemTools::SetFatalErrorOccured();
+    }
     this->IsSourceFileTryCompile = false;
     return 1;
   }
 
   // finally call the generator to actually build the resulting project
   int ret = this->GetGlobalGenerator()->TryCompile(
-    jobs, srcdir, bindir, projectName, targetName, fast, output, this);
+    jobs, srcdir, bindir, projectName, targetNames, fast, output, this,
+    nativeOptions);
 
   this->IsSourceFileTryCompile = false;
   return ret;
@@ -3734,6 +3779,16 @@ bool cmMakefile::GetIsSourceFileTryCompile() const
   return this->IsSourceFileTryCompile;
 }
 
+void cmMakefile::SetTryCompileBatch(std::unique_ptr<cmTryCompileBatch> batch)
+{
+  this->TryCompileBatch = std::move(batch);
+}
+
+std::unique_ptr<cmTryCompileBatch> cmMakefile::TakeTryCompileBatch()
+{
+  return std::move(this->TryCompileBatch);
+}
+
 cmake* cmMakefile::GetCMakeInstance() const
 {
   return this->GlobalGenerator->GetCMakeInstance();
@@ -3960,6 +4015,7 @@ int cmMakefile::ConfigureFile(const std::string& infile,
 
   mode_t perm = 0;
   cmSystemTools::GetPermissions(sinfile, perm);
+  this->GetCMakeInstance()->GetDirectoryListingCache()->Invalidate(soutfile);
   std::string::size_type pos = soutfile.rfind('/');
   if (pos != std::string::npos) {
     std::string path = soutfile.substr(0, pos);
@@ -56,6 +56,7 @@ class cmTest;
 class cmTestGenerator;
 class cmVariableWatch;
 class cmake;
+struct cmTryCompileBatch;
 
 /** Flag if byproducts shall also be considered.  */
 enum class cmSourceOutputKind
@@ -135,16 +136,32 @@ public:
 
   /**
    * Try running cmake and building a file. This is used for dynalically
-   * loaded commands, not as part of the usual build process.
+   * loaded commands, not as part of the usual build process.  If no
+   * target names are given then all is assumed.  If configureFailed is
+   * given, a failure to configure or generate the project sets it
+   * instead of being reported as a fatal error.
    */
   int TryCompile(const std::string& srcdir, const std::string& bindir,
-                 const std::string& projectName, const std::string& targetName,
-                 bool fast, int jobs,
-                 const std::vector<std::string>* cmakeArgs,
-                 std::string& output);
+                 const std::string& projectName,
+                 std::vector<std::string> const& targetNames, bool fast,
+                 int jobs, const std::vector<std::string>* cmakeArgs,
+                 std::string& output,
+                 std::vector<std::string> const& nativeOptions =
+                   std::vector<std::string>(),
+                 bool* configureFailed = nullptr);
 
   bool GetIsSourceFileTryCompile() const;
 
+  /**
+   * The batch of checks opened by cmake_check_batch(BEGIN), if any.
+   */
+  cmTryCompileBatch* GetTryCompileBatch() const
+  {
+    return this->TryCompileBatch.get();
+  }
+  void SetTryCompileBatch(std::unique_ptr<cmTryCompileBatch> batch);
+  std::unique_ptr<cmTryCompileBatch> TakeTryCompileBatch();
+
   /**
    * Help enforce global target name uniqueness.
    */
@@ -1014,6 +1031,8 @@ private:
   void ReadListFile(cmListFile const& listFile,
                     const std::string& filenametoread);
 
+  bool ParseListFile(cmListFile& listFile, const std::string& filename);
+
   bool ParseDefineFlag(std::string const& definition, bool remove);
 
   bool EnforceUniqueDir(const std::string& srcPath,
@@ -1036,6 +1055,7 @@ private:
   mutable cmsys::RegularExpression cmNamedCurly;
 
   std::vector<cmMakefile*> UnConfiguredDirectories;
+  std::unique_ptr<cmTryCompileBatch> TryCompileBatch;
   std::vector<cmExportBuildFileGenerator*> ExportBuildFileGenerators;
 
   std::vector<cmGeneratorExpressionEvaluationFile*> EvaluationFiles;
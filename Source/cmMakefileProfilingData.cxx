@@ -0,0 +1,207 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmMakefileProfilingData.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+#include "cm_jsoncpp_writer.h"
+#include "cm_uv.h"
+
+#include "cmListFileCache.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+Json::Value BacktraceToJson(cmListFileBacktrace bt)
+{
+  Json::Value frames(Json::arrayValue);
+  for (; !bt.Empty(); bt = bt.Pop()) {
+    cmListFileContext const& lfc = bt.Top();
+    if (lfc.Name.empty()) {
+      // Skip whole-file scopes; the enclosing command names the file.
+      continue;
+    }
+    frames.append(cmStrCat(lfc.FilePath, ':', lfc.Line, " (", lfc.Name, ')'));
+  }
+  return frames;
+}
+}
+
+cmMakefileProfilingData::cmMakefileProfilingData(
+  const std::string& profileStream)
+  : ProcessId(static_cast<int>(uv_os_getpid()))
+{
+  std::ios::openmode omode = std::ios::out | std::ios::trunc;
+  this->ProfileStream.open(profileStream.c_str(), omode);
+  if (!this->ProfileStream.good()) {
+    throw std::runtime_error(std::string("Unable to open: ") + profileStream);
+  }
+
+  Json::StreamWriterBuilder wbuilder;
+  wbuilder["indentation"] = "";
+  this->JsonWriter =
+    std::unique_ptr<Json::StreamWriter>(wbuilder.newStreamWriter());
+
+  this->ProfileStream << "[";
+}
+
+cmMakefileProfilingData::~cmMakefileProfilingData() noexcept
+{
+  this->WritePendingEntry();
+  if (this->ProfileStream.good()) {
+    try {
+      this->ProfileStream << "]";
+      this->ProfileStream.close();
+    } catch (...) {
+      cmSystemTools::Error("Error writing profiling output!");
+    }
+  }
+}
+
+Json::Value::UInt64 cmMakefileProfilingData::GetTimestamp() const
+{
+  return static_cast<Json::Value::UInt64>(
+    std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch())
+      .count());
+}
+
+void cmMakefileProfilingData::WriteEvent(Json::Value const& v)
+{
+  /* Do not try again if we previously failed to write to output. */
+  if (!this->ProfileStream.good()) {
+    return;
+  }
+
+  try {
+    if (!this->First) {
+      this->ProfileStream << ",\n";
+    }
+    this->First = false;
+    this->JsonWriter->write(v, &this->ProfileStream);
+  } catch (std::ios_base::failure& fail) {
+    cmSystemTools::Error(
+      cmStrCat("Failed to write to profiling output: ", fail.what()));
+  } catch (...) {
+    cmSystemTools::Error("Error writing profiling output!");
+  }
+}
+
+void cmMakefileProfilingData::WritePendingEntry()
+{
+  if (this->HasPendingEntry) {
+    this->HasPendingEntry = false;
+    this->WriteEvent(this->PendingEntry);
+  }
+}
+
+void cmMakefileProfilingData::StartEntry(const cmListFileFunction& lff,
+                                         cmListFileBacktrace const& bt)
+{
+  Json::Value args(Json::objectValue);
+  if (!lff.Arguments.empty()) {
+    std::string functionArgs;
+    for (cmListFileArgument const& a : lff.Arguments) {
+      if (!functionArgs.empty()) {
+        functionArgs += ' ';
+      }
+      functionArgs += a.Value;
+    }
+    args["functionArgs"] = functionArgs;
+  }
+  this->StartEntry("cmake", lff.Name.Original, bt, std::move(args));
+}
+
+void cmMakefileProfilingData::StartEntry(std::string const& category,
+                                         std::string const& name,
+                                         cmListFileBacktrace const& bt,
+                                         Json::Value args)
+{
+  if (!bt.Empty()) {
+    cmListFileContext const& lfc = bt.Top();
+    if (lfc.Line) {
+      args["location"] = cmStrCat(lfc.FilePath, ':', lfc.Line);
+    }
+    args["backtrace"] = BacktraceToJson(bt);
+  }
+
+  Json::Value v;
+  v["ph"] = "B";
+  v["name"] = name;
+  v["cat"] = category;
+  v["ts"] = this->GetTimestamp();
+  v["pid"] = this->ProcessId;
+  v["tid"] = 0;
+  v["args"] = std::move(args);
+
+  this->WritePendingEntry();
+  this->PendingEntry = std::move(v);
+  this->HasPendingEntry = true;
+}
+
+void cmMakefileProfilingData::RefineEntry(
+  std::string const& category, std::vector<std::string> const& expandedArgs)
+{
+  if (this->HasPendingEntry) {
+    this->PendingEntry["cat"] = category;
+    this->PendingEntry["args"]["expandedArgs"] = cmJoin(expandedArgs, " ");
+  }
+}
+
+void cmMakefileProfilingData::StopEntry()
+{
+  this->WritePendingEntry();
+
+  Json::Value v;
+  v["ph"] = "E";
+  v["ts"] = this->GetTimestamp();
+  v["pid"] = this->ProcessId;
+  v["tid"] = 0;
+  this->WriteEvent(v);
+}
+
+void cmMakefileProfilingData::WriteCounter(std::string const& name,
+                                           Json::Value values)
+{
+  this->WritePendingEntry();
+
+  Json::Value v;
+  v["ph"] = "C";
+  v["name"] = name;
+  v["ts"] = this->GetTimestamp();
+  v["pid"] = this->ProcessId;
+  v["tid"] = 0;
+  v["args"] = std::move(values);
+  this->WriteEvent(v);
+}
+
+cmMakefileProfilingData::RAII::RAII(cmMakefileProfilingData* data,
+                                    const cmListFileFunction& lff,
+                                    cmListFileBacktrace const& bt)
+  : Data(data)
+{
+  if (this->Data) {
+    this->Data->StartEntry(lff, bt);
+  }
+}
+
+cmMakefileProfilingData::RAII::RAII(cmMakefileProfilingData* data,
+                                    std::string const& category,
+                                    std::string const& name,
+                                    cmListFileBacktrace const& bt,
+                                    Json::Value args)
+  : Data(data)
+{
+  if (this->Data) {
+    this->Data->StartEntry(category, name, bt, std::move(args));
+  }
+}
+
+cmMakefileProfilingData::RAII::~RAII()
+{
+  if (this->Data) {
+    this->Data->StopEntry();
+  }
+}
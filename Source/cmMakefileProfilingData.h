@@ -0,0 +1,97 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmMakefileProfilingData_h
+#define cmMakefileProfilingData_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cmsys/FStream.hxx"
+
+#include "cm_jsoncpp_value.h"
+
+namespace Json {
+class StreamWriter;
+}
+
+class cmListFileBacktrace;
+struct cmListFileFunction;
+
+/** \class cmMakefileProfilingData
+ * \brief Write configure-time profiling events in Google Trace format.
+ *
+ * Every entry started with StartEntry must be closed by a matching
+ * StopEntry.  The resulting file can be loaded in chrome://tracing or
+ * any other viewer understanding the Trace Event Format.
+ *
+ * The start of an entry is written only once the next event is, so that
+ * the implementation of a command may still refine it.  A call to a
+ * function or macro is thus recorded as one entry of that category
+ * instead of a command entry with a nested one.
+ */
+class cmMakefileProfilingData
+{
+public:
+  cmMakefileProfilingData(const std::string& profileStream);
+  ~cmMakefileProfilingData() noexcept;
+
+  cmMakefileProfilingData(const cmMakefileProfilingData&) = delete;
+  cmMakefileProfilingData& operator=(const cmMakefileProfilingData&) =
+    delete;
+
+  /** Start an entry for the invocation of a listfile command.  */
+  void StartEntry(const cmListFileFunction& lff,
+                  cmListFileBacktrace const& bt);
+
+  /** Start a generic entry of the given category.  */
+  void StartEntry(std::string const& category, std::string const& name,
+                  cmListFileBacktrace const& bt,
+                  Json::Value args = Json::Value(Json::objectValue));
+
+  /** Set the category and expanded arguments of the most recently
+      started entry, if nothing was written since it was started.  */
+  void RefineEntry(std::string const& category,
+                   std::vector<std::string> const& expandedArgs);
+
+  /** Close the most recently started entry.  */
+  void StopEntry();
+
+  /** Record the current values of a named set of counters.  */
+  void WriteCounter(std::string const& name, Json::Value values);
+
+  /** Scoped helper that stops an entry when it goes out of scope.  */
+  class RAII
+  {
+  public:
+    RAII() = default;
+    RAII(cmMakefileProfilingData* data, const cmListFileFunction& lff,
+         cmListFileBacktrace const& bt);
+    RAII(cmMakefileProfilingData* data, std::string const& category,
+         std::string const& name, cmListFileBacktrace const& bt,
+         Json::Value args = Json::Value(Json::objectValue));
+    ~RAII();
+
+    RAII(const RAII&) = delete;
+    RAII& operator=(const RAII&) = delete;
+
+  private:
+    cmMakefileProfilingData* Data = nullptr;
+  };
+
+private:
+  void WriteEvent(Json::Value const& v);
+  void WritePendingEntry();
+  Json::Value::UInt64 GetTimestamp() const;
+
+  std::unique_ptr<Json::StreamWriter> JsonWriter;
+  cmsys::ofstream ProfileStream;
+  Json::Value PendingEntry;
+  int ProcessId = 0;
+  bool First = true;
+  bool HasPendingEntry = false;
+};
+
+#endif
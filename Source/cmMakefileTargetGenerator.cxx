@@ -7,6 +7,8 @@
 #include <sstream>
 #include <utility>
 
+#include "cmsys/FStream.hxx"
+
 #include "cmAlgorithms.h"
 #include "cmComputeLinkInformation.h"
 #include "cmCustomCommand.h"
@@ -85,6 +87,49 @@ cmMakefileTargetGenerator* cmMakefileTargetGenerator::New(
   return result;
 }
 
+void cmMakefileTargetGenerator::WriteRuleFilesIfChanged()
+{
+  std::string const targetDir = this->LocalGenerator->ConvertToFullPath(
+    this->LocalGenerator->GetTargetDirectory(this->GeneratorTarget));
+  std::string const fingerprintFile = cmStrCat(targetDir, "/fingerprint.txt");
+  std::string const fingerprint = this->GlobalGenerator->GetTargetFingerprint(
+    this->GeneratorTarget, this->ConfigName);
+  if (fingerprint.empty()) {
+    // The fingerprint of a previous run no longer describes the rule
+    // files written now.
+    cmSystemTools::RemoveFile(fingerprintFile);
+    this->WriteRuleFiles();
+    return;
+  }
+
+  // Keep the existing rule files if they were written from the same
+  // inputs.  The number of progress actions is recorded along with the
+  // fingerprint because it is only counted while writing them.
+  {
+    cmsys::ifstream fin(fingerprintFile.c_str());
+    std::string line;
+    unsigned long numberOfActions = 0;
+    if (fin && cmSystemTools::GetLineFromStream(fin, line) &&
+        line == fingerprint && (fin >> numberOfActions) &&
+        cmSystemTools::FileExists(cmStrCat(targetDir, "/build.make")) &&
+        cmSystemTools::FileExists(cmStrCat(targetDir, "/DependInfo.cmake"))) {
+      this->ProgressFileNameFull = cmStrCat(targetDir, "/progress.make");
+      this->NumberOfProgressActions = numberOfActions;
+      this->GlobalGenerator->RecordTargetReuse(true);
+      return;
+    }
+  }
+
+  this->WriteRuleFiles();
+  this->GlobalGenerator->RecordTargetReuse(false);
+  if (cmSystemTools::GetErrorOccuredFlag()) {
+    cmSystemTools::RemoveFile(fingerprintFile);
+    return;
+  }
+  cmGeneratedFileStream fout(fingerprintFile);
+  fout << fingerprint << "\n" << this->NumberOfProgressActions << "\n";
+}
+
 void cmMakefileTargetGenerator::GetTargetLinkFlags(
   std::string& flags, const std::string& linkLanguage)
 {
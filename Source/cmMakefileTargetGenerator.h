@@ -43,6 +43,10 @@ public:
      with this target */
   virtual void WriteRuleFiles() = 0;
 
+  /* Write the Makefiles associated with this target unless the ones
+     written by a previous run have the same generator inputs */
+  void WriteRuleFilesIfChanged();
+
   /* return the number of actions that have progress reporting on them */
   virtual unsigned long GetNumberOfProgressActions()
   {
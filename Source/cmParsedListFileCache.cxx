@@ -0,0 +1,182 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmParsedListFileCache.h"
+
+#include <cstdint>
+#include <utility>
+
+#include "cmBinaryCacheFile.h"
+#include "cmListFileCache.h"
+
+namespace {
+
+// Bump the last byte whenever the record layout changes.
+cmBinaryCacheFile::Magic const Magic = { 'C', 'M', 'L', 'F', 'P', 'C',
+                                         '\0', '\1' };
+
+std::string SerializeFunctions(std::vector<cmListFileFunction> const& funcs)
+{
+  std::string data;
+  cmBinaryCacheWriter w(data);
+  w.Put(static_cast<std::uint32_t>(funcs.size()));
+  for (cmListFileFunction const& func : funcs) {
+    w.PutString(func.Name.Original);
+    w.Put(static_cast<std::int64_t>(func.Line));
+    w.Put(static_cast<std::uint32_t>(func.Arguments.size()));
+    for (cmListFileArgument const& arg : func.Arguments) {
+      w.PutString(arg.Value);
+      w.Put(static_cast<std::uint8_t>(arg.Delim));
+      w.Put(static_cast<std::int64_t>(arg.Line));
+    }
+  }
+  return data;
+}
+
+bool DeserializeFunctions(cm::string_view data,
+                          std::vector<cmListFileFunction>& funcs)
+{
+  cmBinaryCacheReader r(data);
+  std::uint32_t numFuncs;
+  if (!r.Get(numFuncs)) {
+    return false;
+  }
+  funcs.reserve(funcs.size() + numFuncs);
+  std::string name;
+  for (std::uint32_t i = 0; i < numFuncs; ++i) {
+    cmListFileFunction func;
+    std::int64_t line;
+    std::uint32_t numArgs;
+    if (!r.GetString(name) || !r.Get(line) || !r.Get(numArgs)) {
+      return false;
+    }
+    func.Name = name;
+    func.Line = static_cast<long>(line);
+    func.Arguments.reserve(numArgs);
+    for (std::uint32_t j = 0; j < numArgs; ++j) {
+      cmListFileArgument arg;
+      std::uint8_t delim;
+      if (!r.GetString(arg.Value) || !r.Get(delim) || !r.Get(line) ||
+          delim > cmListFileArgument::Bracket) {
+        return false;
+      }
+      arg.Delim = static_cast<cmListFileArgument::Delimiter>(delim);
+      arg.Line = static_cast<long>(line);
+      func.Arguments.push_back(std::move(arg));
+    }
+    funcs.push_back(std::move(func));
+  }
+  return r.AtEnd();
+}
+}
+
+cmParsedListFileCache::cmParsedListFileCache(std::string path)
+  : Path(std::move(path))
+{
+}
+
+void cmParsedListFileCache::Load()
+{
+  this->Entries.clear();
+  this->StoredData.clear();
+
+  cm::string_view payload;
+  if (!cmBinaryCacheFile::Read(this->Path, Magic, this->Buffer, payload)) {
+    return;
+  }
+  this->CacheTime = cmBinaryCacheFile::StampPath(this->Path).MTime;
+
+  cmBinaryCacheReader r(payload);
+  std::unordered_map<std::string, Entry> entries;
+  while (!r.AtEnd()) {
+    std::string fileName;
+    Entry entry;
+    std::uint64_t dataSize;
+    if (!r.GetString(fileName) || !r.Get(entry.Stamp.MTime) ||
+        !r.Get(entry.Stamp.Size) || !r.Get(dataSize) ||
+        !r.GetView(entry.Data, dataSize)) {
+      // Truncated or corrupt.  Start over.
+      this->Buffer.clear();
+      return;
+    }
+    entry.Stamp.Exists = true;
+    entries[fileName] = entry;
+  }
+  this->Entries = std::move(entries);
+}
+
+bool cmParsedListFileCache::Save() const
+{
+  if (!this->Modified) {
+    return true;
+  }
+
+  std::string out;
+  cmBinaryCacheWriter w(out);
+  cmBinaryCacheFile::WriteHeader(out, Magic);
+  for (auto const& e : this->Entries) {
+    if (!e.second.Used) {
+      continue;
+    }
+    w.PutString(e.first);
+    w.Put(e.second.Stamp.MTime);
+    w.Put(e.second.Stamp.Size);
+    w.Put(static_cast<std::uint64_t>(e.second.Data.size()));
+    out.append(e.second.Data.data(), e.second.Data.size());
+  }
+
+  return cmBinaryCacheFile::Write(this->Path, out);
+}
+
+bool cmParsedListFileCache::Lookup(std::string const& fileName,
+                                   std::vector<cmListFileFunction>& functions)
+{
+  // Remember the state of the file before it is parsed so that a
+  // modification racing with the parser can never be cached.
+  this->Pending.FileName = fileName;
+  this->Pending.Stamp = cmBinaryCacheFile::StampPath(fileName);
+  if (!this->Pending.Stamp.Exists) {
+    this->Pending.FileName.clear();
+  }
+
+  auto i = this->Entries.find(fileName);
+  if (i == this->Entries.end()) {
+    ++this->Misses;
+    return false;
+  }
+
+  Entry& entry = i->second;
+  std::vector<cmListFileFunction> restored;
+  if (this->Pending.FileName.empty() || this->Pending.Stamp != entry.Stamp ||
+      !cmBinaryCacheFile::IsSettled(entry.Stamp, this->CacheTime) ||
+      !DeserializeFunctions(entry.Data, restored)) {
+    this->Entries.erase(i);
+    this->Modified = true;
+    ++this->Misses;
+    return false;
+  }
+
+  if (!entry.Used) {
+    entry.Used = true;
+    this->Modified = true;
+  }
+  functions = std::move(restored);
+  ++this->Hits;
+  return true;
+}
+
+void cmParsedListFileCache::Store(
+  std::string const& fileName, std::vector<cmListFileFunction> const& functions)
+{
+  if (this->Pending.FileName != fileName) {
+    return;
+  }
+  Entry entry;
+  entry.Stamp = this->Pending.Stamp;
+  this->Pending.FileName.clear();
+
+  this->StoredData.push_back(SerializeFunctions(functions));
+  entry.Data = this->StoredData.back();
+  entry.Used = true;
+  this->Entries[fileName] = entry;
+  this->Modified = true;
+}
@@ -0,0 +1,87 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmParsedListFileCache_h
+#define cmParsedListFileCache_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cm/string_view>
+
+#include "cmBinaryCacheFile.h"
+
+struct cmListFileFunction;
+
+/** \class cmParsedListFileCache
+ * \brief Persist parsed list files across configure runs.
+ *
+ * The parsed form of every list file read during a configure step is
+ * stored in a single binary file in the build tree, keyed by the full
+ * path of the list file together with its modification time and size.
+ * On the next configure step unchanged list files are restored from
+ * that file instead of being lexed and parsed again.
+ *
+ * The on-disk data is a flat sequence of length-prefixed records that is
+ * read into memory in one piece.  Entries are only decoded when they are
+ * looked up, and entries that were not looked up by the last configure
+ * step are dropped when the cache is saved.
+ */
+class cmParsedListFileCache
+{
+public:
+  cmParsedListFileCache(std::string path);
+
+  cmParsedListFileCache(cmParsedListFileCache const&) = delete;
+  cmParsedListFileCache& operator=(cmParsedListFileCache const&) = delete;
+
+  /** Read the cache file.  Missing, corrupt, or foreign cache files
+      are silently ignored.  */
+  void Load();
+
+  /** Write the entries used since Load back to the cache file.  */
+  bool Save() const;
+
+  /** Restore the functions of the given list file if it is unchanged
+      since it was stored.  */
+  bool Lookup(std::string const& fileName,
+              std::vector<cmListFileFunction>& functions);
+
+  /** Record the functions parsed from the given list file.  Must follow
+      a failed Lookup of the same file.  */
+  void Store(std::string const& fileName,
+             std::vector<cmListFileFunction> const& functions);
+
+  unsigned long GetHits() const { return this->Hits; }
+  unsigned long GetMisses() const { return this->Misses; }
+
+private:
+  struct Entry
+  {
+    cmBinaryCacheFile::Stamp Stamp;
+    cm::string_view Data;
+    bool Used = false;
+  };
+
+  struct PendingEntry
+  {
+    std::string FileName;
+    cmBinaryCacheFile::Stamp Stamp;
+  };
+
+  std::string Path;
+  std::string Buffer;
+  std::deque<std::string> StoredData;
+  std::unordered_map<std::string, Entry> Entries;
+  PendingEntry Pending;
+  std::int64_t CacheTime = 0;
+  unsigned long Hits = 0;
+  unsigned long Misses = 0;
+  bool Modified = false;
+};
+
+#endif
@@ -221,6 +221,11 @@ std::string const& cmState::GetGlobVerifyScript() const
   return this->GlobVerificationManager->GetVerifyScript();
 }
 
+std::string const& cmState::GetGlobVerifySnapshot() const
+{
+  return this->GlobVerificationManager->GetVerifySnapshot();
+}
+
 std::string const& cmState::GetGlobVerifyStamp() const
 {
   return this->GlobVerificationManager->GetVerifyStamp();
@@ -305,7 +310,8 @@ cmStateSnapshot cmState::Reset()
     std::string binDir =
       *cmDefinitions::Get("CMAKE_BINARY_DIR", pos->Vars, pos->Root);
     this->VarTree.Clear();
-    pos->Vars = this->VarTree.Push(this->VarTree.Root());
+    pos->Vars = this->VarTree.Push(this->VarTree.Root(),
+                                   cmDefinitions(this->VarNames));
     pos->Parent = this->VarTree.Root();
     pos->Root = this->VarTree.Root();
 
@@ -625,6 +631,11 @@ bool cmState::GetGlobalPropertyAsBool(const std::string& prop)
   return cmIsOn(this->GetGlobalProperty(prop));
 }
 
+std::vector<std::string> cmState::GetGlobalPropertyKeys() const
+{
+  return this->GlobalProperties.GetKeys();
+}
+
 void cmState::SetSourceDirectory(std::string const& sourceDirectory)
 {
   this->SourceDirectory = sourceDirectory;
@@ -784,7 +795,8 @@ cmStateSnapshot cmState::CreateBaseSnapshot()
   pos->PolicyScope = this->PolicyStack.Root();
   assert(pos->Policies.IsValid());
   assert(pos->PolicyRoot.IsValid());
-  pos->Vars = this->VarTree.Push(this->VarTree.Root());
+  pos->Vars = this->VarTree.Push(this->VarTree.Root(),
+                                 cmDefinitions(this->VarNames));
   assert(pos->Vars.IsValid());
   pos->Parent = this->VarTree.Root();
   pos->Root = this->VarTree.Root();
@@ -815,7 +827,7 @@ cmStateSnapshot cmState::CreateBuildsystemDirectorySnapshot(
   cmLinkedTree<cmDefinitions>::iterator origin = originSnapshot.Position->Vars;
   pos->Parent = origin;
   pos->Root = origin;
-  pos->Vars = this->VarTree.Push(origin);
+  pos->Vars = this->VarTree.Push(origin, cmDefinitions(this->VarNames));
 
   cmStateSnapshot snapshot = cmStateSnapshot(this, pos);
   originSnapshot.Position->BuildSystemDirectory->Children.push_back(snapshot);
@@ -840,7 +852,7 @@ cmStateSnapshot cmState::CreateFunctionCallSnapshot(
   assert(originSnapshot.Position->Vars.IsValid());
   cmLinkedTree<cmDefinitions>::iterator origin = originSnapshot.Position->Vars;
   pos->Parent = origin;
-  pos->Vars = this->VarTree.Push(origin);
+  pos->Vars = this->VarTree.Push(origin, cmDefinitions(this->VarNames));
   return { this, pos };
 }
 
@@ -887,7 +899,7 @@ cmStateSnapshot cmState::CreateVariableScopeSnapshot(
 
   cmLinkedTree<cmDefinitions>::iterator origin = originSnapshot.Position->Vars;
   pos->Parent = origin;
-  pos->Vars = this->VarTree.Push(origin);
+  pos->Vars = this->VarTree.Push(origin, cmDefinitions(this->VarNames));
   assert(pos->Vars.IsValid());
   return { this, pos };
 }
@@ -170,6 +170,7 @@ public:
                             bool asString = false);
   const char* GetGlobalProperty(const std::string& prop);
   bool GetGlobalPropertyAsBool(const std::string& prop);
+  std::vector<std::string> GetGlobalPropertyKeys() const;
 
   std::string const& GetSourceDirectory() const;
   void SetSourceDirectory(std::string const& sourceDirectory);
@@ -208,6 +209,7 @@ private:
 
   bool DoWriteGlobVerifyTarget() const;
   std::string const& GetGlobVerifyScript() const;
+  std::string const& GetGlobVerifySnapshot() const;
   std::string const& GetGlobVerifyStamp() const;
   bool SaveVerificationScript(const std::string& path);
   void AddGlobCacheEntry(bool recurse, bool listDirectories,
@@ -232,6 +234,8 @@ private:
 
   cmLinkedTree<cmStateDetail::PolicyStackEntry> PolicyStack;
   cmLinkedTree<cmStateDetail::SnapshotDataType> SnapshotData;
+  // Declared before the variable scopes using it.
+  cmDefinitions::NameTable VarNames;
   cmLinkedTree<cmDefinitions> VarTree;
 
   std::string SourceDirectory;
@@ -25,6 +25,7 @@
 
 #if !defined(CMAKE_BOOTSTRAP)
 #  include "cmCryptoHash.h"
+#  include "cmFileFingerprintCache.h"
 #endif
 
 #if defined(CMAKE_USE_ELF_PARSER)
@@ -80,6 +81,13 @@
 #  include <malloc.h> /* for malloc/free on QNX */
 #endif
 
+#if defined(__linux__)
+#  include <memory>
+
+#  include <sys/sendfile.h>
+#  include <sys/syscall.h>
+#endif
+
 namespace {
 
 cmSystemTools::InterruptCallback s_InterruptCallback;
@@ -130,6 +138,7 @@ static int cm_archive_read_open_file(struct archive* a, const char* file,
 bool cmSystemTools::s_RunCommandHideConsole = false;
 bool cmSystemTools::s_DisableRunCommandOutput = false;
 bool cmSystemTools::s_ErrorOccured = false;
+cmFileFingerprintCache* cmSystemTools::s_FileFingerprintCache = nullptr;
 bool cmSystemTools::s_FatalErrorOccured = false;
 bool cmSystemTools::s_ForceUnixPaths = false;
 
@@ -872,6 +881,175 @@ void cmSystemTools::MoveFileIfDifferent(const std::string& source,
   RemoveFile(source);
 }
 
+bool cmSystemTools::FilesDiffer(const std::string& source,
+                                const std::string& destination)
+{
+#if !defined(CMAKE_BOOTSTRAP)
+  if (cmSystemTools::s_FileFingerprintCache) {
+    return cmSystemTools::s_FileFingerprintCache->FilesDiffer(source,
+                                                              destination);
+  }
+#endif
+  return Superclass::FilesDiffer(source, destination);
+}
+
+bool cmSystemTools::CopyFileIfDifferent(const std::string& source,
+                                        const std::string& destination)
+{
+  // FilesDiffer does not handle file to directory compare.
+  if (cmSystemTools::FileIsDirectory(destination)) {
+    std::string fileInDir = destination;
+    cmSystemTools::ConvertToUnixSlashes(fileInDir);
+    fileInDir += '/';
+    fileInDir += cmSystemTools::GetFilenameName(source);
+    return cmSystemTools::CopyFileIfDifferent(source, fileInDir);
+  }
+  return !cmSystemTools::FilesDiffer(source, destination) ||
+    cmSystemTools::CopyFileAlways(source, destination);
+}
+
+#if defined(__linux__)
+namespace {
+bool WriteAll(int out, const char* buffer, size_t size)
+{
+  while (size > 0) {
+    ssize_t n = write(out, buffer, size);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    buffer += n;
+    size -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+// Copy the rest of an open file to another one in the kernel.  Try
+// copy_file_range first, which may share extents or copy on the server
+// side of network file systems, then sendfile, e.g. across file systems
+// on older kernels.  The file offsets are advanced past the copied data.
+void CopyFileContentKernel(int in, int out)
+{
+  // Copy at most 1 GiB per call to keep each call interruptible.
+  size_t const chunk = static_cast<size_t>(1) << 30;
+#  if defined(__NR_copy_file_range)
+  for (;;) {
+    long n = syscall(__NR_copy_file_range, in, static_cast<void*>(nullptr),
+                     out, static_cast<void*>(nullptr), chunk, 0u);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    // Stop at the end of the file, or if the files are not supported
+    // (ENOSYS, EXDEV, EINVAL...).
+    if (n <= 0) {
+      break;
+    }
+  }
+#  endif
+  for (;;) {
+    ssize_t n = sendfile(out, in, nullptr, chunk);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      break;
+    }
+  }
+}
+
+// Copy a file with file descriptors.  Whatever the kernel did not copy,
+// e.g. the content of files in /proc that report a size of zero, is
+// copied through a buffer.  Returns -1 if the files could not be
+// opened, so the caller can fall back to the portable copy.
+int CopyFileContentFast(std::string const& source,
+                        std::string const& destination)
+{
+  int in = open(source.c_str(), O_RDONLY | O_CLOEXEC);
+  if (in < 0) {
+    return -1;
+  }
+
+  // Remove the destination first so that a read-only destination can be
+  // replaced.  Continue on failure in case only the directory is
+  // read-only.
+  cmSystemTools::RemoveFile(destination);
+
+  int out = open(destination.c_str(),
+                 O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+  if (out < 0) {
+    close(in);
+    return -1;
+  }
+
+  CopyFileContentKernel(in, out);
+
+  bool success = true;
+  size_t const bufferSize = 1024 * 1024;
+  std::unique_ptr<char[]> buffer(new char[bufferSize]);
+  for (;;) {
+    ssize_t n = read(in, buffer.get(), bufferSize);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      success = n == 0;
+      break;
+    }
+    if (!WriteAll(out, buffer.get(), static_cast<size_t>(n))) {
+      success = false;
+      break;
+    }
+  }
+
+  close(in);
+  if (close(out) < 0) {
+    success = false;
+  }
+  return success ? 1 : 0;
+}
+} // namespace
+#endif
+
+bool cmSystemTools::CopyFileAlways(const std::string& source,
+                                   const std::string& destination)
+{
+#if defined(__linux__)
+  if (!cmSystemTools::FileIsDirectory(source)) {
+    std::string realDestination = destination;
+    if (cmSystemTools::FileIsDirectory(destination)) {
+      cmSystemTools::ConvertToUnixSlashes(realDestination);
+      realDestination += '/';
+      realDestination += cmSystemTools::GetFilenameName(source);
+    }
+    if (cmSystemTools::SameFile(source, realDestination)) {
+      return true;
+    }
+    cmSystemTools::MakeDirectory(
+      cmSystemTools::GetFilenamePath(realDestination));
+
+    int const copied = CopyFileContentFast(source, realDestination);
+    if (copied >= 0) {
+      mode_t perm = 0;
+      return copied > 0 &&
+        (!cmSystemTools::GetPermissions(source, perm) ||
+         cmSystemTools::SetPermissions(realDestination, perm));
+    }
+  }
+#endif
+  return Superclass::CopyFileAlways(source, destination);
+}
+
+bool cmSystemTools::CopyAFile(const std::string& source,
+                              const std::string& destination, bool always)
+{
+  if (always) {
+    return cmSystemTools::CopyFileAlways(source, destination);
+  }
+  return cmSystemTools::CopyFileIfDifferent(source, destination);
+}
+
 std::string cmSystemTools::ComputeFileHash(const std::string& source,
                                            cmCryptoHash::Algo algo)
 {
@@ -1271,7 +1449,8 @@ bool cmSystemTools::CreateTar(const std::string& outFileName,
                               const std::vector<std::string>& files,
                               cmTarCompression compressType, bool verbose,
                               std::string const& mtime,
-                              std::string const& format)
+                              std::string const& format, int compressionLevel,
+                              int numThreads)
 {
 #if !defined(CMAKE_BOOTSTRAP)
   std::string cwd = cmSystemTools::GetCurrentWorkingDirectory();
@@ -1301,7 +1480,8 @@ bool cmSystemTools::CreateTar(const std::string& outFileName,
       break;
   }
 
-  cmArchiveWrite a(fout, compress, format.empty() ? "paxr" : format);
+  cmArchiveWrite a(fout, compress, format.empty() ? "paxr" : format,
+                   compressionLevel, numThreads);
 
   a.SetMTime(mtime);
   a.SetVerbose(verbose);
@@ -19,6 +19,8 @@
 #include "cmDuration.h"
 #include "cmProcessOutput.h"
 
+class cmFileFingerprintCache;
+
 /** \class cmSystemTools
  * \brief A collection of useful functions for CMake.
  *
@@ -138,6 +140,36 @@ public:
   static void MoveFileIfDifferent(const std::string& source,
                                   const std::string& destination);
 
+  /** Return true if the content of the two files differs.  Consults
+      the file fingerprint cache, if set, to avoid reading files whose
+      content is already known.  */
+  static bool FilesDiffer(const std::string& source,
+                          const std::string& destination);
+
+  //! Copy a file if its content differs from the destination
+  static bool CopyFileIfDifferent(const std::string& source,
+                                  const std::string& destination);
+
+  /** Copy a file.  On Linux the content is copied by the kernel with
+      copy_file_range or sendfile when possible.  */
+  static bool CopyFileAlways(const std::string& source,
+                             const std::string& destination);
+
+  /** Copy a file, or only if its content differs from the destination
+      if "always" is false.  */
+  static bool CopyAFile(const std::string& source,
+                        const std::string& destination, bool always = true);
+
+  /** Set the fingerprint cache consulted by FilesDiffer.  */
+  static void SetFileFingerprintCache(cmFileFingerprintCache* cache)
+  {
+    cmSystemTools::s_FileFingerprintCache = cache;
+  }
+  static cmFileFingerprintCache* GetFileFingerprintCache()
+  {
+    return cmSystemTools::s_FileFingerprintCache;
+  }
+
   //! Compute the hash of a file
   static std::string ComputeFileHash(const std::string& source,
                                      cmCryptoHash::Algo algo);
@@ -363,7 +395,8 @@ public:
                         const std::vector<std::string>& files,
                         cmTarCompression compressType, bool verbose,
                         std::string const& mtime = std::string(),
-                        std::string const& format = std::string());
+                        std::string const& format = std::string(),
+                        int compressionLevel = 0, int numThreads = 1);
   static bool ExtractTar(const std::string& inFileName,
                          const std::vector<std::string>& files, bool verbose);
   // This should be called first thing in main
@@ -458,6 +491,7 @@ private:
   static bool s_ForceUnixPaths;
   static bool s_RunCommandHideConsole;
   static bool s_ErrorOccured;
+  static cmFileFingerprintCache* s_FileFingerprintCache;
   static bool s_FatalErrorOccured;
   static bool s_DisableRunCommandOutput;
 };
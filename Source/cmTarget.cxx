@@ -1100,6 +1100,19 @@ cmBacktraceRange cmTarget::GetLinkImplementationBacktraces() const
   return cmMakeRange(impl->LinkImplementationPropertyBacktraces);
 }
 
+namespace {
+// Generator targets cache the include directories and compile definitions
+// computed from these properties of themselves and the targets they use,
+// including the COMPILE_DEFINITIONS_<CONFIG> variants.
+void ClearCompileInfoCaches(cmTarget const* tgt, std::string const& prop)
+{
+  if (cmHasLiteralSuffix(prop, "INCLUDE_DIRECTORIES") ||
+      prop.find("COMPILE_DEFINITIONS") != std::string::npos) {
+    tgt->GetGlobalGenerator()->ClearCompileInfoCaches();
+  }
+}
+}
+
 void cmTarget::SetProperty(const std::string& prop, const char* value)
 {
   if (!cmTargetPropertyComputer::PassesWhitelist(
@@ -1107,6 +1120,7 @@ void cmTarget::SetProperty(const std::string& prop, const char* value)
         impl->Makefile->GetBacktrace())) {
     return;
   }
+  ClearCompileInfoCaches(this, prop);
 #define MAKE_STATIC_PROP(PROP) static const std::string prop##PROP = #PROP
   MAKE_STATIC_PROP(COMPILE_DEFINITIONS);
   MAKE_STATIC_PROP(COMPILE_FEATURES);
@@ -1307,6 +1321,7 @@ void cmTarget::AppendProperty(const std::string& prop, const char* value,
         impl->Makefile->GetBacktrace())) {
     return;
   }
+  ClearCompileInfoCaches(this, prop);
   if (prop == "NAME") {
     impl->Makefile->IssueMessage(MessageType::FATAL_ERROR,
                                  "NAME property is read-only\n");
@@ -1440,6 +1455,7 @@ void cmTarget::InsertInclude(std::string const& entry,
 
   impl->IncludeDirectoriesEntries.insert(position, entry);
   impl->IncludeDirectoriesBacktraces.insert(btPosition, bt);
+  ClearCompileInfoCaches(this, "INCLUDE_DIRECTORIES");
 }
 
 void cmTarget::InsertCompileOption(std::string const& entry,
@@ -1460,6 +1476,7 @@ void cmTarget::InsertCompileDefinition(std::string const& entry,
 {
   impl->CompileDefinitionsEntries.push_back(entry);
   impl->CompileDefinitionsBacktraces.push_back(bt);
+  ClearCompileInfoCaches(this, "COMPILE_DEFINITIONS");
 }
 
 void cmTarget::InsertLinkOption(std::string const& entry,
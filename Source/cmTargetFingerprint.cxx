@@ -0,0 +1,366 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmTargetFingerprint.h"
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+#include <cm/string_view>
+
+#include "cmCryptoHash.h"
+#include "cmCustomCommand.h"
+#include "cmCustomCommandLines.h"
+#include "cmGeneratorTarget.h"
+#include "cmGlobalGenerator.h"
+#include "cmListFileCache.h"
+#include "cmLocalGenerator.h"
+#include "cmMakefile.h"
+#include "cmPolicies.h"
+#include "cmPropertyMap.h"
+#include "cmSourceFile.h"
+#include "cmState.h"
+#include "cmStateTypes.h"
+#include "cmTarget.h"
+#include "cmVersion.h"
+#include "cmake.h"
+
+class cmTargetFingerprint::Hasher
+{
+public:
+  Hasher(cmLocalGenerator* lg = nullptr,
+         std::vector<cmGeneratorTarget const*>* uses = nullptr)
+    : Hash(cmCryptoHash::AlgoSHA256)
+    , LocalGenerator(lg)
+    , Uses(uses)
+  {
+    this->Hash.Initialize();
+  }
+
+  void Add(cm::string_view value)
+  {
+    this->Hash.Append(value);
+    // Terminate every value so that adjacent values cannot alias.
+    this->Hash.Append("", 1);
+    if (this->Uses) {
+      this->ScanForTargets(value);
+    }
+  }
+
+  void Add(const char* value)
+  {
+    if (value) {
+      this->Add(cm::string_view(value));
+    } else {
+      // Distinguish unset values from empty ones.
+      this->Hash.Append("\1", 1);
+    }
+  }
+
+  void Add(std::string const& value) { this->Add(cm::string_view(value)); }
+
+  void Add(unsigned long value) { this->Add(std::to_string(value)); }
+
+  void AddProperties(cmPropertyMap const& properties)
+  {
+    for (auto const& prop : properties.GetList()) {
+      this->Add(prop.first);
+      this->Add(prop.second);
+    }
+  }
+
+  void AddCustomCommand(cmCustomCommand const& cc)
+  {
+    this->AddList(cc.GetOutputs());
+    this->AddList(cc.GetByproducts());
+    this->AddList(cc.GetDepends());
+    for (std::string const& dep : cc.GetDepends()) {
+      this->AddTarget(dep);
+    }
+    this->Add(static_cast<unsigned long>(cc.GetCommandLines().size()));
+    for (cmCustomCommandLine const& line : cc.GetCommandLines()) {
+      this->AddList(line);
+      if (!line.empty()) {
+        this->AddTarget(line.front());
+      }
+    }
+    this->Add(cc.GetComment());
+    this->Add(cc.GetWorkingDirectory());
+    this->Add(cc.GetDepfile());
+    this->Add(cc.GetJobPool());
+    for (auto const& dep : cc.GetImplicitDepends()) {
+      this->Add(dep.first);
+      this->Add(dep.second);
+    }
+    unsigned long const flags = (cc.GetEscapeOldStyle() ? 1 : 0) |
+      (cc.GetEscapeAllowMakeVars() ? 2 : 0) | (cc.GetUsesTerminal() ? 4 : 0) |
+      (cc.GetCommandExpandLists() ? 8 : 0);
+    this->Add(flags);
+  }
+
+  bool IsReliable() const { return this->Reliable; }
+
+  std::string Finalize() { return this->Hash.FinalizeHex(); }
+
+private:
+  void AddList(std::vector<std::string> const& values)
+  {
+    this->Add(static_cast<unsigned long>(values.size()));
+    for (std::string const& value : values) {
+      this->Add(value);
+    }
+  }
+
+  void AddTarget(std::string const& name)
+  {
+    if (!this->Uses || name.empty()) {
+      return;
+    }
+    if (cmGeneratorTarget* gt =
+          this->LocalGenerator->FindGeneratorTargetToUse(name)) {
+      this->Uses->push_back(gt);
+    }
+  }
+
+  // Record the targets named by generator expressions in the value.
+  void ScanForTargets(cm::string_view value)
+  {
+    if (value.find("$<") == cm::string_view::npos) {
+      return;
+    }
+    // The content of $<GENEX_EVAL> and $<TARGET_GENEX_EVAL> may be
+    // computed at generate time and name arbitrary targets.
+    if (value.find("GENEX_EVAL:") != cm::string_view::npos) {
+      this->Reliable = false;
+      return;
+    }
+    static cm::string_view const prefix = "$<TARGET_";
+    for (auto pos = value.find(prefix); pos != cm::string_view::npos;
+         pos = value.find(prefix, pos + prefix.size())) {
+      auto const colon = value.find(':', pos);
+      if (colon == cm::string_view::npos) {
+        break;
+      }
+      auto const end = value.find_first_of(",>", colon + 1);
+      cm::string_view const name =
+        value.substr(colon + 1,
+                     end == cm::string_view::npos ? end : end - colon - 1);
+      if (name.find("$<") != cm::string_view::npos) {
+        this->Reliable = false;
+        return;
+      }
+      this->AddTarget(std::string(name));
+    }
+  }
+
+  cmCryptoHash Hash;
+  cmLocalGenerator* LocalGenerator;
+  std::vector<cmGeneratorTarget const*>* Uses;
+  bool Reliable = true;
+};
+
+cmTargetFingerprint::cmTargetFingerprint(cmGlobalGenerator* gg)
+  : GlobalGenerator(gg)
+{
+}
+
+std::string cmTargetFingerprint::Compute(cmGeneratorTarget const* gt,
+                                         std::string const& config)
+{
+  Hasher h;
+  h.Add(this->GetGlobalDigest());
+  h.Add(config);
+  h.Add(gt->GetName());
+
+  // Collect the digests of every target the generated build files of
+  // this target may depend on.
+  std::vector<std::string> digests;
+  std::vector<cmGeneratorTarget const*> queue(1, gt);
+  std::unordered_set<cmGeneratorTarget const*> seen(queue.begin(),
+                                                    queue.end());
+  auto enqueue = [&queue, &seen](cmGeneratorTarget const* t) {
+    if (seen.insert(t).second) {
+      queue.push_back(t);
+    }
+  };
+  while (!queue.empty()) {
+    cmGeneratorTarget const* t = queue.back();
+    queue.pop_back();
+
+    TargetDigest const& td = this->GetTargetDigest(t);
+    if (!td.Reliable) {
+      return std::string();
+    }
+    digests.push_back(td.Digest);
+    for (cmGeneratorTarget const* use : td.Uses) {
+      enqueue(use);
+    }
+    if (!t->IsImported() && t->GetType() <= cmStateEnums::OBJECT_LIBRARY) {
+      for (cmGeneratorTarget const* dep :
+           t->GetLinkImplementationClosure(config)) {
+        enqueue(dep);
+      }
+    }
+
+    // The object files of object libraries depend on their sources.
+    if (t == gt || t->GetType() == cmStateEnums::OBJECT_LIBRARY) {
+      std::string sourcesDigest;
+      std::vector<cmGeneratorTarget const*> uses;
+      if (!this->ComputeSourcesDigest(t, config, sourcesDigest, uses)) {
+        return std::string();
+      }
+      digests.push_back(std::move(sourcesDigest));
+      for (cmGeneratorTarget const* use : uses) {
+        enqueue(use);
+      }
+    }
+  }
+
+  std::sort(digests.begin(), digests.end());
+  for (std::string const& digest : digests) {
+    h.Add(digest);
+  }
+  return h.Finalize();
+}
+
+cmTargetFingerprint::TargetDigest const& cmTargetFingerprint::GetTargetDigest(
+  cmGeneratorTarget const* gt)
+{
+  auto i = this->TargetDigests.find(gt);
+  if (i != this->TargetDigests.end()) {
+    return i->second;
+  }
+
+  TargetDigest td;
+  cmLocalGenerator* lg = gt->GetLocalGenerator();
+  Hasher h(lg, &td.Uses);
+  h.Add(this->GetDirectoryDigest(lg));
+  h.Add(gt->GetName());
+  h.Add(cmState::GetTargetTypeName(gt->GetType()));
+  h.Add(static_cast<unsigned long>(gt->IsImported()));
+  h.AddProperties(gt->Target->GetProperties());
+
+  // These properties are not stored in the property map.
+  static const char* const specialProperties[] = {
+    "COMPILE_DEFINITIONS", "COMPILE_FEATURES", "COMPILE_OPTIONS",
+    "INCLUDE_DIRECTORIES", "LINK_DIRECTORIES", "LINK_LIBRARIES",
+    "LINK_OPTIONS",        "PRECOMPILE_HEADERS", "SOURCES"
+  };
+  for (const char* prop : specialProperties) {
+    h.Add(prop);
+    h.Add(gt->Target->GetProperty(prop));
+  }
+
+#define HASH_TARGET_POLICY(POLICY)                                            \
+  h.Add(static_cast<unsigned long>(gt->GetPolicyStatus##POLICY()));
+  CM_FOR_EACH_TARGET_POLICY(HASH_TARGET_POLICY)
+#undef HASH_TARGET_POLICY
+
+  for (BT<std::string> const& util : gt->GetUtilities()) {
+    h.Add(util.Value);
+  }
+  for (auto const* commands :
+       { &gt->GetPreBuildCommands(), &gt->GetPreLinkCommands(),
+         &gt->GetPostBuildCommands() }) {
+    h.Add(static_cast<unsigned long>(commands->size()));
+    for (cmCustomCommand const& cc : *commands) {
+      h.AddCustomCommand(cc);
+    }
+  }
+
+  td.Reliable = h.IsReliable();
+  td.Digest = h.Finalize();
+  return this->TargetDigests.emplace(gt, std::move(td)).first->second;
+}
+
+std::string const& cmTargetFingerprint::GetDirectoryDigest(
+  cmLocalGenerator* lg)
+{
+  auto i = this->DirectoryDigests.find(lg);
+  if (i != this->DirectoryDigests.end()) {
+    return i->second;
+  }
+
+  cmMakefile* mf = lg->GetMakefile();
+  Hasher h;
+  h.Add(mf->GetCurrentSourceDirectory());
+  h.Add(mf->GetCurrentBinaryDirectory());
+  for (std::string const& def : mf->GetDefinitions()) {
+    h.Add(def);
+    h.Add(mf->GetDefinition(def));
+  }
+  for (std::string const& prop : mf->GetPropertyKeys()) {
+    h.Add(prop);
+    h.Add(mf->GetProperty(prop));
+  }
+  for (int id = 0; id < cmPolicies::CMPCOUNT; ++id) {
+    h.Add(static_cast<unsigned long>(
+      mf->GetPolicyStatus(static_cast<cmPolicies::PolicyID>(id))));
+  }
+  return this->DirectoryDigests.emplace(lg, h.Finalize()).first->second;
+}
+
+std::string const& cmTargetFingerprint::GetGlobalDigest()
+{
+  if (!this->GlobalDigest.empty()) {
+    return this->GlobalDigest;
+  }
+
+  Hasher h;
+  h.Add(cmVersion::GetCMakeVersion());
+  h.Add(this->GlobalGenerator->GetName());
+
+  cmState* state = this->GlobalGenerator->GetCMakeInstance()->GetState();
+  for (std::string const& prop : state->GetGlobalPropertyKeys()) {
+    h.Add(prop);
+    h.Add(state->GetGlobalProperty(prop));
+  }
+
+  // Any target name may be referenced by the link libraries of a target,
+  // so adding or removing a target changes the digest of all targets.
+  std::vector<std::string> names;
+  std::vector<cmLocalGenerator*> const& lgs =
+    this->GlobalGenerator->GetLocalGenerators();
+  for (cmLocalGenerator* lg : lgs) {
+    for (cmGeneratorTarget const* gt : lg->GetGeneratorTargets()) {
+      names.push_back(gt->GetName());
+    }
+    cmMakefile* mf = lg->GetMakefile();
+    for (cmTarget const* t : mf->GetImportedTargets()) {
+      names.push_back(t->GetName());
+    }
+    for (auto const& alias : mf->GetAliasTargets()) {
+      names.push_back(alias.first);
+    }
+  }
+  std::sort(names.begin(), names.end());
+  for (std::string const& name : names) {
+    h.Add(name);
+  }
+
+  // The generator consults the top-level directory for some settings.
+  if (!lgs.empty()) {
+    h.Add(this->GetDirectoryDigest(lgs[0]));
+  }
+
+  this->GlobalDigest = h.Finalize();
+  return this->GlobalDigest;
+}
+
+bool cmTargetFingerprint::ComputeSourcesDigest(
+  cmGeneratorTarget const* gt, std::string const& config, std::string& digest,
+  std::vector<cmGeneratorTarget const*>& uses)
+{
+  Hasher h(gt->GetLocalGenerator(), &uses);
+  std::vector<cmSourceFile*> sources;
+  gt->GetSourceFiles(sources, config);
+  for (cmSourceFile* sf : sources) {
+    h.Add(sf->GetFullPath());
+    h.AddProperties(sf->GetProperties());
+    if (cmCustomCommand const* cc = sf->GetCustomCommand()) {
+      h.AddCustomCommand(*cc);
+    }
+  }
+  digest = h.Finalize();
+  return h.IsReliable();
+}
@@ -0,0 +1,66 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmTargetFingerprint_h
+#define cmTargetFingerprint_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class cmGeneratorTarget;
+class cmGlobalGenerator;
+class cmLocalGenerator;
+
+/** \class cmTargetFingerprint
+ * \brief Summarize the generator inputs of a target in a single digest.
+ *
+ * The digest of a target covers its own properties, sources and custom
+ * commands, the properties of every target it may refer to through its
+ * link closure, custom commands or generator expressions, the variables,
+ * properties and policy settings of the directories defining those
+ * targets, and the global properties and set of target names of the
+ * project.  A generator may keep the build files written for a target
+ * by an earlier run as long as its digest does not change.
+ *
+ * Targets whose inputs cannot be captured reliably, such as those using
+ * generator expressions that evaluate generator expressions computed at
+ * generate time, get an empty digest.
+ */
+class cmTargetFingerprint
+{
+public:
+  cmTargetFingerprint(cmGlobalGenerator* gg);
+
+  cmTargetFingerprint(cmTargetFingerprint const&) = delete;
+  cmTargetFingerprint& operator=(cmTargetFingerprint const&) = delete;
+
+  /** Compute the digest of the given target for the given configuration.
+      Returns an empty string if the target cannot be fingerprinted.  */
+  std::string Compute(cmGeneratorTarget const* gt, std::string const& config);
+
+private:
+  struct TargetDigest
+  {
+    std::string Digest;
+    std::vector<cmGeneratorTarget const*> Uses;
+    bool Reliable = true;
+  };
+
+  class Hasher;
+
+  TargetDigest const& GetTargetDigest(cmGeneratorTarget const* gt);
+  std::string const& GetDirectoryDigest(cmLocalGenerator* lg);
+  std::string const& GetGlobalDigest();
+  bool ComputeSourcesDigest(cmGeneratorTarget const* gt,
+                            std::string const& config, std::string& digest,
+                            std::vector<cmGeneratorTarget const*>& uses);
+
+  cmGlobalGenerator* GlobalGenerator;
+  std::string GlobalDigest;
+  std::unordered_map<cmLocalGenerator const*, std::string> DirectoryDigests;
+  std::unordered_map<cmGeneratorTarget const*, TargetDigest> TargetDigests;
+};
+
+#endif
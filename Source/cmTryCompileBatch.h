@@ -0,0 +1,64 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmTryCompileBatch_h
+#define cmTryCompileBatch_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "cmStateTypes.h"
+
+/** \class cmTryCompileBatch
+ * \brief The checks declared between cmake_check_batch(BEGIN) and
+ *        cmake_check_batch(END).
+ *
+ * A try_compile call given a command to finish its check is deferred
+ * while a batch is open.  Its test project is written to a directory of
+ * its own, and checks sharing the same project settings are added to
+ * one test project as subdirectories.  When the batch ends, each test
+ * project is configured once and all of its targets are built together
+ * with the native build tool running jobs in parallel.
+ */
+struct cmTryCompileBatch
+{
+  struct Check
+  {
+    std::string ResultVariable;
+    std::string OutputVariable;
+    // The directory holding the check's sources and outputs.
+    std::string Directory;
+    std::string TargetName;
+    cmStateEnums::TargetType TargetType = cmStateEnums::EXECUTABLE;
+    // The command and arguments to call when the result is known.
+    std::vector<std::string> Finish;
+    // The key and stamped paths of the check in the result cache.
+    std::string CacheKey;
+    std::vector<std::string> CachePaths;
+  };
+
+  struct Project
+  {
+    std::string BinaryDirectory;
+    // The code to write before the project() command.
+    std::string Header;
+    std::set<std::string> Languages;
+    std::vector<std::string> CMakeFlags;
+    std::vector<Check> Checks;
+  };
+
+  // Whether try_compile calls are deferred.  This is false if the
+  // generator cannot build the checks of a batch together.
+  bool Enabled = false;
+  int Jobs = 1;
+  std::vector<std::string> NativeOptions;
+  std::vector<Project> Projects;
+  // Index of the projects by their settings.
+  std::map<std::string, size_t> ProjectIndex;
+  std::set<std::string> TargetNames;
+};
+
+#endif
@@ -0,0 +1,145 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmTryCompileResultCache.h"
+
+#include <cstdint>
+#include <utility>
+
+#include <cm/string_view>
+
+#include "cmCryptoHash.h"
+
+namespace {
+
+// Bump the last byte whenever the record layout changes.
+cmBinaryCacheFile::Magic const Magic = { 'C', 'M', 'T', 'C', 'R', 'C',
+                                         '\0', '\1' };
+}
+
+cmTryCompileResultCache::cmTryCompileResultCache(std::string path)
+  : Path(std::move(path))
+{
+}
+
+void cmTryCompileResultCache::Load()
+{
+  this->Entries.clear();
+  this->Modified = false;
+
+  std::string buffer;
+  cm::string_view payload;
+  if (!cmBinaryCacheFile::Read(this->Path, Magic, buffer, payload)) {
+    return;
+  }
+
+  cmBinaryCacheReader r(payload);
+  std::unordered_map<std::string, Entry> entries;
+  while (!r.AtEnd()) {
+    std::string key;
+    Entry entry;
+    Result& outcome = entry.Outcome;
+    std::uint8_t compiled;
+    std::uint8_t ran;
+    if (!r.GetString(key) || !r.Get(compiled) ||
+        !r.GetString(outcome.Output) || !r.Get(ran) ||
+        !r.GetString(outcome.RunResult) || !r.GetString(outcome.RunOutput)) {
+      // Truncated or corrupt.  Start over.
+      return;
+    }
+    outcome.Compiled = compiled != 0;
+    outcome.Ran = ran != 0;
+    std::uint32_t numStamps;
+    if (!r.Get(numStamps)) {
+      return;
+    }
+    for (std::uint32_t i = 0; i < numStamps; ++i) {
+      PathStamp stamp;
+      std::uint8_t exists;
+      if (!r.GetString(stamp.Path) || !r.Get(exists) ||
+          !r.Get(stamp.Stamp.Size) || !r.Get(stamp.Stamp.MTime)) {
+        return;
+      }
+      stamp.Stamp.Exists = exists != 0;
+      entry.Stamps.push_back(std::move(stamp));
+    }
+    entries[key] = std::move(entry);
+  }
+  this->Entries = std::move(entries);
+}
+
+bool cmTryCompileResultCache::Save() const
+{
+  if (!this->Modified) {
+    return true;
+  }
+
+  std::string out;
+  cmBinaryCacheWriter w(out);
+  cmBinaryCacheFile::WriteHeader(out, Magic);
+  for (auto const& e : this->Entries) {
+    Result const& outcome = e.second.Outcome;
+    w.PutString(e.first);
+    w.Put(static_cast<std::uint8_t>(outcome.Compiled ? 1 : 0));
+    w.PutString(outcome.Output);
+    w.Put(static_cast<std::uint8_t>(outcome.Ran ? 1 : 0));
+    w.PutString(outcome.RunResult);
+    w.PutString(outcome.RunOutput);
+    w.Put(static_cast<std::uint32_t>(e.second.Stamps.size()));
+    for (PathStamp const& stamp : e.second.Stamps) {
+      w.PutString(stamp.Path);
+      w.Put(static_cast<std::uint8_t>(stamp.Stamp.Exists ? 1 : 0));
+      w.Put(stamp.Stamp.Size);
+      w.Put(stamp.Stamp.MTime);
+    }
+  }
+
+  return cmBinaryCacheFile::Write(this->Path, out);
+}
+
+bool cmTryCompileResultCache::Lookup(std::string const& key, Result& result)
+{
+  auto i = this->Entries.find(HashKey(key));
+  if (i == this->Entries.end()) {
+    ++this->Misses;
+    return false;
+  }
+  for (PathStamp const& stamp : i->second.Stamps) {
+    if (cmBinaryCacheFile::StampPath(stamp.Path) != stamp.Stamp) {
+      this->Entries.erase(i);
+      this->Modified = true;
+      ++this->Misses;
+      return false;
+    }
+  }
+  result = i->second.Outcome;
+  ++this->Hits;
+  return true;
+}
+
+void cmTryCompileResultCache::Store(std::string const& key, Result result,
+                                    std::vector<std::string> const& paths)
+{
+  std::int64_t const now = cmBinaryCacheFile::Now();
+
+  Entry entry;
+  entry.Outcome = std::move(result);
+  for (std::string const& path : paths) {
+    PathStamp stamp;
+    stamp.Path = path;
+    stamp.Stamp = cmBinaryCacheFile::StampPath(path);
+    if (!cmBinaryCacheFile::IsSettled(stamp.Stamp, now)) {
+      return;
+    }
+    entry.Stamps.push_back(std::move(stamp));
+  }
+  this->Entries[HashKey(key)] = std::move(entry);
+  this->Modified = true;
+}
+
+std::string cmTryCompileResultCache::HashKey(std::string const& key)
+{
+  // The key holds whole source files and toolchain files.  Store only
+  // its hash.
+  cmCryptoHash hasher(cmCryptoHash::AlgoSHA256);
+  return hasher.HashString(key);
+}
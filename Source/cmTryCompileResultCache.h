@@ -0,0 +1,94 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmTryCompileResultCache_h
+#define cmTryCompileResultCache_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cmBinaryCacheFile.h"
+
+/** \class cmTryCompileResultCache
+ * \brief Remember the results of try_compile and try_run checks across
+ *        build trees.
+ *
+ * An entry is keyed by a hash of everything the test project depends
+ * on: the generated project code, the content of the sources, the flags
+ * given to the project, the identity of the compilers and the content
+ * of the toolchain file.  It stores the result and output of the check
+ * together with stamps of the compilers, of the directories searched
+ * for headers and libraries, and of the subdirectories of the include
+ * directories named by included headers, like "sys" for <sys/foo.h>.  A later check with the same key reuses
+ * the result as long as none of these stamps changed, without building
+ * the test project.
+ *
+ * The cache lives in a single file that may be shared by any number of
+ * build trees.  Only results whose stamped paths were last modified
+ * more than a second earlier are stored, so a change within the
+ * resolution of a time stamp is never missed.
+ */
+class cmTryCompileResultCache
+{
+public:
+  struct Result
+  {
+    bool Compiled = false;
+    std::string Output;
+    // Set for try_run checks whose executable was run.
+    bool Ran = false;
+    std::string RunResult;
+    std::string RunOutput;
+  };
+
+  cmTryCompileResultCache(std::string path);
+
+  cmTryCompileResultCache(cmTryCompileResultCache const&) = delete;
+  cmTryCompileResultCache& operator=(cmTryCompileResultCache const&) =
+    delete;
+
+  std::string const& GetPath() const { return this->Path; }
+
+  /** Read the cache file.  Missing, corrupt, or foreign cache files
+      are silently ignored.  */
+  void Load();
+
+  /** Write the entries back to the cache file if any changed.  */
+  bool Save() const;
+
+  /** Look up the result of a check.  Return false if there is no entry
+      for the key or if a stamped path changed since it was stored.  */
+  bool Lookup(std::string const& key, Result& result);
+
+  /** Store the result of a check depending on the given paths.  */
+  void Store(std::string const& key, Result result,
+             std::vector<std::string> const& paths);
+
+  unsigned long GetHits() const { return this->Hits; }
+  unsigned long GetMisses() const { return this->Misses; }
+
+private:
+  struct PathStamp
+  {
+    std::string Path;
+    cmBinaryCacheFile::Stamp Stamp;
+  };
+
+  struct Entry
+  {
+    Result Outcome;
+    std::vector<PathStamp> Stamps;
+  };
+
+  static std::string HashKey(std::string const& key);
+
+  std::string Path;
+  std::unordered_map<std::string, Entry> Entries;
+  unsigned long Hits = 0;
+  unsigned long Misses = 0;
+  bool Modified = false;
+};
+
+#endif
@@ -6,6 +6,7 @@
 
 #include "cmsys/FStream.hxx"
 
+#include "cmDirectoryListingCache.h"
 #include "cmDuration.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
@@ -118,11 +119,30 @@ bool cmTryRunCommand::InitialPass(std::vector<std::string> const& argv,
   this->RunResultVariable = argv[0];
   this->CompileResultVariable = argv[1];
 
+  // The result of running the executable may be cached unless it is
+  // left to the user to provide.
+  bool const runOnHost =
+    !this->Makefile->IsOn("CMAKE_CROSSCOMPILING") ||
+    this->Makefile->IsDefinitionSet("CMAKE_CROSSCOMPILING_EMULATOR");
+  this->RunKey.clear();
+  if (runOnHost) {
+    this->RunKey = cmStrCat(
+      runArgs, '\n',
+      this->Makefile->GetSafeDefinition("CMAKE_CROSSCOMPILING_EMULATOR"));
+  }
+
   // do the try compile
   int res = this->TryCompileCode(tryCompile, true);
 
-  // now try running the command if it compiled
-  if (!res) {
+  if (this->CacheHit) {
+    if (!res && this->CachedResult.Ran) {
+      this->Makefile->AddCacheDefinition(
+        this->RunResultVariable, this->CachedResult.RunResult.c_str(),
+        "Result of TRY_RUN", cmStateEnums::INTERNAL);
+      this->StoreRunOutput(this->CachedResult.RunOutput);
+    }
+  } else if (!res) {
+    // now try running the command if it compiled
     if (this->OutputFile.empty()) {
       cmSystemTools::Error(this->FindErrorMessage);
     } else {
@@ -134,25 +154,20 @@ bool cmTryRunCommand::InitialPass(std::vector<std::string> const& argv,
           runArgs, argv[3], captureRunOutput ? &runOutputContents : nullptr);
       } else {
         this->RunExecutable(runArgs, &runOutputContents);
-      }
-
-      // now put the output into the variables
-      if (!this->RunOutputVariable.empty()) {
-        this->Makefile->AddDefinition(this->RunOutputVariable,
-                                      runOutputContents);
-      }
-
-      if (!this->OutputVariable.empty()) {
-        // if the TryCompileCore saved output in this outputVariable then
-        // prepend that output to this output
-        const char* compileOutput =
-          this->Makefile->GetDefinition(this->OutputVariable);
-        if (compileOutput) {
-          runOutputContents = compileOutput + runOutputContents;
+        std::string const runResult =
+          this->Makefile->GetSafeDefinition(this->RunResultVariable);
+        if (runResult != "FAILED_TO_RUN") {
+          this->CachedResult.Ran = true;
+          this->CachedResult.RunResult = runResult;
+          this->CachedResult.RunOutput = runOutputContents;
+          this->StoreCachedResult();
         }
-        this->Makefile->AddDefinition(this->OutputVariable, runOutputContents);
       }
+
+      this->StoreRunOutput(runOutputContents);
     }
+  } else {
+    this->StoreCachedResult();
   }
 
   // if we created a directory etc, then cleanup after ourselves
@@ -162,6 +177,25 @@ bool cmTryRunCommand::InitialPass(std::vector<std::string> const& argv,
   return true;
 }
 
+void cmTryRunCommand::StoreRunOutput(std::string runOutputContents)
+{
+  // now put the output into the variables
+  if (!this->RunOutputVariable.empty()) {
+    this->Makefile->AddDefinition(this->RunOutputVariable, runOutputContents);
+  }
+
+  if (!this->OutputVariable.empty()) {
+    // if the TryCompileCore saved output in this outputVariable then
+    // prepend that output to this output
+    const char* compileOutput =
+      this->Makefile->GetDefinition(this->OutputVariable);
+    if (compileOutput) {
+      runOutputContents = compileOutput + runOutputContents;
+    }
+    this->Makefile->AddDefinition(this->OutputVariable, runOutputContents);
+  }
+}
+
 void cmTryRunCommand::RunExecutable(const std::string& runArgs,
                                     std::string* out)
 {
@@ -186,6 +220,8 @@ void cmTryRunCommand::RunExecutable(const std::string& runArgs,
   if (!runArgs.empty()) {
     finalCommand += runArgs;
   }
+  // The executable may change any file the find commands look for.
+  this->Makefile->GetCMakeInstance()->GetDirectoryListingCache()->Clear();
   bool worked = cmSystemTools::RunSingleCommand(
     finalCommand, out, out, &retVal, nullptr, cmSystemTools::OUTPUT_NONE,
     cmDuration::zero());
@@ -44,6 +44,7 @@ private:
   void DoNotRunExecutable(const std::string& runArgs,
                           const std::string& srcFile,
                           std::string* runOutputContents);
+  void StoreRunOutput(std::string runOutputContents);
 
   std::string CompileResultVariable;
   std::string RunResultVariable;
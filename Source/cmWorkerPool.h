@@ -147,7 +147,7 @@ public:
    *
    * Useful as the last job in the job queue.
    */
-  class JobEndT : JobFenceT
+  class JobEndT : public JobFenceT
   {
   public:
     //! Does nothing
@@ -6,10 +6,12 @@
 
 #include "cm_sys_stat.h"
 
+#include "cmDirectoryListingCache.h"
 #include "cmExecutionStatus.h"
 #include "cmMakefile.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
+#include "cmake.h"
 
 // cmLibraryCommand
 bool cmWriteFileCommand(std::vector<std::string> const& args,
@@ -44,6 +46,10 @@ bool cmWriteFileCommand(std::vector<std::string> const& args,
 
   std::string dir = cmSystemTools::GetFilenamePath(fileName);
   cmSystemTools::MakeDirectory(dir);
+  status.GetMakefile()
+    .GetCMakeInstance()
+    ->GetDirectoryListingCache()
+    ->Invalidate(fileName);
 
   mode_t mode = 0;
   bool writable = false;
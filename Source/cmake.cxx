@@ -12,12 +12,14 @@
 
 #include "cmAlgorithms.h"
 #include "cmCommands.h"
+#include "cmDirectoryListingCache.h"
 #include "cmDocumentation.h"
 #include "cmDocumentationEntry.h"
 #include "cmDocumentationFormatter.h"
 #include "cmDuration.h"
 #include "cmExternalMakefileProjectGenerator.h"
 #include "cmFileTimeCache.h"
+#include "cmGeneratorExpressionCache.h"
 #include "cmGeneratorTarget.h"
 #include "cmGlobalGenerator.h"
 #include "cmGlobalGeneratorFactory.h"
@@ -41,7 +43,12 @@
 #  include "cm_jsoncpp_writer.h"
 
 #  include "cmFileAPI.h"
+#  include "cmFileFingerprintCache.h"
+#  include "cmFindPackageResolutionCache.h"
 #  include "cmGraphVizWriter.h"
+#  include "cmMakefileProfilingData.h"
+#  include "cmParsedListFileCache.h"
+#  include "cmTryCompileResultCache.h"
 #  include "cmVariableWatch.h"
 #endif
 
@@ -113,6 +120,7 @@
 #include <initializer_list>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 
 #include "cmsys/FStream.hxx"
@@ -140,6 +148,7 @@ static void cmWarnUnusedCliWarning(const std::string& variable, int /*unused*/,
 
 cmake::cmake(Role role, cmState::Mode mode)
   : FileTimeCache(cm::make_unique<cmFileTimeCache>())
+  , DirectoryListingCache(cm::make_unique<cmDirectoryListingCache>())
 #ifndef CMAKE_BOOTSTRAP
   , VariableWatch(cm::make_unique<cmVariableWatch>())
 #endif
@@ -203,6 +212,11 @@ cmake::cmake(Role role, cmState::Mode mode)
 
 cmake::~cmake()
 {
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->FileFingerprintCache) {
+    cmSystemTools::SetFileFingerprintCache(nullptr);
+  }
+#endif
   if (this->GlobalGenerator) {
     delete this->GlobalGenerator;
     this->GlobalGenerator = nullptr;
@@ -626,6 +640,10 @@ void cmake::SetArgs(const std::vector<std::string>& args)
 {
   bool haveToolset = false;
   bool havePlatform = false;
+#if !defined(CMAKE_BOOTSTRAP)
+  std::string profilingFormat;
+  std::string profilingOutput;
+#endif
   for (unsigned int i = 1; i < args.size(); ++i) {
     std::string const& arg = args[i];
     if (arg.find("-H", 0) == 0 || arg.find("-S", 0) == 0) {
@@ -768,7 +786,25 @@ void cmake::SetArgs(const std::vector<std::string>& args)
       std::cout << "Running with trace output on.\n";
       this->SetTrace(true);
       this->SetTraceExpand(false);
-    } else if (arg.find("--warn-uninitialized", 0) == 0) {
+    }
+#if !defined(CMAKE_BOOTSTRAP)
+    else if (arg.find("--profiling-format=", 0) == 0) {
+      profilingFormat = arg.substr(strlen("--profiling-format="));
+      if (profilingFormat.empty()) {
+        cmSystemTools::Error("No format specified for --profiling-format");
+        return;
+      }
+    } else if (arg.find("--profiling-output=", 0) == 0) {
+      profilingOutput = arg.substr(strlen("--profiling-output="));
+      if (profilingOutput.empty()) {
+        cmSystemTools::Error("No path specified for --profiling-output");
+        return;
+      }
+      profilingOutput = cmSystemTools::CollapseFullPath(profilingOutput);
+      cmSystemTools::ConvertToUnixSlashes(profilingOutput);
+    }
+#endif
+    else if (arg.find("--warn-uninitialized", 0) == 0) {
       std::cout << "Warn about uninitialized values.\n";
       this->SetWarnUninitialized(true);
     } else if (arg.find("--warn-unused-vars", 0) == 0) {
@@ -855,6 +891,29 @@ void cmake::SetArgs(const std::vector<std::string>& args)
     }
   }
 
+#if !defined(CMAKE_BOOTSTRAP)
+  if (!profilingOutput.empty() || !profilingFormat.empty()) {
+    if (profilingOutput.empty()) {
+      cmSystemTools::Error(
+        "--profiling-format specified but no --profiling-output!");
+      return;
+    }
+    if (!profilingFormat.empty() && profilingFormat != "google-trace") {
+      cmSystemTools::Error(
+        cmStrCat("Invalid format specified for --profiling-format: ",
+                 profilingFormat));
+      return;
+    }
+    try {
+      this->ProfilingOutput =
+        cm::make_unique<cmMakefileProfilingData>(profilingOutput);
+    } catch (std::runtime_error& e) {
+      cmSystemTools::Error(cmStrCat("Could not start profiling: ", e.what()));
+      return;
+    }
+  }
+#endif
+
   const bool haveSourceDir = !this->GetHomeDirectory().empty();
   const bool haveBinaryDir = !this->GetHomeOutputDirectory().empty();
 
@@ -1546,10 +1605,133 @@ int cmake::ActualConfigure()
 #if !defined(CMAKE_BOOTSTRAP)
   this->FileAPI = cm::make_unique<cmFileAPI>(this);
   this->FileAPI->ReadQueries();
+
+  this->ParsedListFileCache.reset();
+  if (!this->State->GetIsInTryCompile()) {
+    const std::string* useCache =
+      this->State->GetInitializedCacheValue("CMAKE_LISTFILE_PARSE_CACHE");
+    if (useCache) {
+      this->MarkCliAsUsed("CMAKE_LISTFILE_PARSE_CACHE");
+    }
+    if (useCache && cmIsOn(*useCache)) {
+      this->ParsedListFileCache = cm::make_unique<cmParsedListFileCache>(
+        cmStrCat(this->GetHomeOutputDirectory(),
+                 "/CMakeFiles/ListFileParseCache.bin"));
+      this->ParsedListFileCache->Load();
+    }
+
+    if (this->FileFingerprintCache) {
+      cmSystemTools::SetFileFingerprintCache(nullptr);
+      this->FileFingerprintCache.reset();
+    }
+    const std::string* useFingerprints =
+      this->State->GetInitializedCacheValue("CMAKE_FILE_FINGERPRINT_CACHE");
+    if (useFingerprints) {
+      this->MarkCliAsUsed("CMAKE_FILE_FINGERPRINT_CACHE");
+    }
+    if (useFingerprints && cmIsOn(*useFingerprints)) {
+      this->FileFingerprintCache = cm::make_unique<cmFileFingerprintCache>(
+        cmStrCat(this->GetHomeOutputDirectory(),
+                 "/CMakeFiles/FileFingerprintCache.bin"));
+      this->FileFingerprintCache->Load();
+      cmSystemTools::SetFileFingerprintCache(
+        this->FileFingerprintCache.get());
+    }
+
+    this->FindPackageResolutionCache.reset();
+    const std::string* resolutionCache = this->State->GetInitializedCacheValue(
+      "CMAKE_FIND_PACKAGE_RESOLUTION_CACHE");
+    if (resolutionCache) {
+      this->MarkCliAsUsed("CMAKE_FIND_PACKAGE_RESOLUTION_CACHE");
+    }
+    if (resolutionCache && !resolutionCache->empty()) {
+      this->FindPackageResolutionCache =
+        cm::make_unique<cmFindPackageResolutionCache>(
+          cmSystemTools::CollapseFullPath(*resolutionCache,
+                                          this->GetHomeOutputDirectory()));
+      this->FindPackageResolutionCache->Load();
+    }
+
+    // The environment may name a cache shared by all build trees of
+    // the user.
+    this->TryCompileResultCache.reset();
+    std::string resultCache;
+    if (const std::string* value = this->State->GetInitializedCacheValue(
+          "CMAKE_TRY_COMPILE_RESULT_CACHE")) {
+      this->MarkCliAsUsed("CMAKE_TRY_COMPILE_RESULT_CACHE");
+      resultCache = *value;
+    } else {
+      cmSystemTools::GetEnv("CMAKE_TRY_COMPILE_RESULT_CACHE", resultCache);
+    }
+    if (!resultCache.empty()) {
+      this->TryCompileResultCache = cm::make_unique<cmTryCompileResultCache>(
+        cmSystemTools::CollapseFullPath(resultCache,
+                                        this->GetHomeOutputDirectory()));
+      this->TryCompileResultCache->Load();
+    }
+  }
 #endif
 
   // actually do the configure
+  this->DirectoryListingCache->ResetCounters();
+  this->DirectoryListingCache->SetEnabled(true);
   this->GlobalGenerator->Configure();
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->ProfilingOutput) {
+    Json::Value counters(Json::objectValue);
+    counters["lookups"] =
+      Json::Value::UInt64(this->DirectoryListingCache->GetLookups());
+    counters["listings"] =
+      Json::Value::UInt64(this->DirectoryListingCache->GetListings());
+    counters["stats"] =
+      Json::Value::UInt64(this->DirectoryListingCache->GetStats());
+    this->ProfilingOutput->WriteCounter("DirectoryListingCache",
+                                        std::move(counters));
+  }
+#endif
+  // Later steps do not keep the listings up to date.
+  this->DirectoryListingCache->SetEnabled(false);
+
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->ParsedListFileCache) {
+    if (!cmSystemTools::GetErrorOccuredFlag()) {
+      this->ParsedListFileCache->Save();
+    }
+    if (this->ProfilingOutput) {
+      Json::Value counters(Json::objectValue);
+      counters["hits"] =
+        Json::Value::UInt64(this->ParsedListFileCache->GetHits());
+      counters["misses"] =
+        Json::Value::UInt64(this->ParsedListFileCache->GetMisses());
+      this->ProfilingOutput->WriteCounter("ListFileParseCache",
+                                          std::move(counters));
+    }
+  }
+  if (this->FindPackageResolutionCache) {
+    this->FindPackageResolutionCache->Save();
+    if (this->ProfilingOutput) {
+      Json::Value counters(Json::objectValue);
+      counters["hits"] =
+        Json::Value::UInt64(this->FindPackageResolutionCache->GetHits());
+      counters["misses"] =
+        Json::Value::UInt64(this->FindPackageResolutionCache->GetMisses());
+      this->ProfilingOutput->WriteCounter("FindPackageResolutionCache",
+                                          std::move(counters));
+    }
+  }
+  if (this->TryCompileResultCache) {
+    this->TryCompileResultCache->Save();
+    if (this->ProfilingOutput) {
+      Json::Value counters(Json::objectValue);
+      counters["hits"] =
+        Json::Value::UInt64(this->TryCompileResultCache->GetHits());
+      counters["misses"] =
+        Json::Value::UInt64(this->TryCompileResultCache->GetMisses());
+      this->ProfilingOutput->WriteCounter("TryCompileResultCache",
+                                          std::move(counters));
+    }
+  }
+#endif
   // Before saving the cache
   // if the project did not define one of the entries below, add them now
   // so users can edit the values in the cache:
@@ -1796,6 +1978,29 @@ int cmake::Generate()
     return -1;
   }
   this->GlobalGenerator->Generate();
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->ProfilingOutput) {
+    cmGeneratorExpressionCache const& genexCache =
+      this->GlobalGenerator->GetGeneratorExpressionCache();
+    Json::Value counters(Json::objectValue);
+    counters["hits"] = Json::Value::UInt64(genexCache.GetHits());
+    counters["misses"] = Json::Value::UInt64(genexCache.GetMisses());
+    this->ProfilingOutput->WriteCounter("GeneratorExpressionCache",
+                                        std::move(counters));
+  }
+  if (this->FileFingerprintCache) {
+    this->FileFingerprintCache->Save();
+    if (this->ProfilingOutput) {
+      Json::Value counters(Json::objectValue);
+      counters["hits"] =
+        Json::Value::UInt64(this->FileFingerprintCache->GetHits());
+      counters["misses"] =
+        Json::Value::UInt64(this->FileFingerprintCache->GetMisses());
+      this->ProfilingOutput->WriteCounter("FileFingerprintCache",
+                                          std::move(counters));
+    }
+  }
+#endif
   if (!this->GraphVizFile.empty()) {
     std::cout << "Generate graphviz: " << this->GraphVizFile << std::endl;
     this->GenerateGraphViz(this->GraphVizFile);
@@ -1846,6 +2051,11 @@ std::string const& cmake::GetGlobVerifyScript() const
   return this->State->GetGlobVerifyScript();
 }
 
+std::string const& cmake::GetGlobVerifySnapshot() const
+{
+  return this->State->GetGlobVerifySnapshot();
+}
+
 std::string const& cmake::GetGlobVerifyStamp() const
 {
   return this->State->GetGlobVerifyStamp();
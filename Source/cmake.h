@@ -26,11 +26,19 @@
 #endif
 
 class cmExternalMakefileProjectGeneratorFactory;
+class cmDirectoryListingCache;
 class cmFileAPI;
 class cmFileTimeCache;
 class cmGlobalGenerator;
 class cmGlobalGeneratorFactory;
 class cmMakefile;
+#if !defined(CMAKE_BOOTSTRAP)
+class cmFileFingerprintCache;
+class cmFindPackageResolutionCache;
+class cmMakefileProfilingData;
+class cmParsedListFileCache;
+class cmTryCompileResultCache;
+#endif
 class cmMessenger;
 class cmVariableWatch;
 struct cmDocumentationEntry;
@@ -296,6 +304,7 @@ public:
 
   bool DoWriteGlobVerifyTarget() const;
   std::string const& GetGlobVerifyScript() const;
+  std::string const& GetGlobVerifySnapshot() const;
   std::string const& GetGlobVerifyStamp() const;
   void AddGlobCacheEntry(bool recurse, bool listDirectories,
                          bool followSymlinks, const std::string& relative,
@@ -380,6 +389,12 @@ public:
    */
   cmFileTimeCache* GetFileTimeCache() { return this->FileTimeCache.get(); }
 
+  //! Get the directory listings shared by the find commands.
+  cmDirectoryListingCache* GetDirectoryListingCache()
+  {
+    return this->DirectoryListingCache.get();
+  }
+
   bool WasLogLevelSetViaCLI() const { return this->LogLevelWasSetViaCLI; }
 
   //! Get the selected log level for `message()` commands during the cmake run.
@@ -411,6 +426,33 @@ public:
   cmGeneratedFileStream& GetTraceFile() { return this->TraceFile; }
   void SetTraceFile(std::string const& file);
 
+#if !defined(CMAKE_BOOTSTRAP)
+  //! Get the profiling output, or null if profiling is not enabled.
+  cmMakefileProfilingData* GetProfilingOutput()
+  {
+    return this->ProfilingOutput.get();
+  }
+  bool IsProfilingEnabled() const { return this->ProfilingOutput != nullptr; }
+
+  //! Get the parsed list file cache, or null if it is not enabled.
+  cmParsedListFileCache* GetParsedListFileCache()
+  {
+    return this->ParsedListFileCache.get();
+  }
+
+  //! Get the find_package resolution cache, or null if it is not enabled.
+  cmFindPackageResolutionCache* GetFindPackageResolutionCache()
+  {
+    return this->FindPackageResolutionCache.get();
+  }
+
+  //! Get the try_compile result cache, or null if it is not enabled.
+  cmTryCompileResultCache* GetTryCompileResultCache()
+  {
+    return this->TryCompileResultCache.get();
+  }
+#endif
+
   bool GetWarnUninitialized() { return this->WarnUninitialized; }
   void SetWarnUninitialized(bool b) { this->WarnUninitialized = b; }
   bool GetWarnUnused() { return this->WarnUnused; }
@@ -578,12 +620,18 @@ private:
   bool ClearBuildSystem = false;
   bool DebugTryCompile = false;
   std::unique_ptr<cmFileTimeCache> FileTimeCache;
+  std::unique_ptr<cmDirectoryListingCache> DirectoryListingCache;
   std::string GraphVizFile;
   InstalledFilesMap InstalledFiles;
 
 #if !defined(CMAKE_BOOTSTRAP)
   std::unique_ptr<cmVariableWatch> VariableWatch;
   std::unique_ptr<cmFileAPI> FileAPI;
+  std::unique_ptr<cmMakefileProfilingData> ProfilingOutput;
+  std::unique_ptr<cmParsedListFileCache> ParsedListFileCache;
+  std::unique_ptr<cmFileFingerprintCache> FileFingerprintCache;
+  std::unique_ptr<cmFindPackageResolutionCache> FindPackageResolutionCache;
+  std::unique_ptr<cmTryCompileResultCache> TryCompileResultCache;
 #endif
 
   std::unique_ptr<cmState> State;
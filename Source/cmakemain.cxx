@@ -84,6 +84,10 @@ const char* cmDocumentationOptions[][2] = {
     "Trace only this CMake file/module. Multiple options allowed." },
   { "--trace-redirect=<file>",
     "Redirect trace output to a file instead of stderr." },
+  { "--profiling-output=<file>",
+    "Write configure-time profiling data to the given file." },
+  { "--profiling-format=<fmt>",
+    "Select the profiling output format (default: google-trace)." },
   { "--warn-uninitialized", "Warn about uninitialized values." },
   { "--warn-unused-vars", "Warn about unused variables." },
   { "--no-warn-unused-cli", "Don't warn about command line options." },
@@ -515,6 +519,7 @@ int do_install(int ac, char const* const* av)
   std::string component;
   std::string prefix;
   std::string dir;
+  int jobs = cmake::NO_BUILD_PARALLEL_LEVEL;
   bool strip = false;
   bool verbose = cmSystemTools::HasEnv("VERBOSE");
 
@@ -530,7 +535,21 @@ int do_install(int ac, char const* const* av)
   Doing doing = DoingDir;
 
   for (int i = 2; i < ac; ++i) {
-    if (strcmp(av[i], "--config") == 0) {
+    if (cmHasLiteralPrefix(av[i], "-j")) {
+      const char* nextArg = ((i + 1 < ac) ? av[i + 1] : nullptr);
+      jobs = extract_job_number(i, av[i], nextArg, sizeof("-j") - 1);
+      if (jobs < 0) {
+        dir.clear();
+      }
+      doing = DoingNone;
+    } else if (cmHasLiteralPrefix(av[i], "--parallel")) {
+      const char* nextArg = ((i + 1 < ac) ? av[i + 1] : nullptr);
+      jobs = extract_job_number(i, av[i], nextArg, sizeof("--parallel") - 1);
+      if (jobs < 0) {
+        dir.clear();
+      }
+      doing = DoingNone;
+    } else if (strcmp(av[i], "--config") == 0) {
       doing = DoingConfig;
     } else if (strcmp(av[i], "--component") == 0) {
       doing = DoingComponent;
@@ -569,6 +588,26 @@ int do_install(int ac, char const* const* av)
     }
   }
 
+  if (jobs == cmake::NO_BUILD_PARALLEL_LEVEL) {
+    std::string parallel;
+    if (cmSystemTools::GetEnv("CMAKE_INSTALL_PARALLEL_LEVEL", parallel)) {
+      unsigned long numJobs = 0;
+      if (parallel.empty()) {
+        jobs = cmake::DEFAULT_BUILD_PARALLEL_LEVEL;
+      } else if (cmStrToULong(parallel, &numJobs) && numJobs > 0 &&
+                 numJobs <= INT_MAX) {
+        jobs = int(numJobs);
+      } else {
+        std::cerr << "'CMAKE_INSTALL_PARALLEL_LEVEL' environment variable\n"
+                  << "invalid number '" << parallel << "' given.\n\n";
+        dir.clear();
+      }
+    }
+  }
+  if (jobs == cmake::DEFAULT_BUILD_PARALLEL_LEVEL) {
+    jobs = static_cast<int>(cmGlobalGenerator::GetParallelThreadCount());
+  }
+
   if (dir.empty()) {
     /* clang-format off */
     std::cerr <<
@@ -579,6 +618,8 @@ int do_install(int ac, char const* const* av)
       "  --component <comp> = Component-based install. Only install <comp>.\n"
       "  --prefix <prefix>  = The installation prefix CMAKE_INSTALL_PREFIX.\n"
       "  --strip            = Performing install/strip.\n"
+      "  --parallel [<jobs>], -j [<jobs>]\n"
+      "                     = Install files using <jobs> threads.\n"
       "  -v --verbose       = Enable verbose output.\n"
       ;
     /* clang-format on */
@@ -617,6 +658,11 @@ int do_install(int ac, char const* const* av)
     args.emplace_back("-DCMAKE_INSTALL_CONFIG_NAME=" + config);
   }
 
+  if (jobs > 1) {
+    args.emplace_back("-DCMAKE_INSTALL_PARALLEL_LEVEL=" +
+                      std::to_string(jobs));
+  }
+
   args.emplace_back("-P");
   args.emplace_back(dir + "/cmake_install.cmake");
 
@@ -3,7 +3,10 @@
 #include "cmcmd.h"
 
 #include "cmAlgorithms.h"
+#include "cmBinaryCacheFile.h"
 #include "cmDuration.h"
+#include "cmFileTime.h"
+#include "cmGlobSnapshot.h"
 #include "cmGlobalGenerator.h"
 #include "cmLocalGenerator.h"
 #include "cmMakefile.h"
@@ -468,6 +471,84 @@ int cmcmd::HandleCoCompileCommands(std::vector<std::string> const& args)
   return ret;
 }
 
+// called when args[0] == "__run_and_log"
+int cmcmd::HandleRunAndLog(std::vector<std::string> const& args)
+{
+  // Usage: -E __run_and_log <logfile> -- <command>...
+  if (args.size() < 5 || args[3] != "--") {
+    std::cerr << "__run_and_log Usage: -E __run_and_log <logfile> -- "
+                 "<command>...\n";
+    return 1;
+  }
+  std::vector<std::string> cmd(args.begin() + 4, args.end());
+
+  // Capture the output so that it can be logged for this command alone
+  // even when other commands run concurrently.
+  std::string output;
+  int ret;
+  bool const ran = cmSystemTools::RunSingleCommand(
+    cmd, &output, &output, &ret, nullptr, cmSystemTools::OUTPUT_NONE);
+  if (!ran) {
+    output += "Error running '" + cmd[0] + "'\n";
+    ret = 1;
+  }
+  std::cout << output;
+
+  cmsys::ofstream fout(args[2].c_str(), std::ios::out | std::ios::app);
+  if (fout) {
+    fout << cmSystemTools::PrintSingleCommand(cmd) << "\n" << output;
+    if (!output.empty() && output.back() != '\n') {
+      fout << "\n";
+    }
+  }
+  return ret;
+}
+
+// called when args[0] == "__verify_globs"
+int cmcmd::HandleVerifyGlobs(std::vector<std::string> const& args)
+{
+  // Usage: -E __verify_globs <snapshot> <script>
+  if (args.size() != 4) {
+    std::cerr << "__verify_globs Usage: -E __verify_globs <snapshot> "
+                 "<script>\n";
+    return 1;
+  }
+  std::string const& snapshotFile = args[2];
+  std::string const& scriptFile = args[3];
+
+  // Nothing to do if no globbed directory changed since the globs were
+  // last verified.
+  cmGlobSnapshot snapshot;
+  bool const loaded = snapshot.Load(snapshotFile);
+  if (loaded && snapshot.IsUpToDate()) {
+    return 0;
+  }
+
+  std::int64_t const start = cmBinaryCacheFile::Now();
+
+  // The script touches the stamp file when a glob result changed.
+  cmFileTime stampBefore;
+  std::string const stampFile = cmStrCat(
+    cmSystemTools::GetFilenamePath(scriptFile), "/cmake.verify_globs");
+  stampBefore.Load(stampFile);
+
+  std::vector<std::string> cmd = { cmSystemTools::GetCMakeCommand(), "-P",
+                                   scriptFile };
+  int ret;
+  if (!cmSystemTools::RunSingleCommand(cmd, nullptr, nullptr, &ret, nullptr,
+                                       cmSystemTools::OUTPUT_PASSTHROUGH)) {
+    std::cerr << "Error running '" << cmd[0] << "'\n";
+    return 1;
+  }
+
+  cmFileTime stampAfter;
+  if (ret == 0 && loaded && stampAfter.Load(stampFile) &&
+      stampAfter.Equal(stampBefore) && snapshot.Record(start)) {
+    snapshot.Save(snapshotFile);
+  }
+  return ret;
+}
+
 int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args)
 {
   // IF YOU ADD A NEW COMMAND, DOCUMENT IT ABOVE and in cmakemain.cxx
@@ -485,7 +566,7 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args)
       // If error occurs we want to continue copying next files.
       bool return_value = false;
       for (auto const& arg : cmMakeRange(args).advance(2).retreat(1)) {
-        if (!cmsys::SystemTools::CopyFileAlways(arg, args.back())) {
+        if (!cmSystemTools::CopyFileAlways(arg, args.back())) {
           std::cerr << "Error copying file \"" << arg << "\" to \""
                     << args.back() << "\".\n";
           return_value = true;
@@ -629,6 +710,14 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args)
       return cmcmd::HandleCoCompileCommands(args);
     }
 
+    if (args[1] == "__run_and_log") {
+      return cmcmd::HandleRunAndLog(args);
+    }
+
+    if (args[1] == "__verify_globs") {
+      return cmcmd::HandleVerifyGlobs(args);
+    }
+
     // Echo string
     if (args[1] == "echo") {
       std::cout << cmJoin(cmMakeRange(args).advance(2), " ") << std::endl;
@@ -1084,6 +1173,8 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args)
       std::vector<std::string> files;
       std::string mtime;
       std::string format;
+      int compressionLevel = 0;
+      int numThreads = 1;
       cmSystemTools::cmTarCompression compress =
         cmSystemTools::TarCompressNone;
       int nCompress = 0;
@@ -1097,6 +1188,24 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args)
             ++nCompress;
           } else if (cmHasLiteralPrefix(arg, "--mtime=")) {
             mtime = arg.substr(8);
+          } else if (cmHasLiteralPrefix(arg, "--compression-level=")) {
+            unsigned long level;
+            if (!cmStrToULong(arg.substr(20), &level) || level < 1 ||
+                level > 22) {
+              cmSystemTools::Error(
+                "Unknown -E tar --compression-level= argument: " +
+                arg.substr(20));
+              return 1;
+            }
+            compressionLevel = static_cast<int>(level);
+          } else if (cmHasLiteralPrefix(arg, "--threads=")) {
+            unsigned long threads;
+            if (!cmStrToULong(arg.substr(10), &threads) || threads > 1024) {
+              cmSystemTools::Error("Unknown -E tar --threads= argument: " +
+                                   arg.substr(10));
+              return 1;
+            }
+            numThreads = static_cast<int>(threads);
           } else if (cmHasLiteralPrefix(arg, "--files-from=")) {
             std::string const& files_from = arg.substr(13);
             if (!cmTarFilesFrom(files_from, files)) {
@@ -1177,7 +1286,7 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args)
                                  "Warning");
         }
         if (!cmSystemTools::CreateTar(outFile, files, compress, verbose, mtime,
-                                      format)) {
+                                      format, compressionLevel, numThreads)) {
           cmSystemTools::Error("Problem creating tar: " + outFile);
           return 1;
         }
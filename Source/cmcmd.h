@@ -21,6 +21,8 @@ public:
 
 protected:
   static int HandleCoCompileCommands(std::vector<std::string> const& args);
+  static int HandleRunAndLog(std::vector<std::string> const& args);
+  static int HandleVerifyGlobs(std::vector<std::string> const& args);
   static int HashSumFile(std::vector<std::string> const& args,
                          cmCryptoHash::Algo algo);
   static int SymlinkLibrary(std::vector<std::string> const& args);
@@ -136,6 +136,15 @@ static const char* cmDocumentationOptions[][2] = {
   { "--force-new-ctest-process",
     "Run child CTest instances as new processes" },
   { "--schedule-random", "Use a random order for scheduling tests" },
+  { "--schedule-report",
+    "Report the predicted and actual time taken by the tests" },
+  { "--shard-index <index>",
+    "Run only the tests of the given shard, counting from 0" },
+  { "--shard-count <count>",
+    "Split the tests into this many shards balanced by their cost" },
+  { "--shard-workers <count>",
+    "Run the tests in this many local ctest processes and merge the "
+    "results" },
   { "--submit-index",
     "Submit individual dashboard tests with specific index" },
   { "--timeout <seconds>", "Set the default test timeout." },
@@ -0,0 +1,152 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmDependsC.h"
+#include "cmDependsCDatabase.h"
+#include "cmSystemTools.h"
+#include "cm_uv.h"
+
+#define cmFailed(m1, m2)                                                      \
+  std::cout << "FAILED: " << (m1) << (m2) << "\n";                            \
+  failed = 1
+
+namespace {
+
+using IncludeLines = cmDependsCDatabase::IncludeLines;
+using Objects = std::map<std::string, std::set<std::string>>;
+
+// Write a file with a modification time long enough ago for its scan to
+// be stored.
+void WriteFile(std::string const& path, std::string const& content,
+               double mtime)
+{
+  {
+    cmsys::ofstream fout(path.c_str());
+    fout << content;
+  }
+  uv_fs_t req;
+  uv_fs_utime(nullptr, &req, path.c_str(), mtime, mtime, nullptr);
+  uv_fs_req_cleanup(&req);
+}
+
+// Look up a file in a freshly loaded database, as the scanner of
+// another target would.
+bool Lookup(std::string const& db, std::string const& settings,
+            std::string const& file, IncludeLines& lines)
+{
+  cmDependsCDatabase database(db, settings);
+  database.Load();
+  return database.Lookup(file, lines);
+}
+
+bool Lookup(std::string const& db, std::string const& settings,
+            std::string const& file)
+{
+  IncludeLines lines;
+  return Lookup(db, settings, file, lines);
+}
+
+// Scan the given files, which include nothing, for one object file.
+void Scan(std::string const& db, std::string const& obj,
+          std::set<std::string> const& files)
+{
+  cmDependsCDatabase database(db, "settings");
+  database.Load();
+  std::map<std::string, IncludeLines> scanned;
+  std::map<std::string, IncludeLines const*> entries;
+  for (std::string const& file : files) {
+    IncludeLines& lines = scanned[file];
+    database.Lookup(file, lines);
+    entries[file] = &lines;
+  }
+  database.Save(entries, Objects{ { obj, files } });
+}
+
+}
+
+int testDependsCDatabase(int argc, char* argv[])
+{
+  if (argc < 2) {
+    std::cout << "Invalid arguments.\n";
+    return -1;
+  }
+
+  int failed = 0;
+  std::string const dir = argv[1];
+  std::string const db = dir + "/CMakeDependsC.bin";
+  std::string const src = dir + "/src.c";
+  std::string const a = dir + "/a.h";
+  std::string const b = dir + "/b.h";
+  cmSystemTools::RemoveADirectory(dir);
+  cmSystemTools::MakeDirectory(dir);
+  WriteFile(src, "#include \"a.h\"\n#include \"b.h\"\n", 1000000000);
+  WriteFile(a, "int a;\n", 1000000000);
+  WriteFile(b, "int b;\n", 1000000000);
+
+  // Scan the source of one target.
+  {
+    cmDependsCDatabase database(db, "settings");
+    database.Load();
+    IncludeLines lines;
+    if (database.Lookup(src, lines) || !lines.Modified) {
+      cmFailed("empty database has a record for ", src);
+    }
+    lines.UnscannedEntries.push_back({ "a.h", dir + "/a.h" });
+    lines.UnscannedEntries.push_back({ "b.h", dir + "/b.h" });
+    IncludeLines none;
+    database.Lookup(a, none);
+    database.Save({ { src, &lines }, { a, &none } },
+                  Objects{ { "one.o", { src, a } } });
+  }
+
+  // The scan is reused by another target with the same settings.
+  IncludeLines lines;
+  if (!Lookup(db, "settings", src, lines)) {
+    cmFailed("scan of other target is not reused: ", src);
+  } else if (lines.Modified || lines.UnscannedEntries.size() != 2 ||
+             lines.UnscannedEntries[1].FileName != "b.h" ||
+             lines.UnscannedEntries[1].QuotedLocation != b) {
+    cmFailed("scan of other target is not restored: ", src);
+  }
+  if (Lookup(db, "other settings", src)) {
+    cmFailed("scan with other settings is reused: ", src);
+  }
+
+  // A header scan is invalidated when the header changes.
+  WriteFile(a, "int a, aa;\n", 1000000100);
+  if (Lookup(db, "settings", a)) {
+    cmFailed("scan of changed header is reused: ", a);
+  }
+
+  // Records of files no object file reaches are dropped.
+  Scan(db, "two.o", { b });
+  if (!Lookup(db, "settings", b)) {
+    cmFailed("scan is not stored: ", b);
+  }
+  Scan(db, "two.o", { src });
+  if (Lookup(db, "settings", b)) {
+    cmFailed("scan of header no longer reached is kept: ", b);
+  }
+  if (!Lookup(db, "settings", src)) {
+    cmFailed("scan of other object file is dropped: ", src);
+  }
+
+  // Records of files that no longer exist are dropped, even if they
+  // reappear unchanged.
+  Scan(db, "three.o", { b });
+  cmSystemTools::RemoveFile(b);
+  Scan(db, "two.o", { a });
+  WriteFile(b, "int b;\n", 1000000000);
+  if (Lookup(db, "settings", b)) {
+    cmFailed("scan of removed header is kept: ", b);
+  }
+
+  cmSystemTools::RemoveADirectory(dir);
+  return failed;
+}
@@ -3,7 +3,10 @@
 #include <iostream>
 #include <string>
 
+#include "cmsys/FStream.hxx"
+
 #include "cmGeneratedFileStream.h"
+#include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
 #define cmFailed(m1, m2)                                                      \
@@ -84,5 +87,44 @@ int testGeneratedFileStream(int /*unused*/, char* /*unused*/ [])
   cmSystemTools::RemoveFile(file3tmp);
   cmSystemTools::RemoveFile(file4tmp);
 
+  // Destination files are only replaced when a ParallelReplace finishes.
+  {
+    cmGeneratedFileStream::ParallelReplace parallelReplace(4);
+    for (int i = 0; i < 8; ++i) {
+      cmGeneratedFileStream gfs(cmStrCat("generatedParallel", i));
+      gfs << "This is generated file " << i;
+    }
+    {
+      // Opening a file again replaces its pending version first.
+      cmGeneratedFileStream gfs("generatedParallel0");
+      gfs << "This is generated file 0 again";
+    }
+    if (cmSystemTools::FileExists("generatedParallel1")) {
+      cmFailed("Replaced file before ParallelReplace finished: ",
+               "generatedParallel1");
+    }
+    if (!cmSystemTools::FileExists("generatedParallel1.tmp")) {
+      cmFailed("Cannot find pending temporary file: ",
+               "generatedParallel1.tmp");
+    }
+  }
+  for (int i = 0; i < 8; ++i) {
+    std::string const name = cmStrCat("generatedParallel", i);
+    std::string content;
+    cmsys::ifstream fin(name.c_str());
+    if (!fin || !std::getline(fin, content)) {
+      cmFailed("Cannot find file: ", name);
+    } else if (content !=
+               cmStrCat("This is generated file ", i,
+                        i == 0 ? " again" : "")) {
+      cmFailed("Unexpected content in file: ", name);
+    }
+    fin.close();
+    if (cmSystemTools::FileExists(name + ".tmp")) {
+      cmFailed("Temporary file is still here: ", name + ".tmp");
+    }
+    cmSystemTools::RemoveFile(name);
+  }
+
   return failed;
 }
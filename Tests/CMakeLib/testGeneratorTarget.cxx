@@ -0,0 +1,121 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmGeneratorTarget.h"
+#include "cmGlobalGenerator.h"
+#include "cmListFileCache.h"
+#include "cmState.h"
+#include "cmStateTypes.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+#include "cmTarget.h"
+#include "cmake.h"
+
+#define cmFailed(m1, m2)                                                      \
+  std::cout << "FAILED: " << (m1) << (m2) << "\n";                            \
+  failed = 1
+
+namespace {
+
+std::string Join(std::vector<BT<std::string>> const& values)
+{
+  std::string result;
+  char const* sep = "";
+  for (BT<std::string> const& v : values) {
+    result += sep;
+    result += v.Value;
+    sep = ";";
+  }
+  return result;
+}
+
+}
+
+int testGeneratorTarget(int argc, char* argv[])
+{
+  if (argc < 3) {
+    std::cout << "Invalid arguments.\n";
+    return -1;
+  }
+  cmSystemTools::FindCMakeResources(argv[1]);
+
+  int failed = 0;
+  std::string const dir = argv[2];
+  std::string const src = dir + "/src";
+  std::string const bin = dir + "/bin";
+  cmSystemTools::RemoveADirectory(dir);
+  cmSystemTools::MakeDirectory(src);
+  cmSystemTools::MakeDirectory(bin);
+  {
+    cmsys::ofstream fout((src + "/CMakeLists.txt").c_str());
+    fout << "cmake_minimum_required(VERSION 3.16)\n"
+            "cmake_policy(SET CMP0043 OLD)\n"
+            "project(CompileInfoCache NONE)\n"
+            "add_library(dep INTERFACE)\n"
+            "set_property(TARGET dep PROPERTY\n"
+            "  INTERFACE_COMPILE_DEFINITIONS DEP_A)\n"
+            "set_property(TARGET dep PROPERTY\n"
+            "  INTERFACE_INCLUDE_DIRECTORIES /dep/a)\n"
+            "add_library(lib STATIC lib.h)\n"
+            "target_link_libraries(lib PRIVATE dep)\n"
+            "set_property(TARGET lib PROPERTY COMPILE_DEFINITIONS LIB_A)\n"
+            "set_property(TARGET lib PROPERTY INCLUDE_DIRECTORIES /lib/a)\n";
+    cmsys::ofstream((src + "/lib.h").c_str());
+  }
+
+  cmake cm(cmake::RoleProject, cmState::Project);
+  cm.SetHomeDirectory(src);
+  cm.SetHomeOutputDirectory(bin);
+  cm.SetGlobalGenerator(cm.CreateGlobalGenerator("Unix Makefiles"));
+  // The native build tool is never run.
+  cm.AddCacheEntry("CMAKE_MAKE_PROGRAM", "make", "",
+                   cmStateEnums::FILEPATH);
+  if (cm.LoadCache() != 0 || cm.Configure() != 0) {
+    std::cout << "FAILED: configuring " << src << "\n";
+    return 1;
+  }
+  cmGlobalGenerator* gg = cm.GetGlobalGenerator();
+  if (!gg->Compute()) {
+    std::cout << "FAILED: computing " << src << "\n";
+    return 1;
+  }
+
+  cmGeneratorTarget* lib = gg->FindGeneratorTarget("lib");
+  cmTarget* dep = gg->FindTarget("dep");
+  auto const check = [&failed, lib](std::string const& config,
+                                    std::string const& defs,
+                                    std::string const& incs) {
+    std::string const actualDefs =
+      Join(lib->GetCompileDefinitions(config, "C"));
+    if (actualDefs != defs) {
+      cmFailed("compile definitions are not " + defs + ": ", actualDefs);
+    }
+    std::string const actualIncs =
+      Join(lib->GetIncludeDirectories(config, "C"));
+    if (actualIncs != incs) {
+      cmFailed("include directories are not " + incs + ": ", actualIncs);
+    }
+  };
+
+  // Fill the caches, then change the properties they are computed from,
+  // of the target itself and of a target it uses.
+  check("", "LIB_A;DEP_A", "/lib/a;/dep/a");
+  check("Debug", "LIB_A;DEP_A", "/lib/a;/dep/a");
+  dep->SetProperty("INTERFACE_COMPILE_DEFINITIONS", "DEP_B");
+  check("", "LIB_A;DEP_B", "/lib/a;/dep/a");
+  lib->Target->SetProperty("COMPILE_DEFINITIONS_DEBUG", "LIB_DEBUG");
+  check("", "LIB_A;DEP_B", "/lib/a;/dep/a");
+  check("Debug", "LIB_A;DEP_B;LIB_DEBUG", "/lib/a;/dep/a");
+  dep->AppendProperty("INTERFACE_INCLUDE_DIRECTORIES", "/dep/b");
+  check("", "LIB_A;DEP_B", "/lib/a;/dep/a;/dep/b");
+  lib->AddIncludeDirectory("/lib/b", true);
+  check("", "LIB_A;DEP_B", "/lib/b;/lib/a;/dep/a;/dep/b");
+
+  cmSystemTools::RemoveADirectory(dir);
+  return failed;
+}
@@ -0,0 +1,20 @@
+set(check_pairs "")
+foreach(form IN ITEMS quoted angle blanks percent import)
+  set(src ${CMAKE_CURRENT_BINARY_DIR}/MakeIncludeDirectives-${form}.c)
+  set(out ${CMAKE_CURRENT_BINARY_DIR}/MakeIncludeDirectives-${form}.out)
+  add_custom_command(
+    OUTPUT ${out}
+    COMMAND ${CMAKE_COMMAND} -E touch ${out}
+    DEPENDS ${src}
+    IMPLICIT_DEPENDS C ${src})
+  list(APPEND outs ${out})
+  string(APPEND check_pairs
+    "  \"${out}|${CMAKE_CURRENT_BINARY_DIR}/MakeIncludeDirectives-${form}.h\"\n")
+endforeach()
+add_custom_target(generate ALL DEPENDS ${outs})
+set_property(TARGET generate PROPERTY INCLUDE_DIRECTORIES ${CMAKE_CURRENT_BINARY_DIR})
+
+file(GENERATE OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/check-$<LOWER_CASE:$<CONFIG>>.cmake CONTENT "
+set(check_pairs
+${check_pairs})
+")
@@ -0,0 +1,17 @@
+set(directives
+  quoted  "#include \"MakeIncludeDirectives-quoted.h\""
+  angle   "#include <MakeIncludeDirectives-angle.h>"
+  blanks  " \t# \tinclude\t\"MakeIncludeDirectives-blanks.h\"\r"
+  percent "%include <MakeIncludeDirectives-percent.h>"
+  import  "#import<MakeIncludeDirectives-import.h>"
+  )
+while(directives)
+  list(POP_FRONT directives form directive)
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeIncludeDirectives-${form}.c"
+    "/* #include \"MakeIncludeDirectives-none.h\" */\n"
+    "#include_next <MakeIncludeDirectives-none.h>\n"
+    "${directive}\n"
+    )
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeIncludeDirectives-${form}.h"
+    "/* step 1 */\n")
+endwhile()
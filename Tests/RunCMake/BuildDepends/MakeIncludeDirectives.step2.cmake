@@ -0,0 +1,4 @@
+foreach(form IN ITEMS quoted angle blanks percent import)
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeIncludeDirectives-${form}.h"
+    "/* step 2 */\n")
+endforeach()
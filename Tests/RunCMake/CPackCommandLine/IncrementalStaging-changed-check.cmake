@@ -0,0 +1,15 @@
+if(NOT actual_stdout MATCHES "Reuse unchanged package: [^\n]*-a\\.tar\\.gz")
+  string(APPEND RunCMake_TEST_FAILED "Package of unchanged component a was not reused.\n")
+endif()
+if(actual_stdout MATCHES "Reuse unchanged package: [^\n]*-b\\.tar\\.gz")
+  string(APPEND RunCMake_TEST_FAILED "Package of changed component b was reused.\n")
+endif()
+file(GLOB stale "${RunCMake_TEST_BINARY_DIR}/_CPack_Packages/*/TGZ/*/b/share/stale.txt")
+if(stale)
+  string(APPEND RunCMake_TEST_FAILED "Stale staged file was not removed:\n ${stale}\n")
+endif()
+file(GLOB package "${RunCMake_TEST_BINARY_DIR}/Incremental-1-*-b.tar.gz")
+execute_process(COMMAND ${CMAKE_COMMAND} -E tar tf ${package} OUTPUT_VARIABLE content)
+if(content MATCHES "stale")
+  string(APPEND RunCMake_TEST_FAILED "Package holds the stale file:\n${content}\n")
+endif()
@@ -0,0 +1,11 @@
+file(WRITE "${CMAKE_BINARY_DIR}/a.txt" "a\n")
+file(WRITE "${CMAKE_BINARY_DIR}/b.txt" "b\n")
+install(FILES "${CMAKE_BINARY_DIR}/a.txt" DESTINATION share COMPONENT a)
+install(FILES "${CMAKE_BINARY_DIR}/b.txt" DESTINATION share COMPONENT b)
+
+set(CPACK_PACKAGE_NAME "Incremental")
+set(CPACK_PACKAGE_VERSION "1")
+set(CPACK_GENERATOR "TGZ")
+set(CPACK_ARCHIVE_COMPONENT_INSTALL ON)
+set(CPACK_INCREMENTAL_STAGING ON)
+include(CPack)
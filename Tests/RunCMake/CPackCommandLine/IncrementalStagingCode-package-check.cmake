@@ -0,0 +1,7 @@
+file(GLOB package "${RunCMake_TEST_BINARY_DIR}/IncrementalCode-1-*.tar.gz")
+execute_process(COMMAND ${CMAKE_COMMAND} -E tar tf ${package} OUTPUT_VARIABLE content)
+foreach(file a.txt gen.txt)
+  if(NOT content MATCHES "share/${file}")
+    string(APPEND RunCMake_TEST_FAILED "Package does not hold share/${file}:\n${content}\n")
+  endif()
+endforeach()
@@ -0,0 +1,10 @@
+file(WRITE "${CMAKE_BINARY_DIR}/a.txt" "a\n")
+install(FILES "${CMAKE_BINARY_DIR}/a.txt" DESTINATION share)
+# Files written by install(CODE) are not in the install manifest.
+install(CODE "file(WRITE \"\$ENV{DESTDIR}\${CMAKE_INSTALL_PREFIX}/share/gen.txt\" x)")
+
+set(CPACK_PACKAGE_NAME "IncrementalCode")
+set(CPACK_PACKAGE_VERSION "1")
+set(CPACK_GENERATOR "TGZ")
+set(CPACK_INCREMENTAL_STAGING ON)
+include(CPack)
@@ -0,0 +1,8 @@
+if(actual_stdout MATCHES "Remove stale staged file: [^\n]*/share/[ab]\\.txt")
+  string(APPEND RunCMake_TEST_FAILED "Staged file of a component was removed:\n${actual_stdout}\n")
+endif()
+file(GLOB staged "${RunCMake_TEST_BINARY_DIR}/_CPack_Packages/*/DEB/*/ALL_COMPONENTS_IN_ONE/*/share/*.txt")
+list(TRANSFORM staged REPLACE ".*/" "")
+if(NOT staged STREQUAL "a.txt;b.txt")
+  string(APPEND RunCMake_TEST_FAILED "Staged files are not a.txt and b.txt:\n ${staged}\n")
+endif()
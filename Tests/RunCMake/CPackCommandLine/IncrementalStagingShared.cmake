@@ -0,0 +1,13 @@
+file(WRITE "${CMAKE_BINARY_DIR}/a.txt" "a\n")
+file(WRITE "${CMAKE_BINARY_DIR}/b.txt" "b\n")
+install(FILES "${CMAKE_BINARY_DIR}/a.txt" DESTINATION share COMPONENT a)
+install(FILES "${CMAKE_BINARY_DIR}/b.txt" DESTINATION share COMPONENT b)
+
+set(CPACK_PACKAGE_NAME "IncrementalShared")
+set(CPACK_PACKAGE_VERSION "1")
+set(CPACK_PACKAGE_CONTACT "None")
+set(CPACK_GENERATOR "DEB")
+set(CPACK_DEB_COMPONENT_INSTALL ON)
+set(CPACK_COMPONENTS_ALL_IN_ONE_PACKAGE ON)
+set(CPACK_INCREMENTAL_STAGING ON)
+include(CPack)
@@ -8,3 +8,40 @@ set(CPACK_PACKAGE_VERSION "1")
 set(RunCMake_TEST_NO_CLEAN 1)
 run_cmake_command(NotAGenerator ${CMAKE_CPACK_COMMAND} -G NotAGenerator)
 unset(RunCMake_TEST_NO_CLEAN)
+
+function(run_IncrementalStaging)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/IncrementalStaging-build)
+  run_cmake(IncrementalStaging)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(IncrementalStaging-first ${CMAKE_CPACK_COMMAND})
+  run_cmake_command(IncrementalStaging-reuse ${CMAKE_CPACK_COMMAND})
+  # Make sure the modified file gets a newer time stamp.
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1)
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/b.txt" "changed b\n")
+  file(GLOB staged LIST_DIRECTORIES true
+    "${RunCMake_TEST_BINARY_DIR}/_CPack_Packages/*/TGZ/*/b/share")
+  file(WRITE "${staged}/stale.txt" "stale\n")
+  run_cmake_command(IncrementalStaging-changed ${CMAKE_CPACK_COMMAND})
+endfunction()
+run_IncrementalStaging()
+
+function(run_IncrementalStagingShared)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/IncrementalStagingShared-build)
+  run_cmake(IncrementalStagingShared)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(IncrementalStagingShared-first ${CMAKE_CPACK_COMMAND})
+  file(GLOB staged LIST_DIRECTORIES true
+    "${RunCMake_TEST_BINARY_DIR}/_CPack_Packages/*/DEB/*/ALL_COMPONENTS_IN_ONE/*/share")
+  file(WRITE "${staged}/stale.txt" "stale\n")
+  run_cmake_command(IncrementalStagingShared-again ${CMAKE_CPACK_COMMAND} -V)
+endfunction()
+run_IncrementalStagingShared()
+
+function(run_IncrementalStagingCode)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/IncrementalStagingCode-build)
+  run_cmake(IncrementalStagingCode)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(IncrementalStagingCode-package ${CMAKE_CPACK_COMMAND})
+  run_cmake_command(IncrementalStagingCode-package ${CMAKE_CPACK_COMMAND})
+endfunction()
+run_IncrementalStagingCode()
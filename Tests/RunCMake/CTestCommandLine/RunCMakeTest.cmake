@@ -318,3 +318,87 @@ function(run_ShowOnly)
   run_cmake_command(show-only_json-v1 ${CMAKE_CTEST_COMMAND} --show-only=json-v1)
 endfunction()
 run_ShowOnly()
+
+function(run_ScheduleReport)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ScheduleReport)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  # The chain is deeper but Long is on the critical path.
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+  add_test(ChainA \"${CMAKE_COMMAND}\" -E echo ChainA)
+  add_test(ChainB \"${CMAKE_COMMAND}\" -E echo ChainB)
+  add_test(Long \"${CMAKE_COMMAND}\" -E echo Long)
+  set_tests_properties(ChainA PROPERTIES COST 1)
+  set_tests_properties(ChainB PROPERTIES COST 1 DEPENDS ChainA)
+  set_tests_properties(Long PROPERTIES COST 10)
+")
+  run_cmake_command(ScheduleReport ${CMAKE_CTEST_COMMAND} -j2 --schedule-report)
+endfunction()
+run_ScheduleReport()
+
+run_cmake_command(shard-index-only
+  ${CMAKE_CTEST_COMMAND} --shard-index 0
+  )
+run_cmake_command(shard-index-bad
+  ${CMAKE_CTEST_COMMAND} --shard-index 2 --shard-count 2
+  )
+
+function(run_Shard)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/Shard)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  # Balanced by cost, shard 0 gets A and D and shard 1 gets B and C.
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+  add_test(A \"${CMAKE_COMMAND}\" -E echo A)
+  add_test(B \"${CMAKE_COMMAND}\" -E echo B)
+  add_test(C \"${CMAKE_COMMAND}\" -E echo C)
+  add_test(D \"${CMAKE_COMMAND}\" -E echo D)
+  set_tests_properties(A PROPERTIES COST 4)
+  set_tests_properties(B PROPERTIES COST 3)
+  set_tests_properties(C PROPERTIES COST 2)
+  set_tests_properties(D PROPERTIES COST 1)
+")
+  run_cmake_command(Shard
+    ${CMAKE_CTEST_COMMAND} --shard-index 1 --shard-count 2
+    )
+endfunction()
+run_Shard()
+
+function(run_ShardWorkers)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ShardWorkers)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+  add_test(A \"${CMAKE_COMMAND}\" -E echo A)
+  add_test(B \"${CMAKE_COMMAND}\" -E echo B)
+  add_test(C \"${CMAKE_COMMAND}\" -E echo C)
+  add_test(Failing \"${CMAKE_COMMAND}\" -E no_such_command)
+")
+  run_cmake_command(ShardWorkers
+    ${CMAKE_CTEST_COMMAND} -M Experimental -T Test --shard-workers 2
+    )
+endfunction()
+run_ShardWorkers()
+
+function(run_ShardDepends)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ShardDepends)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  # B needs the file written by A, so both must go to the same worker.
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+  add_test(A \"${CMAKE_COMMAND}\" -E touch A.txt)
+  add_test(B \"${CMAKE_COMMAND}\" -E md5sum A.txt)
+  add_test(C \"${CMAKE_COMMAND}\" -E echo C)
+  set_tests_properties(A PROPERTIES COST 5)
+  set_tests_properties(B PROPERTIES COST 4 DEPENDS A)
+  set_tests_properties(C PROPERTIES COST 3)
+")
+  run_cmake_command(ShardDepends
+    ${CMAKE_CTEST_COMMAND} --shard-workers 2
+    )
+endfunction()
+run_ShardDepends()
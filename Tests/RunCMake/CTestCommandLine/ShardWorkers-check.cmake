@@ -0,0 +1,17 @@
+file(GLOB test_xml_file "${RunCMake_TEST_BINARY_DIR}/Testing/*/Test.xml")
+if(test_xml_file)
+  file(READ "${test_xml_file}" test_xml)
+  foreach(name A B C Failing)
+    string(REGEX MATCHALL "<Name>${name}</Name>" matches "${test_xml}")
+    list(LENGTH matches count)
+    if(NOT count EQUAL 1)
+      set(RunCMake_TEST_FAILED "Test.xml does not list test ${name} once:\n ${test_xml}")
+      return()
+    endif()
+  endforeach()
+  if(NOT "${test_xml}" MATCHES [[<Test Status="failed">.*<Name>Failing</Name>]])
+    set(RunCMake_TEST_FAILED "Test.xml does not report Failing as failed:\n ${test_xml}")
+  endif()
+else()
+  set(RunCMake_TEST_FAILED "Test.xml not found")
+endif()
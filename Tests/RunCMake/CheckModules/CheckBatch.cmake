@@ -0,0 +1,51 @@
+enable_language(C)
+enable_language(CXX)
+include(CheckCSourceCompiles)
+include(CheckCXXSourceCompiles)
+include(CheckIncludeFile)
+include(CheckSymbolExists)
+
+cmake_check_batch(BEGIN PARALLEL_LEVEL 2)
+check_c_source_compiles("int main(void) { return 0; }" C_WORKS)
+check_c_source_compiles("int main(void) { return undeclared; }" C_FAILS)
+check_cxx_source_compiles("int main() { return 0; }" CXX_WORKS)
+set(CMAKE_REQUIRED_DEFINITIONS -DCHECK_BATCH_DEFINED)
+check_c_source_compiles("
+#ifndef CHECK_BATCH_DEFINED
+#  error CHECK_BATCH_DEFINED is not defined
+#endif
+int main(void) { return 0; }" C_DEFINITIONS)
+unset(CMAKE_REQUIRED_DEFINITIONS)
+# Each check sees the output of its own build only.
+check_c_source_compiles("int main(void) { return 0; }" C_FAIL_REGEX
+  FAIL_REGEX "src[.]cxx")
+check_cxx_source_compiles("int main() { return 0; }" CXX_FAIL_REGEX
+  FAIL_REGEX "src[.]cxx")
+# The patterns are not evaluated again by the end of the batch.
+check_cxx_source_compiles("int main() { return 0; }" CXX_FAIL_REGEX_ESCAPED
+  FAIL_REGEX "src[.]cxx\\\\+*")
+check_include_file(stdio.h HAVE_STDIO_H)
+check_include_file(does_not_exist.h HAVE_DOES_NOT_EXIST_H)
+check_symbol_exists(printf stdio.h HAVE_PRINTF)
+if(DEFINED C_WORKS)
+  message(SEND_ERROR "C_WORKS is defined before the batch ends")
+endif()
+cmake_check_batch(END)
+
+foreach(var C_WORKS CXX_WORKS C_DEFINITIONS C_FAIL_REGEX HAVE_STDIO_H
+    HAVE_PRINTF)
+  if(NOT ${var})
+    message(SEND_ERROR "${var} is false")
+  endif()
+endforeach()
+foreach(var C_FAILS CXX_FAIL_REGEX CXX_FAIL_REGEX_ESCAPED
+    HAVE_DOES_NOT_EXIST_H)
+  if(NOT DEFINED ${var} OR ${var})
+    message(SEND_ERROR "${var} is not false")
+  endif()
+endforeach()
+
+file(GLOB leftovers "${CMAKE_BINARY_DIR}/CMakeFiles/CMakeTmpBatch/*")
+if(leftovers)
+  message(SEND_ERROR "The batch left files behind:\n  ${leftovers}")
+endif()
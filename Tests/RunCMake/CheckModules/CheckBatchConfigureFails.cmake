@@ -0,0 +1,12 @@
+enable_language(C)
+include(CheckCSourceCompiles)
+
+cmake_check_batch(BEGIN)
+check_c_source_compiles("int main(void) { return 0; }" C_WORKS)
+check_c_source_compiles("int main(void) { return undeclared; }" C_FAILS)
+# This check breaks the test project it shares with the others.  They
+# are then built one by one and finish before it fails.
+set(CMAKE_REQUIRED_LIBRARIES no::such_target)
+check_c_source_compiles("int main(void) { return 0; }" C_BREAKS)
+unset(CMAKE_REQUIRED_LIBRARIES)
+cmake_check_batch(END)
@@ -0,0 +1,2 @@
+cmake_check_batch(BEGIN)
+cmake_check_batch(BEGIN)
@@ -0,0 +1 @@
+cmake_check_batch(END)
@@ -22,3 +22,12 @@ run_cmake(CheckIncludeFilesOkNoC)
 run_cmake(CheckIncludeFilesMissingLanguage)
 run_cmake(CheckIncludeFilesUnknownArgument)
 run_cmake(CheckIncludeFilesUnknownLanguage)
+
+run_cmake(CheckBatchNested)
+run_cmake(CheckBatchNoBegin)
+run_cmake(CheckBatchNoEnd)
+if(RunCMake_GENERATOR MATCHES "Make|Ninja" AND
+    NOT RunCMake_GENERATOR MATCHES "Borland|Watcom")
+  run_cmake(CheckBatch)
+  run_cmake(CheckBatchConfigureFails)
+endif()
@@ -0,0 +1,37 @@
+if(NOT EXISTS "${ProfilingTestOutput}")
+  set(RunCMake_TEST_FAILED "Expected ${ProfilingTestOutput} to exist")
+  return()
+endif()
+
+file(READ "${ProfilingTestOutput}" ProfilingContents)
+if(NOT ProfilingContents MATCHES "^\\[.*\\]$")
+  set(RunCMake_TEST_FAILED "Profiling output is not a JSON array")
+  return()
+endif()
+
+foreach(expect
+    [["name":"profiling_test_function","ph":"B"]]
+    [["cat":"function","name":"profiling_test_function"]]
+    [["cat":"macro","name":"profiling_test_macro"]]
+    [["expandedArgs":"value1"]]
+    [["functionArgs":"value2"]]
+    [["cat":"listfile"]]
+    [["ph":"E"]]
+    [["name":"GeneratorExpressionCache","ph":"C"]]
+    )
+  string(FIND "${ProfilingContents}" "${expect}" pos)
+  if(pos EQUAL -1)
+    set(RunCMake_TEST_FAILED "Profiling output does not contain:\n  ${expect}")
+    return()
+  endif()
+endforeach()
+
+# A call to a function or macro is a single entry of that category.
+foreach(name profiling_test_function profiling_test_macro)
+  string(REGEX MATCHALL "\"name\":\"${name}\"" entries "${ProfilingContents}")
+  list(LENGTH entries n)
+  if(NOT n EQUAL 1)
+    set(RunCMake_TEST_FAILED "Profiling output has ${n} entries for ${name}, expected 1")
+    return()
+  endif()
+endforeach()
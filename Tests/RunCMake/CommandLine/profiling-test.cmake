@@ -0,0 +1,10 @@
+function(profiling_test_function arg)
+  set(var "${arg}")
+endfunction()
+
+macro(profiling_test_macro arg)
+  set(var "${arg}")
+endmacro()
+
+profiling_test_function(value1)
+profiling_test_macro(value2)
@@ -19,6 +19,8 @@ external_command_test(end-opt1           tar cvf bad.tar -- --bad)
 external_command_test(end-opt2           tar cvf bad.tar --)
 external_command_test(mtime              tar cvf bad.tar "--mtime=1970-01-01 00:00:00 UTC" ${CMAKE_CURRENT_LIST_DIR}/test-file.txt)
 external_command_test(bad-format         tar cvf bad.tar "--format=bad-format" ${CMAKE_CURRENT_LIST_DIR}/test-file.txt)
+external_command_test(bad-threads        tar cvJf bad.tar --threads=bad ${CMAKE_CURRENT_LIST_DIR}/test-file.txt)
+external_command_test(bad-compression-level tar cvJf bad.tar --compression-level=0 ${CMAKE_CURRENT_LIST_DIR}/test-file.txt)
 external_command_test(zip-bz2            tar cvjf bad.tar "--format=zip" ${CMAKE_CURRENT_LIST_DIR}/test-file.txt)
 external_command_test(7zip-gz            tar cvzf bad.tar "--format=7zip" ${CMAKE_CURRENT_LIST_DIR}/test-file.txt)
 
@@ -27,7 +29,9 @@ run_cmake(gnutar)
 run_cmake(gnutar-gz)
 run_cmake(pax)
 run_cmake(pax-xz)
+run_cmake(pax-xz-threads)
 run_cmake(pax-zstd)
+run_cmake(pax-zstd-threads)
 run_cmake(paxr)
 run_cmake(paxr-bz2)
 run_cmake(zip)
@@ -0,0 +1,41 @@
+set(db "${RunCMake_TEST_BINARY_DIR}/compile_commands.json")
+if(NOT EXISTS "${db}")
+  set(RunCMake_TEST_FAILED "Compilation database not generated:\n  ${db}")
+  return()
+endif()
+file(STRINGS "${db}" commands REGEX "\"command\":")
+
+# Each language and configuration must get its own definitions and
+# include directories, and a re-configuration must not reuse old ones.
+set(expect_c "-DDEP_C" "include_c")
+set(reject_c "-DDEP_CXX" "include_cxx")
+set(expect_cxx "-DDEP_CXX" "include_cxx")
+set(reject_cxx "-DDEP_C " "include_c ")
+foreach(lang c cxx)
+  set(command "")
+  foreach(c IN LISTS commands)
+    if(c MATCHES "empty\\.${lang}\"")
+      set(command "${c}")
+    endif()
+  endforeach()
+  if(NOT command)
+    string(APPEND RunCMake_TEST_FAILED "No command for empty.${lang}\n")
+    continue()
+  endif()
+  foreach(e IN LISTS expect_${lang} ITEMS
+      "-DDEP_VALUE=${CompileInfoCache_VALUE} " "-DLIB_${CompileInfoCache_CONFIG}")
+    string(FIND "${command}" "${e}" pos)
+    if(pos EQUAL -1)
+      string(APPEND RunCMake_TEST_FAILED
+        "empty.${lang} command does not contain '${e}':\n  ${command}\n")
+    endif()
+  endforeach()
+  foreach(r IN LISTS reject_${lang} ITEMS
+      "-DDEP_VALUE=${CompileInfoCache_OLD_VALUE} " "-DLIB_${CompileInfoCache_OLD_CONFIG}")
+    string(FIND "${command}" "${r}" pos)
+    if(NOT pos EQUAL -1)
+      string(APPEND RunCMake_TEST_FAILED
+        "empty.${lang} command contains '${r}':\n  ${command}\n")
+    endif()
+  endforeach()
+endforeach()
@@ -0,0 +1,21 @@
+enable_language(C)
+enable_language(CXX)
+set(CMAKE_EXPORT_COMPILE_COMMANDS ON)
+
+add_library(dep INTERFACE)
+target_compile_definitions(dep INTERFACE
+  DEP_VALUE=${DEP_VALUE}
+  $<$<COMPILE_LANGUAGE:C>:DEP_C>
+  $<$<COMPILE_LANGUAGE:CXX>:DEP_CXX>
+  )
+target_include_directories(dep INTERFACE
+  $<$<COMPILE_LANGUAGE:C>:${CMAKE_CURRENT_BINARY_DIR}/include_c>
+  $<$<COMPILE_LANGUAGE:CXX>:${CMAKE_CURRENT_BINARY_DIR}/include_cxx>
+  )
+
+add_library(lib STATIC empty.c empty.cxx)
+target_link_libraries(lib PRIVATE dep)
+target_compile_definitions(lib PRIVATE
+  $<$<CONFIG:Debug>:LIB_DEBUG>
+  $<$<CONFIG:Release>:LIB_RELEASE>
+  )
@@ -1,3 +1,25 @@
 include(RunCMake)
 
 run_cmake(SetEmpty)
+
+if(RunCMake_GENERATOR MATCHES "Make|Ninja")
+  # Re-configure a single build tree with other definitions and another
+  # configuration.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/CompileInfoCache-build)
+  set(RunCMake_TEST_OPTIONS -DDEP_VALUE=1 -DCMAKE_BUILD_TYPE=Debug)
+  set(CompileInfoCache_VALUE 1)
+  set(CompileInfoCache_CONFIG DEBUG)
+  set(CompileInfoCache_OLD_VALUE 2)
+  set(CompileInfoCache_OLD_CONFIG RELEASE)
+  run_cmake(CompileInfoCache)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  set(RunCMake_TEST_OPTIONS -DDEP_VALUE=2 -DCMAKE_BUILD_TYPE=Release)
+  set(CompileInfoCache_VALUE 2)
+  set(CompileInfoCache_CONFIG RELEASE)
+  set(CompileInfoCache_OLD_VALUE 1)
+  set(CompileInfoCache_OLD_CONFIG DEBUG)
+  run_cmake(CompileInfoCache)
+  unset(RunCMake_TEST_NO_CLEAN)
+  unset(RunCMake_TEST_OPTIONS)
+  unset(RunCMake_TEST_BINARY_DIR)
+endif()
@@ -0,0 +1,11 @@
+# Read the fingerprint cache counters from the profiling output.
+set(cache "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/FileFingerprintCache.bin")
+file(READ "${profile}" profiling_output)
+if(NOT EXISTS "${cache}")
+  set(RunCMake_TEST_FAILED "Expected fingerprint cache to exist:\n  ${cache}")
+elseif(profiling_output MATCHES [["args":{"hits":([0-9]+),"misses":([0-9]+)},"name":"FileFingerprintCache"]])
+  set(hits "${CMAKE_MATCH_1}")
+  set(misses "${CMAKE_MATCH_2}")
+else()
+  set(RunCMake_TEST_FAILED "No FileFingerprintCache counters in:\n  ${profile}")
+endif()
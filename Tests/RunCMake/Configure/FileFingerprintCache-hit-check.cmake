@@ -0,0 +1,6 @@
+include(${CMAKE_CURRENT_LIST_DIR}/FileFingerprintCache-counters.cmake)
+# Files generated by this run are new and always missed.
+if(NOT RunCMake_TEST_FAILED AND hits EQUAL 0)
+  set(RunCMake_TEST_FAILED "Expected fingerprint cache hits, got none")
+endif()
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/hit-misses.txt" "${misses}")
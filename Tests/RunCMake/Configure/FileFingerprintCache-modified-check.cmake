@@ -0,0 +1,5 @@
+include(${CMAKE_CURRENT_LIST_DIR}/FileFingerprintCache-counters.cmake)
+file(READ "${RunCMake_TEST_BINARY_DIR}/hit-misses.txt" hit_misses)
+if(NOT RunCMake_TEST_FAILED AND NOT misses GREATER hit_misses)
+  set(RunCMake_TEST_FAILED "Expected more than ${hit_misses} fingerprint cache misses, got ${misses}")
+endif()
@@ -0,0 +1,4 @@
+include(${CMAKE_CURRENT_LIST_DIR}/FileFingerprintCache-counters.cmake)
+if(NOT RunCMake_TEST_FAILED AND NOT hits EQUAL 0)
+  set(RunCMake_TEST_FAILED "Expected no fingerprint cache hits, got ${hits}")
+endif()
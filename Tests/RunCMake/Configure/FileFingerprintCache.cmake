@@ -0,0 +1,4 @@
+configure_file(${CMAKE_BINARY_DIR}/Input.txt ${CMAKE_BINARY_DIR}/Output.txt
+  COPYONLY)
+file(READ ${CMAKE_BINARY_DIR}/Output.txt output)
+message(STATUS "Output: ${output}")
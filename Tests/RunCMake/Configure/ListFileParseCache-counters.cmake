@@ -0,0 +1,11 @@
+# Read the parse cache counters from the profiling output.
+set(cache "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/ListFileParseCache.bin")
+file(READ "${profile}" profiling_output)
+if(NOT EXISTS "${cache}")
+  set(RunCMake_TEST_FAILED "Expected parse cache to exist:\n  ${cache}")
+elseif(profiling_output MATCHES [["args":{"hits":([0-9]+),"misses":([0-9]+)},"name":"ListFileParseCache"]])
+  set(hits "${CMAKE_MATCH_1}")
+  set(misses "${CMAKE_MATCH_2}")
+else()
+  set(RunCMake_TEST_FAILED "No ListFileParseCache counters in:\n  ${profile}")
+endif()
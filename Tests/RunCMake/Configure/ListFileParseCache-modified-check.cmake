@@ -0,0 +1,4 @@
+include(${CMAKE_CURRENT_LIST_DIR}/ListFileParseCache-counters.cmake)
+if(NOT RunCMake_TEST_FAILED AND (hits EQUAL 0 OR NOT misses EQUAL 1))
+  set(RunCMake_TEST_FAILED "Expected the modified list file to be the only parse cache miss, got ${hits} hits and ${misses} misses")
+endif()
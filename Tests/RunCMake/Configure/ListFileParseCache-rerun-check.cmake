@@ -0,0 +1,4 @@
+include(${CMAKE_CURRENT_LIST_DIR}/ListFileParseCache-counters.cmake)
+if(NOT RunCMake_TEST_FAILED AND (hits EQUAL 0 OR misses EQUAL 0))
+  set(RunCMake_TEST_FAILED "Expected parse cache hits and misses, got ${hits} hits and ${misses} misses")
+endif()
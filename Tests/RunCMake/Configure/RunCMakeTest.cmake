@@ -50,3 +50,50 @@ file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
 run_cmake(RemoveCache)
 file(REMOVE "${RunCMake_TEST_BINARY_DIR}/CMakeCache.txt")
 run_cmake(RemoveCache)
+
+# Use a single build tree to re-configure with the parsed list file cache.
+set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ListFileParseCache-build)
+set(RunCMake_TEST_NO_CLEAN 1)
+set(profile "${RunCMake_TEST_BINARY_DIR}/profile.json")
+set(profiling --profiling-format=google-trace --profiling-output=${profile})
+set(RunCMake_TEST_OPTIONS -DCMAKE_LISTFILE_PARSE_CACHE=ON ${profiling})
+file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+set(included "${RunCMake_TEST_BINARY_DIR}/Included.cmake")
+file(WRITE "${included}" "message(STATUS \"Included value: 1\")\n")
+run_cmake(ListFileParseCache)
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1) # handle 1s resolution
+# List files written within a second of the cache are parsed again.
+run_cmake_command(ListFileParseCache-rerun ${CMAKE_COMMAND} ${profiling} .)
+run_cmake_command(ListFileParseCache-hit ${CMAKE_COMMAND} ${profiling} .)
+file(WRITE "${included}" "message(STATUS \"Included value: 22\")\n")
+run_cmake_command(ListFileParseCache-modified ${CMAKE_COMMAND} ${profiling} .)
+unset(profiling)
+unset(profile)
+unset(RunCMake_TEST_OPTIONS)
+unset(RunCMake_TEST_BINARY_DIR)
+unset(RunCMake_TEST_NO_CLEAN)
+
+# Use a single build tree to re-configure with the file fingerprint cache.
+set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/FileFingerprintCache-build)
+set(RunCMake_TEST_NO_CLEAN 1)
+set(profile "${RunCMake_TEST_BINARY_DIR}/profile.json")
+set(profiling --profiling-format=google-trace --profiling-output=${profile})
+set(RunCMake_TEST_OPTIONS -DCMAKE_FILE_FINGERPRINT_CACHE=ON)
+file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+set(input "${RunCMake_TEST_BINARY_DIR}/Input.txt")
+file(WRITE "${input}" "value 1")
+run_cmake(FileFingerprintCache)
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1) # handle 1s resolution
+# Files written within a second of being compared are hashed again.
+run_cmake_command(FileFingerprintCache-rerun ${CMAKE_COMMAND} ${profiling} .)
+run_cmake_command(FileFingerprintCache-hit ${CMAKE_COMMAND} ${profiling} .)
+# Same size, different content.
+file(WRITE "${input}" "value 2")
+run_cmake_command(FileFingerprintCache-modified ${CMAKE_COMMAND} ${profiling} .)
+unset(profiling)
+unset(profile)
+unset(RunCMake_TEST_OPTIONS)
+unset(RunCMake_TEST_BINARY_DIR)
+unset(RunCMake_TEST_NO_CLEAN)
@@ -0,0 +1,4 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/exe.dir/flags.make" flags)
+if(NOT flags MATCHES "LIB1_MODIFIED")
+  set(RunCMake_TEST_FAILED "Rule files of exe not updated:\n${flags}")
+endif()
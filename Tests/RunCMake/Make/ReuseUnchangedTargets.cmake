@@ -0,0 +1,9 @@
+enable_language(C)
+
+add_library(lib1 STATIC hello.c)
+add_library(lib2 STATIC hello.c)
+add_executable(exe hello.c)
+target_link_libraries(exe lib1)
+
+# Modified between runs to change only the rule files of lib1 and exe.
+include(${CMAKE_BINARY_DIR}/Defines.cmake)
@@ -35,3 +35,20 @@ run_VerboseBuild()
 
 run_cmake(CustomCommandDepfile-ERROR)
 run_cmake(IncludeRegexSubdir)
+
+function(run_ReuseUnchangedTargets)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ReuseUnchangedTargets-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  set(RunCMake_TEST_OPTIONS -DCMAKE_REUSE_UNCHANGED_TARGETS=ON)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  set(defines "${RunCMake_TEST_BINARY_DIR}/Defines.cmake")
+  file(WRITE "${defines}" "target_compile_definitions(lib1 INTERFACE LIB1_ORIGINAL)\n")
+  run_cmake(ReuseUnchangedTargets)
+  run_cmake_command(ReuseUnchangedTargets-first ${CMAKE_COMMAND} .)
+  run_cmake_command(ReuseUnchangedTargets-rerun ${CMAKE_COMMAND} .)
+  file(WRITE "${defines}" "target_compile_definitions(lib1 INTERFACE LIB1_MODIFIED)\n")
+  run_cmake_command(ReuseUnchangedTargets-modified ${CMAKE_COMMAND} .)
+  run_cmake_command(ReuseUnchangedTargets-build ${CMAKE_COMMAND} --build .)
+endfunction()
+run_ReuseUnchangedTargets()
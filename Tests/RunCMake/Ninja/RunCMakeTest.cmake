@@ -184,6 +184,22 @@ function(touch path)
   endif()
 endfunction(touch)
 
+function(run_SplitBuildFiles)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/SplitBuildFiles-build)
+  run_cmake(SplitBuildFiles)
+  run_ninja("${RunCMake_TEST_BINARY_DIR}" "hello" "InAll")
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(SplitBuildFiles-rerun ${CMAKE_COMMAND} .)
+  file(TIMESTAMP "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/directory.ninja" before)
+  sleep(1)
+  run_cmake_command(SplitBuildFiles-rerun ${CMAKE_COMMAND} .)
+  file(TIMESTAMP "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/directory.ninja" after)
+  if(NOT before STREQUAL after)
+    message(SEND_ERROR "Unchanged CMakeFiles/directory.ninja was rewritten.")
+  endif()
+endfunction()
+run_SplitBuildFiles()
+
 macro(ninja_escape_path path out)
   string(REPLACE "\$ " "\$\$" "${out}" "${path}")
   string(REPLACE " " "\$ " "${out}" "${${out}}")
@@ -0,0 +1,11 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/build.ninja" build_file)
+foreach(dir "" "SubDir/")
+  if(NOT build_file MATCHES "\nsubninja ${dir}CMakeFiles/directory.ninja\n")
+    set(RunCMake_TEST_FAILED "build.ninja does not include ${dir}CMakeFiles/directory.ninja")
+    return()
+  endif()
+endforeach()
+file(READ "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/directory.ninja" directory_file)
+if(NOT directory_file MATCHES "\nbuild hello")
+  set(RunCMake_TEST_FAILED "CMakeFiles/directory.ninja does not build hello")
+endif()
@@ -0,0 +1,4 @@
+enable_language(C)
+set(CMAKE_NINJA_SPLIT_BUILD_FILES ON)
+add_executable(hello hello.c)
+add_subdirectory(SubDir)
@@ -0,0 +1,7 @@
+# Verifying the globs records the snapshot again.
+file(TIMESTAMP "${snapshot_file}" snapshot_time_after "%Y-%m-%dT%H:%M:%S")
+if(NOT snapshot_time_after STREQUAL snapshot_time)
+  set(RunCMake_TEST_FAILED "The globs were verified although no globbed directory changed.")
+elseif(actual_stdout MATCHES "Running CMake")
+  set(RunCMake_TEST_FAILED "CMake was re-run although no glob result changed.")
+endif()
@@ -0,0 +1,13 @@
+set(src ${CMAKE_CURRENT_SOURCE_DIR}/from)
+set(dst ${CMAKE_CURRENT_BINARY_DIR}/from)
+file(REMOVE RECURSE ${dst})
+set(CMAKE_INSTALL_PARALLEL_LEVEL 4)
+file(INSTALL FILES a.txt a/b.txt a/b/c.txt FILES_FROM_DIR ${src} DESTINATION ${dst})
+file(INSTALL ${src}/a/b DESTINATION ${dst}/dir)
+file(INSTALL ${src}/a.txt ${src}/a/b.txt DESTINATION ${dst}/dir/b)
+foreach(f a.txt a/b.txt a/b/c.txt dir/b/c.txt dir/b/a.txt dir/b/b.txt)
+  if(NOT EXISTS ${dst}/${f})
+    message(SEND_ERROR "${dst}/${f} was not installed")
+  endif()
+endforeach()
+message(STATUS "Manifest: ${CMAKE_INSTALL_MANIFEST_FILES}")
@@ -19,6 +19,10 @@ run_cmake(UPLOAD-pass-not-set)
 run_cmake(INSTALL-DIRECTORY)
 run_cmake(INSTALL-FILES_FROM_DIR)
 run_cmake(INSTALL-FILES_FROM_DIR-bad)
+run_cmake(INSTALL-PARALLEL)
+set(RunCMake_TEST_OPTIONS --log-level=debug)
+run_cmake(INSTALL-PARALLEL-pool)
+unset(RunCMake_TEST_OPTIONS)
 run_cmake(INSTALL-MESSAGE-bad)
 run_cmake(FileOpenFailRead)
 run_cmake(LOCK)
@@ -129,6 +133,21 @@ else()
   run_cmake_command(GLOB-CONFIGURE_DEPENDS-RerunCMake-rebuild_second ${CMAKE_COMMAND} --build .)
   run_cmake_command(GLOB-CONFIGURE_DEPENDS-RerunCMake-nowork ${CMAKE_COMMAND} --build .)
 
+  # Once no globbed directory changed for a while, the build records the
+  # directory times and stops running the verification script.
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep ${fs_delay})
+  run_cmake_command(GLOB-CONFIGURE_DEPENDS-RerunCMake-nowork ${CMAKE_COMMAND} --build .)
+  set(snapshot_file "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/VerifyGlobs.bin")
+  file(TIMESTAMP "${snapshot_file}" snapshot_time "%Y-%m-%dT%H:%M:%S")
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep ${fs_delay})
+  run_cmake_command(GLOB-CONFIGURE_DEPENDS-RerunCMake-snapshot ${CMAKE_COMMAND} --build .)
+
+  message(STATUS "GLOB-CONFIGURE_DEPENDS-RerunCMake: add a third test file...")
+  set(tf_3  "${RunCMake_TEST_BINARY_DIR}/test/sub/3.txt")
+  file(WRITE "${tf_3}" "3")
+  run_cmake_command(GLOB-CONFIGURE_DEPENDS-RerunCMake-rebuild_third ${CMAKE_COMMAND} --build .)
+  run_cmake_command(GLOB-CONFIGURE_DEPENDS-RerunCMake-nowork ${CMAKE_COMMAND} --build .)
+
   unset(RunCMake_TEST_BINARY_DIR)
   unset(RunCMake_TEST_NO_CLEAN)
   unset(RunCMake_DEFAULT_stderr)
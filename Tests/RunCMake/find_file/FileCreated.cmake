@@ -0,0 +1,21 @@
+set(dir "${CMAKE_CURRENT_BINARY_DIR}/created")
+file(REMOVE_RECURSE "${dir}")
+
+macro(check_created)
+  unset(Created_File CACHE)
+  find_file(Created_File NAMES Created.h PATHS "${dir}" NO_DEFAULT_PATH)
+  message(STATUS "Created_File='${Created_File}'")
+endmacro()
+
+check_created()
+file(WRITE "${dir}/Created.h" "")
+check_created()
+file(REMOVE "${dir}/Created.h")
+check_created()
+configure_file("${CMAKE_CURRENT_SOURCE_DIR}/include/PrefixInPATH.h"
+  "${dir}/Created.h" COPYONLY)
+check_created()
+file(RENAME "${dir}/Created.h" "${dir}/Renamed.h")
+check_created()
+execute_process(COMMAND ${CMAKE_COMMAND} -E touch "${dir}/Created.h")
+check_created()
@@ -3,3 +3,4 @@ include(RunCMake)
 run_cmake(FromPATHEnv)
 run_cmake(FromPrefixPath)
 run_cmake(PrefixInPATH)
+run_cmake(FileCreated)
@@ -0,0 +1,4 @@
+# The outcome of the first run is reused without evaluating the version file.
+if(actual_stdout MATCHES "Checking Resolved version")
+  set(RunCMake_TEST_FAILED "The version file was evaluated again.")
+endif()
@@ -0,0 +1,2 @@
+set(ResolvedVersion 1.1)
+include(${CMAKE_CURRENT_LIST_DIR}/ResolutionCache.cmake)
@@ -0,0 +1,9 @@
+if(NOT DEFINED ResolvedVersion)
+  set(ResolvedVersion 1.0)
+endif()
+find_package(Resolved ${ResolvedVersion} CONFIG
+  PATHS "${CMAKE_CURRENT_SOURCE_DIR}/ResolutionCache/cmake" NO_DEFAULT_PATH)
+message(STATUS "Resolved_VERSION='${Resolved_VERSION}'")
+find_package(Unresolved CONFIG QUIET
+  PATHS "${CMAKE_CURRENT_SOURCE_DIR}/ResolutionCache/cmake" NO_DEFAULT_PATH)
+message(STATUS "Unresolved_FOUND='${Unresolved_FOUND}'")
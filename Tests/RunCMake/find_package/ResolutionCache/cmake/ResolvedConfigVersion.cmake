@@ -0,0 +1,5 @@
+message(STATUS "Checking Resolved version ${PACKAGE_FIND_VERSION}")
+set(PACKAGE_VERSION 1.2)
+if(NOT PACKAGE_FIND_VERSION VERSION_GREATER PACKAGE_VERSION)
+  set(PACKAGE_VERSION_COMPATIBLE 1)
+endif()
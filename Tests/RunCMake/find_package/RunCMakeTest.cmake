@@ -31,3 +31,12 @@ run_cmake(CMP0084-NEW)
 if(UNIX)
   run_cmake(SetFoundResolved)
 endif()
+
+# Configure fresh build trees sharing one resolution cache.
+set(RunCMake_TEST_OPTIONS
+  -DCMAKE_FIND_PACKAGE_RESOLUTION_CACHE=${RunCMake_BINARY_DIR}/ResolutionCache.bin)
+file(REMOVE ${RunCMake_BINARY_DIR}/ResolutionCache.bin)
+run_cmake(ResolutionCache)
+run_cmake(ResolutionCache-rerun)
+run_cmake(ResolutionCache-version)
+unset(RunCMake_TEST_OPTIONS)
@@ -0,0 +1,2 @@
+set(ResultCacheDefinitions 1)
+include(${CMAKE_CURRENT_LIST_DIR}/ResultCache.cmake)
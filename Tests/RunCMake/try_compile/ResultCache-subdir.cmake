@@ -0,0 +1,14 @@
+enable_language(C)
+
+# A header named with a path is looked up in a subdirectory of the
+# include directory, whose stamp does not change when the header appears.
+set(tmp ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp)
+file(WRITE ${tmp}/subdir.c "#include <sub/hdr.h>\nint main(void) { return 0; }\n")
+try_compile(SUBDIR ${CMAKE_BINARY_DIR} ${tmp}/subdir.c
+  CMAKE_FLAGS -DINCLUDE_DIRECTORIES=${ResultCacheInclude}
+  OUTPUT_VARIABLE out)
+set(cached 0)
+if(out MATCHES "Result taken from the try_compile result cache")
+  set(cached 1)
+endif()
+message(STATUS "SUBDIR='${SUBDIR}' cached=${cached}")
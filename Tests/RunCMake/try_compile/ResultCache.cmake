@@ -0,0 +1,35 @@
+enable_language(C)
+
+function(report var output)
+  set(cached 0)
+  if(output MATCHES "Result taken from the try_compile result cache")
+    set(cached 1)
+  endif()
+  message(STATUS "${var}='${${var}}' cached=${cached}")
+endfunction()
+
+if(ResultCacheDefinitions)
+  set(defs COMPILE_DEFINITIONS -DRESULT_CACHE)
+endif()
+
+set(tmp ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp)
+file(WRITE ${tmp}/works.c "int main(void) { return 0; }\n")
+try_compile(WORKS ${CMAKE_BINARY_DIR} ${tmp}/works.c ${defs}
+  OUTPUT_VARIABLE out)
+report(WORKS "${out}")
+
+file(WRITE ${tmp}/fails.c "#error fails\n")
+try_compile(FAILS ${CMAKE_BINARY_DIR} ${tmp}/fails.c ${defs}
+  OUTPUT_VARIABLE out)
+report(FAILS "${out}")
+
+file(WRITE ${tmp}/runs.c "int main(void) { return 42; }\n")
+try_run(RUNS RUNS_COMPILED ${CMAKE_BINARY_DIR} ${tmp}/runs.c ${defs}
+  COMPILE_OUTPUT_VARIABLE out)
+report(RUNS_COMPILED "${out}")
+message(STATUS "RUNS='${RUNS}'")
+
+# Sources outside of the temporary directory may include other files.
+try_compile(SOURCE ${CMAKE_BINARY_DIR} ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  OUTPUT_VARIABLE out)
+report(SOURCE "${out}")
@@ -13,6 +13,7 @@ run_cmake(NoSources)
 run_cmake(BadLinkLibraries)
 run_cmake(BadSources1)
 run_cmake(BadSources2)
+run_cmake(FinishNotInternal)
 run_cmake(NonSourceCopyFile)
 run_cmake(NonSourceCompileDefinitions)
 
@@ -92,3 +93,23 @@ if(RunCMake_GENERATOR MATCHES "Make|Ninja")
   unset(RunCMake_TEST_BINARY_DIR)
   unset(RunCMake_TEST_NO_CLEAN)
 endif()
+
+# Configure fresh build trees sharing one result cache.
+set(RunCMake_TEST_OPTIONS
+  -DCMAKE_TRY_COMPILE_RESULT_CACHE=${RunCMake_BINARY_DIR}/ResultCache.bin)
+file(REMOVE ${RunCMake_BINARY_DIR}/ResultCache.bin)
+run_cmake(ResultCache)
+run_cmake(ResultCache-rerun)
+run_cmake(ResultCache-definitions)
+
+set(ResultCacheInclude ${RunCMake_BINARY_DIR}/ResultCacheInclude)
+file(REMOVE_RECURSE ${ResultCacheInclude})
+file(MAKE_DIRECTORY ${ResultCacheInclude}/sub)
+# Only results depending on paths modified more than a second ago are stored.
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.1)
+list(APPEND RunCMake_TEST_OPTIONS -DResultCacheInclude=${ResultCacheInclude})
+run_cmake(ResultCache-subdir)
+run_cmake(ResultCache-subdir-rerun)
+file(WRITE ${ResultCacheInclude}/sub/hdr.h "")
+run_cmake(ResultCache-subdir-header)
+unset(RunCMake_TEST_OPTIONS)
@@ -0,0 +1,18 @@
+#!/usr/bin/env bash
+
+set -e
+
+ctest="${1:-ctest}"
+dir="$(mktemp -d)"
+trap 'rm -rf "${dir}"' EXIT
+
+TIMEFORMAT='%R'
+printf '%8s %10s %10s\n' tests seconds 'tests/s'
+for count in 10000 50000; do
+    awk "BEGIN { for (i = 0; i < ${count}; ++i) printf \"add_test(t%d true)\\n\", i }" \
+        > "${dir}/CTestTestfile.cmake"
+    seconds=$( { time (cd "${dir}" && "${ctest}" -j4 -Q); } 2>&1 )
+    rate=$(awk "BEGIN { printf \"%.0f\", ${count} / ${seconds} }")
+    printf '%8s %10s %10s\n' ${count} ${seconds} ${rate}
+    rm -rf "${dir}/"*
+done
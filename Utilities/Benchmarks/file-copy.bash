@@ -0,0 +1,24 @@
+#!/usr/bin/env bash
+
+set -e
+
+cmake="${1:-cmake}"
+dir="$(mktemp -d)"
+trap 'rm -rf "${dir}"' EXIT
+
+TIMEFORMAT='%R'
+printf '%8s %8s %10s %10s\n' size files seconds 'MiB/s'
+for spec in 4:200 1024:100 65536:5 262144:2; do
+    kib=${spec%:*}
+    count=${spec#*:}
+    mkdir "${dir}/src" "${dir}/dst"
+    for ((i = 0; i < count; ++i)); do
+        head -c $((kib * 1024)) /dev/urandom > "${dir}/src/${i}"
+    done
+    seconds=$( { time for ((i = 0; i < count; ++i)); do
+        "${cmake}" -E copy "${dir}/src/${i}" "${dir}/dst/${i}"
+    done; } 2>&1 )
+    rate=$(awk "BEGIN { printf \"%.0f\", ${kib} * ${count} / 1024 / ${seconds} }")
+    printf '%7sK %8s %10s %10s\n' ${kib} ${count} ${seconds} ${rate}
+    rm -rf "${dir}/src" "${dir}/dst"
+done
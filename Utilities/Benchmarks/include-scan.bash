@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+
+set -e
+
+cmake="${1:-cmake}"
+script="${BASH_SOURCE%/*}/include-scan.cmake"
+dir="$(mktemp -d)"
+trap 'rm -rf "${dir}"' EXIT
+
+"${cmake}" -DDIR="${dir}" -P "${script}"
+"${cmake}" -S "${dir}/src" -B "${dir}/build" -G "Unix Makefiles" > /dev/null
+
+TIMEFORMAT='%R'
+cd "${dir}/build"
+printf '%8s %10s\n' run seconds
+for run in 1 2 3; do
+    # Scan every file again, without results of previous runs.
+    rm -f CMakeFiles/CMakeDependsC.bin CMakeFiles/scan.dir/depend.internal \
+          CMakeFiles/scan.dir/C.includecache
+    seconds=$( { time make -f CMakeFiles/scan.dir/build.make CMakeFiles/scan.dir/depend > /dev/null; } 2>&1 )
+    printf '%8s %10s\n' ${run} ${seconds}
+done
@@ -0,0 +1,29 @@
+# Write a project whose sources include many long headers.
+# Run with -DDIR=<dir>.
+set(headers 200)
+set(sources 10)
+
+string(REPEAT "int declaration_of_something(int a, int b); /* comment */\n" 500 body)
+string(REPEAT "  #  include <stdio.h> // not a project header\n" 20 system)
+math(EXPR last "${headers} - 1")
+set(all "")
+foreach(i RANGE ${last})
+  math(EXPR next "(${i} + 1) % ${headers}")
+  math(EXPR other "(${i} * 7) % ${headers}")
+  file(WRITE "${DIR}/src/h${i}.h" "#ifndef H${i}\n#define H${i}\n"
+    "#include \"h${next}.h\"\n${system}${body}#import \"h${other}.h\"\n${body}"
+    "#endif\n")
+  string(APPEND all "#include \"h${i}.h\"\n")
+endforeach()
+
+math(EXPR last "${sources} - 1")
+set(srcs "")
+foreach(i RANGE ${last})
+  file(WRITE "${DIR}/src/s${i}.c" "${all}int f${i}(void) { return ${i}; }\n")
+  string(APPEND srcs " s${i}.c")
+endforeach()
+
+file(WRITE "${DIR}/src/CMakeLists.txt" "cmake_minimum_required(VERSION 3.16)
+project(IncludeScan C)
+add_library(scan STATIC${srcs})
+")
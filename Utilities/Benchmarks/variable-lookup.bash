@@ -0,0 +1,13 @@
+#!/usr/bin/env bash
+
+set -e
+
+cmake="${1:-cmake}"
+script="${BASH_SOURCE%/*}/variable-lookup.cmake"
+
+TIMEFORMAT='%R'
+printf '%8s %10s\n' depth seconds
+for depth in 1 50 200; do
+    seconds=$( { time "${cmake}" -DDEPTH=${depth} -P "${script}" > /dev/null; } 2>&1 )
+    printf '%8s %10s\n' ${depth} ${seconds}
+done
@@ -0,0 +1,33 @@
+# Read two set and one unset variable ITERATIONS times at the bottom of
+# a chain of DEPTH nested function calls.  Each function call adds a
+# variable scope that a lookup may have to search.
+#
+#   cmake -DDEPTH=<n> [-DITERATIONS=<n>] -P variable-lookup.cmake
+
+if(NOT DEFINED DEPTH)
+  set(DEPTH 1)
+endif()
+if(NOT DEFINED ITERATIONS)
+  set(ITERATIONS 20000)
+endif()
+
+set(outer_a "a")
+set(outer_b "b")
+
+function(lookup)
+  foreach(i RANGE ${ITERATIONS})
+    set(value "${outer_a}${outer_b}${never_set}")
+  endforeach()
+endfunction()
+
+function(nest level)
+  set(local_${level} "${level}")
+  if(level LESS DEPTH)
+    math(EXPR next "${level} + 1")
+    nest(${next})
+  else()
+    lookup()
+  endif()
+endfunction()
+
+nest(1)
@@ -13,7 +13,12 @@ readonly shortlog=false
 readonly paths="
   COPYING
   src/common/common_w32res.rc
+  src/common/mythread.h
   src/common/sysdefs.h
+  src/common/tuklib_common.h
+  src/common/tuklib_config.h
+  src/common/tuklib_cpucores.c
+  src/common/tuklib_cpucores.h
   src/common/tuklib_integer.h
   src/liblzma/
 "
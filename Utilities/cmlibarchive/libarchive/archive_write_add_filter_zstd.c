@@ -38,6 +38,8 @@ __FBSDID("$FreeBSD$");
 #include <string.h>
 #endif
 #ifdef HAVE_ZSTD_H
+/* CMake: ZSTD_c_nbWorkers is experimental before zstd 1.4.0. */
+#define ZSTD_STATIC_LINKING_ONLY
 #include <cm_zstd.h>
 #endif
 
@@ -50,6 +52,7 @@ __FBSDID("$FreeBSD$");
 
 struct private_data {
 	int		 compression_level;
+	int		 threads; /* CMake: backported from libarchive 3.6 */
 #if HAVE_ZSTD_H && HAVE_LIBZSTD
 	ZSTD_CStream	*cstream;
 	int64_t		 total_in;
@@ -97,6 +100,7 @@ archive_write_add_filter_zstd(struct archive *_a)
 	f->code = ARCHIVE_FILTER_ZSTD;
 	f->name = "zstd";
 	data->compression_level = 3; /* Default level used by the zstd CLI */
+	data->threads = 0; /* CMake: backported from libarchive 3.6 */
 #if HAVE_ZSTD_H && HAVE_LIBZSTD
 	data->cstream = ZSTD_createCStream();
 	if (data->cstream == NULL) {
@@ -156,6 +160,14 @@ archive_compressor_zstd_options(struct archive_write_filter *f, const char *key,
 		}
 		data->compression_level = level;
 		return (ARCHIVE_OK);
+	/* CMake: backported from libarchive 3.6 */
+	} else if (strcmp(key, "threads") == 0) {
+		int threads = atoi(value);
+		if (threads < 0) {
+			return (ARCHIVE_WARN);
+		}
+		data->threads = threads;
+		return (ARCHIVE_OK);
 	}
 
 	/* Note: The "warn" return is just to inform the options
@@ -209,6 +221,13 @@ archive_compressor_zstd_open(struct archive_write_filter *f)
 		return (ARCHIVE_FATAL);
 	}
 
+	/* CMake: backported from libarchive 3.6.  This fails if libzstd
+	 * was built without multi-threading support, in which case the
+	 * data are compressed in this thread. */
+#if ZSTD_VERSION_NUMBER >= 10308
+	ZSTD_CCtx_setParameter(data->cstream, ZSTD_c_nbWorkers, data->threads);
+#endif
+
 	return (ARCHIVE_OK);
 }
 